@@ -4,6 +4,10 @@
 #include "Finance.h" // include finance log definitions
 #include "Credit.h" // include credit profile definitions
 #include "DataGen.h"  // include data gen definitions
+#include "Metrics.h" // include latency instrumentation
+#include "MemoryUsage.h" // include memory accounting
+#include "PinThrottle.h" // include shared pin attempt limits
+#include "Format.h" // include row formatter
 
 #include <iostream> // include input and output stream library
 #include <iomanip> // include formatting manipulators
@@ -42,26 +46,28 @@ namespace atmapp { // begin atmapp namespace
         out << "\n Card detected. " << probe.card() << "\n"; // show detected card
         out << " Hello " << probe.owner() << "\n"; // greet user
         out << " Enter your pin.\n"; // ask for pin
-        int tries = 0; // track failed attempts
-        while (tries < 3) { // allow up to three tries
+        PinThrottle& throttle = SharedPinThrottle(); // attempts shared with every other session, so reconnecting does not reset them
+        CardId card = probe.id(); // throttle key
+        while (throttle.beginAttempt(card, PinThrottle::Now())) { // an attempt is counted before the pin is read, none left means locked
             out << " Pin. "; // prompt for pin
             int pin{}; // variable for entered pin
             if (in >> pin) { // check valid input
                 if (probe.checkPin(pin)) { // verify pin
+                    throttle.succeeded(card, PinThrottle::Now()); // clear the failures
                     out << " Verified\n"; // success message
                     return true; // authentication success
                 }
                 else { // incorrect pin
-                    ++tries; // increment try count
-                    out << " Incorrect. Attempts left. " << (3 - tries) << "\n"; // warn user
+                    out << " Incorrect. Attempts left. " << throttle.attemptsLeft(card, PinThrottle::Now()) << "\n"; // warn user
                 }
             }
             else { // invalid input type
                 out << " Invalid input. Numbers only\n"; // prompt correction
                 clearLine(in); // clear input line
+                throttle.cancelAttempt(card, PinThrottle::Now()); // no pin was tried, give the attempt back
             }
         }
-        out << " Session locked. Contact support\n"; // after 3 failed attempts
+        out << " Session locked. Contact support\n"; // no attempts left, in this session or shared with others on the same card
         return false; // authentication failed
     } // end SignIn
 
@@ -69,55 +75,63 @@ namespace atmapp { // begin atmapp namespace
         out << std::fixed << std::setprecision(2); // format monetary values with two decimals
         bool running = true; // control session loop
         while (running) { // continue until user exits
+            if (MetricsDumpRequested()) { PrintMetrics(std::cerr, SnapshotMetrics()); PrintMemory(std::cerr, SnapshotMemory(MemoryUsage(), log, fin)); } // dump metrics and memory after a SIGUSR1
             ShowMenu(out); // display main menu
             int choice = ReadMenuChoice(in, out); // read user menu selection
-            switch (choice) { // perform based on menu choice
-            case 1: DoBalance(out, active, savings); break; // show balances
-            case 2: DoDeposit(in, out, active, log); break; // deposit money
-            case 3: DoWithdraw(in, out, active, log); break; // withdraw money
-            case 4: DoTransfer(in, out, active, savings, log); break; // transfer funds
-            case 5: // view credit score
-                if (credit && fin) { // ensure both logs exist
-                    double inc = fin->monthlyIncomeEstimate(); // calculate income
-                    double spend = fin->monthlySpendEstimate(); // calculate spending
-                    credit->compute(active.getBalance(), savings.getBalance(), inc, spend); // compute credit score
-                    credit->print(out); // display score
-                }
-                else { // missing dependencies
-                    out << "\nAssistant. Credit view not available.\n"; // error message
-                }
-                break;
-            case 6: // view purchase history
-                if (fin) fin->printPurchases(out, 25); // print purchases
-                else out << "\nAssistant. No purchase log available.\n"; // missing finance log
-                break;
-            case 7: // view paychecks
-                if (fin) fin->printPaychecks(out, 25); // print paychecks
-                else out << "\nAssistant. No paycheck log available.\n"; // missing finance log
-                break;
-            case 8:
-                if (fin) {
-                    DataGen regen;
-                    auto newHistory = regen.generateQuarterHistory(18, 2);
-                    fin->set(std::move(newHistory));
-                    out << "\nAssistant. Transaction history has been regenerated with new random purchases and paychecks.\n";
-                }
-                else {
-                    out << "\nAssistant. History system not available.\n";
-                }
-                break;
-            case 9: // exit session
-                running = false; // set loop exit flag
-                out << " Thank you. Goodbye\n"; // farewell message
-                if (log) log->print(out); // print transaction log if exists
-                break;
-            } // end switch
+            running = DoMenuOption(choice, in, out, active, savings, log, fin, credit); // perform the selected option
         } // end while
     } // end RunSession
 
+    bool DoMenuOption(int choice, std::istream& in, std::ostream& out, Account& active, Account& savings, TransactionLog* log, FinanceLog* fin, CreditProfile* credit) { // run one menu option
+        switch (choice) { // perform based on menu choice
+        case 1: DoBalance(out, active, savings); break; // show balances
+        case 2: DoDeposit(in, out, active, log); break; // deposit money
+        case 3: DoWithdraw(in, out, active, log); break; // withdraw money
+        case 4: DoTransfer(in, out, active, savings, log); break; // transfer funds
+        case 5: // view credit score
+            if (credit && fin) { // ensure both logs exist
+                ScopedLatency timer(MetricOp::Credit); // time estimates, scoring and printing
+                double inc = fin->monthlyIncomeEstimate(); // calculate income
+                double spend = fin->monthlySpendEstimate(); // calculate spending
+                credit->compute(active.getBalance(), savings.getBalance(), inc, spend); // compute credit score
+                credit->print(out); // display score
+            }
+            else { // missing dependencies
+                out << "\nAssistant. Credit view not available.\n"; // error message
+            }
+            break;
+        case 6: // view purchase history
+            if (fin) fin->printPurchases(out, 25); // print purchases
+            else out << "\nAssistant. No purchase log available.\n"; // missing finance log
+            break;
+        case 7: // view paychecks
+            if (fin) fin->printPaychecks(out, 25); // print paychecks
+            else out << "\nAssistant. No paycheck log available.\n"; // missing finance log
+            break;
+        case 8:
+            if (fin) {
+                ScopedLatency timer(MetricOp::Regenerate); // time generation and swap
+                DataGen regen;
+                fin->set(regen.generateQuarterBatch(18, 2)); // the replaced history's arena is freed whole once readers are done
+                out << "\nAssistant. Transaction history has been regenerated with new random purchases and paychecks.\n";
+            }
+            else {
+                out << "\nAssistant. History system not available.\n";
+            }
+            break;
+        case 9: // exit session
+            out << " Thank you. Goodbye\n"; // farewell message
+            if (log) log->print(out); // print transaction log if exists
+            return false; // end the session
+        } // end switch
+        return true; // keep the session going
+    } // end DoMenuOption
+
     void DoBalance(std::ostream& out, const Account& checking, const Account& savings) { // display balances for checking and savings
-        out << " Checking balance. $" << checking.getBalance() << "\n"; // print checking balance
-        out << " Savings balance.  $" << savings.getBalance() << "\n"; // print savings balance
+        ScopedLatency timer(MetricOp::Balance); // time the balance view
+        RowBuffer rows(out); // both lines go out in one write
+        rows.text(" Checking balance. $").money(checking.getBalance()).ch('\n'); // print checking balance
+        rows.text(" Savings balance.  $").money(savings.getBalance()).ch('\n'); // print savings balance
     } // end DoBalance
 
     double ReadMoney(std::istream& in, std::ostream& out, const char* prompt, double minVal, double maxVal) { // read monetary input within range
@@ -144,22 +158,26 @@ namespace atmapp { // begin atmapp namespace
 
     void DoDeposit(std::istream& in, std::ostream& out, Account& acct, TransactionLog* log) { // deposit function
         double amt = ReadMoney(in, out, " Deposit amount. ", 0.01, 1000000.0); // read deposit amount
+        ScopedLatency timer(MetricOp::Deposit); // time the deposit itself, not the prompt
         if (acct.deposit(amt)) { // try deposit
             out << " Deposited. $" << amt << "\n New balance. $" << acct.getBalance() << "\n"; // confirm new balance
-            if (log) log->logDeposit(acct.card(), amt, acct.getBalance(), nowStamp()); // log deposit
+            if (log) log->logDeposit(acct.id(), amt, acct.getBalance(), nowStamp()); // log deposit
         }
         else { // deposit failed
+            timer.markFailed(); // count the decline
             out << " Deposit failed\n"; // show error
         }
     } // end DoDeposit
 
     void DoWithdraw(std::istream& in, std::ostream& out, Account& acct, TransactionLog* log) { // withdraw function
         double amt = ReadMoney(in, out, " Withdraw amount. ", 0.01, 1000000.0); // read withdrawal amount
+        ScopedLatency timer(MetricOp::Withdraw); // time the withdraw itself, not the prompt
         if (acct.withdraw(amt)) { // attempt withdrawal
             out << " Dispensed. $" << amt << "\n New balance. $" << acct.getBalance() << "\n"; // show updated balance
-            if (log) log->logWithdraw(acct.card(), amt, acct.getBalance(), nowStamp()); // log withdrawal
+            if (log) log->logWithdraw(acct.id(), amt, acct.getBalance(), nowStamp()); // log withdrawal
         }
         else { // insufficient funds
+            timer.markFailed(); // count the decline
             out << " Withdraw blocked by insufficient funds\n"; // show message
         }
     } // end DoWithdraw
@@ -167,11 +185,13 @@ namespace atmapp { // begin atmapp namespace
     void DoTransfer(std::istream& in, std::ostream& out, Account& from, Account& to, TransactionLog* log) { // transfer function
         out << " Transfer checking to savings\n"; // explain operation
         double amt = ReadMoney(in, out, " Amount. ", 0.01, 1000000.0); // read amount
+        ScopedLatency timer(MetricOp::Transfer); // time the transfer itself, not the prompt
         if (from.transferTo(to, amt)) { // attempt transfer
             out << " Transferred. $" << amt << "\n Checking. $" << from.getBalance() << "   Savings. $" << to.getBalance() << "\n"; // show balances
-            if (log) log->logTransfer(from.card(), to.card(), amt, from.getBalance(), nowStamp()); // log transfer
+            if (log) log->logTransfer(from.id(), to.id(), amt, from.getBalance(), nowStamp()); // log transfer
         }
         else { // not enough money
+            timer.markFailed(); // count the decline
             out << " Transfer blocked by insufficient funds\n"; // display failure message
         }
     } // end DoTransfer
@@ -11,6 +11,7 @@ namespace atmapp { // begin atmapp namespace
 	void ShowBanner(std::ostream& out); // display welcome banner
 	bool SignIn(std::istream& in, std::ostream& out, const Account& probe); // handle sign-in authentication process
 	void RunSession(std::istream& in, std::ostream& out, Account& active, Account& savings, TransactionLog* log = nullptr, FinanceLog* fin = nullptr, CreditProfile* credit = nullptr); // control the main ATM session logic
+	bool DoMenuOption(int choice, std::istream& in, std::ostream& out, Account& active, Account& savings, TransactionLog* log = nullptr, FinanceLog* fin = nullptr, CreditProfile* credit = nullptr); // run one menu option, return false when the session should end
 	void DoBalance(std::ostream& out, const Account& checking, const Account& savings); // show balances for checking and savings accounts
 	void DoDeposit(std::istream& in, std::ostream& out, Account& acct, TransactionLog* log = nullptr); // process a deposit operation
 	void DoWithdraw(std::istream& in, std::ostream& out, Account& acct, TransactionLog* log = nullptr); // process a withdrawal operation
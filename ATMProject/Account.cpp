@@ -4,11 +4,16 @@
 namespace atmapp { // begin atmapp namespace
 
     Account::Account(std::string owner, std::string card, int pin, double balance) // constructor with initialization
-        : m_owner(std::move(owner)), m_card(std::move(card)), m_pin(pin), m_balance(balance) { // move owner and card to members, set pin and balance
+        : m_owner(std::move(owner)), m_card(std::move(card)), m_id(CardId::Parse(m_card)), m_pin(pin), m_balance(balance) { // move owner and card to members, parse the id once, set pin and balance
+    } // end constructor
+
+    Account::Account(std::string owner, CardId id, int pin, double balance) // constructor from a card id
+        : m_owner(std::move(owner)), m_card(CardText(id)), m_id(id), m_pin(pin), m_balance(balance) { // masked text for display, the full number for lookups
     } // end constructor
 
     const std::string& Account::owner() const { return m_owner; } // return reference to account owner's name
     const std::string& Account::card() const { return m_card; } // return reference to card identifier
+    CardId Account::id() const { return m_id; } // return compact card identifier
     bool Account::checkPin(int entered) const { return entered == m_pin; } // verify if entered pin matches stored pin
     double Account::getBalance() const { return m_balance; } // return current balance value
 
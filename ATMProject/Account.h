@@ -1,13 +1,16 @@
 #pragma once // prevent multiple inclusion of this header file
 #include <string> // include string type for storing text data
+#include "CardId.h" // include compact card identifiers
 
 namespace atmapp { // begin atmapp namespace
 
     class Account { // define Account class to represent a bank account
     public: // public interface accessible to other parts of the program
         Account(std::string owner, std::string card, int pin, double balance); // constructor initializing owner, card, pin, and balance
+        Account(std::string owner, CardId id, int pin, double balance); // same, from a full card number, the text shows only its last four digits
         const std::string& owner() const; // return reference to account owner's name
         const std::string& card() const; // return reference to card identifier string
+        CardId id() const; // compact card identifier parsed from the card text
         bool checkPin(int entered) const; // verify entered pin against stored pin
         double getBalance() const; // return current balance of the account
         bool deposit(double amount); // deposit funds into the account
@@ -17,6 +20,7 @@ namespace atmapp { // begin atmapp namespace
     private: // internal data members not accessible outside the class
         std::string m_owner; // name of account owner
         std::string m_card; // masked card identifier
+        CardId m_id; // card number and kind, what logs and lookups use
         int m_pin; // personal identification number
         double m_balance; // current account balance
     }; // end of Account class
@@ -0,0 +1,48 @@
+#include "AliasTable.h" // include header for AliasTable class
+#include <cmath> // include pow for Zipf weights
+#include <algorithm> // include max for clamping weights
+
+namespace atmapp { // begin atmapp namespace
+
+    AliasTable::AliasTable(const std::vector<double>& weights) { // build with Vose's variant of Walker's method
+        const std::size_t n = weights.size(); // number of outcomes
+        m_threshold.assign(n, 0); // start with empty thresholds
+        m_alias.assign(n, 0); // start with empty aliases
+        m_prob.assign(n, 0.0); // start with empty probabilities
+        if (n == 0) return; // nothing to build
+        double total = 0.0; // sum of valid weights
+        for (double w : weights) if (w > 0.0) total += w; // ignore negative or zero weights
+        std::vector<double> scaled(n); // probabilities scaled so the average column holds 1.0
+        for (std::size_t i = 0; i < n; ++i) { // normalize every weight
+            double p = total > 0.0 ? std::max(0.0, weights[i]) / total : 1.0 / static_cast<double>(n); // uniform when all weights are empty
+            m_prob[i] = p; // keep the normalized probability
+            scaled[i] = p * static_cast<double>(n); // scale for the column layout
+        } // end for
+        std::vector<uint32_t> small; // columns holding less than their share
+        std::vector<uint32_t> large; // columns holding more than their share
+        small.reserve(n); // avoid regrowth
+        large.reserve(n); // avoid regrowth
+        for (std::size_t i = 0; i < n; ++i) (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i)); // split by share
+        while (!small.empty() && !large.empty()) { // pair each small column with a large donor
+            uint32_t s = small.back(); small.pop_back(); // take a small column
+            uint32_t l = large.back(); large.pop_back(); // take a donor
+            m_threshold[s] = static_cast<uint64_t>(scaled[s] * 4294967296.0); // keep s with its own probability
+            m_alias[s] = l; // otherwise fall through to the donor
+            scaled[l] -= 1.0 - scaled[s]; // donor gives away the remainder of the column
+            (scaled[l] < 1.0 ? small : large).push_back(l); // donor may now be small
+        } // end while
+        for (uint32_t i : large) { m_threshold[i] = 4294967296ull; m_alias[i] = i; } // leftovers fill their column completely
+        for (uint32_t i : small) { m_threshold[i] = 4294967296ull; m_alias[i] = i; } // rounding leftovers are treated as full
+    } // end constructor
+
+    double AliasTable::probability(std::size_t i) const { // report the normalized input probability
+        return i < m_prob.size() ? m_prob[i] : 0.0; // zero for out of range outcomes
+    } // end probability
+
+    std::vector<double> ZipfWeights(std::size_t n, double exponent) { // build Zipf style rank weights
+        std::vector<double> w(n); // one weight per rank
+        for (std::size_t i = 0; i < n; ++i) w[i] = 1.0 / std::pow(static_cast<double>(i + 1), exponent); // rank one is the most likely
+        return w; // return weights, normalization happens in AliasTable
+    } // end ZipfWeights
+
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <vector> // include vector for the probability and alias columns
+#include <cstdint> // include fixed width integer types
+#include <cstddef> // include size_t
+#include <random> // include random engine type
+
+namespace atmapp { // begin atmapp namespace
+
+    class AliasTable { // Walker alias table for O(1) sampling from a fixed discrete distribution
+    public: // public interface
+        AliasTable() = default; // empty table, must be built before sampling
+        explicit AliasTable(const std::vector<double>& weights); // build the table from non negative weights in O(n)
+        std::size_t size() const { return m_alias.size(); } // number of outcomes
+        double probability(std::size_t i) const; // normalized probability of outcome i, mainly for reporting
+
+        std::size_t sample(std::mt19937_64& rng) const { // draw one outcome using a single 64-bit random value
+            uint64_t r = rng(); // high half picks the column, low half flips the biased coin
+            std::size_t col = static_cast<std::size_t>(((r >> 32) * static_cast<uint64_t>(m_alias.size())) >> 32); // unbiased enough column pick without division
+            return (r & 0xFFFFFFFFull) < m_threshold[col] ? col : m_alias[col]; // keep the column or jump to its alias
+        } // end sample
+
+    private: // private members
+        std::vector<uint64_t> m_threshold; // coin threshold per column scaled to 2^32
+        std::vector<uint32_t> m_alias; // alternative outcome per column
+        std::vector<double> m_prob; // normalized input probabilities
+    }; // end of class
+
+    std::vector<double> ZipfWeights(std::size_t n, double exponent); // weights proportional to 1 / rank^exponent
+
+}
\ No newline at end of file
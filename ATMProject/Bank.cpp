@@ -0,0 +1,89 @@
+#include "Bank.h" // include header for Bank and Customer
+#include <random> // include random generation for synthetic customers
+#include <string> // include string building for card numbers
+#include <utility> // include std::move
+
+namespace atmapp { // begin atmapp namespace
+
+    Bank::Bank(std::vector<Customer> customers) // construct from a customer list
+        : m_customers(std::move(customers)), m_locks(new std::mutex[m_customers.size()]) { // one lock per customer
+        std::vector<std::pair<CardId, uint32_t>> cards; // directory entries
+        cards.reserve(m_customers.size() * 2); // both accounts of every customer
+        for (std::size_t i = 0; i < m_customers.size(); ++i) { // index every card
+            cards.emplace_back(m_customers[i].checking.id(), static_cast<uint32_t>(i)); // checking card
+            cards.emplace_back(m_customers[i].savings.id(), static_cast<uint32_t>(i)); // savings card
+        } // end for
+        m_cards = CardDirectory(cards); // static perfect hash, built once
+        m_usage = CustomerMemory(m_customers); // records and strings
+        m_usage.entryBytes += m_customers.size() * sizeof(std::mutex); // lock array
+        m_usage.allocations += m_customers.empty() ? 0 : 1; // one block
+        m_usage.encodedBytes += m_cards.memoryBytes(); // directory tables
+        m_usage.allocations += 3; // seeds, keys and values
+    } // end constructor
+
+    MemoryUsage CustomerMemory(const std::vector<Customer>& customers) { // walk the records
+        MemoryUsage u; // result
+        u.items = customers.size(); // customers
+        AddVector(u, customers); // record slots
+        for (const Customer& c : customers) for (const Account* a : { &c.checking, &c.savings }) { AddString(u, a->owner()); AddString(u, a->card()); } // names and card text beyond the inline buffers
+        return u; // footprint
+    } // end CustomerMemory
+
+    std::size_t Bank::size() const { return m_customers.size(); } // number of customers
+    Customer& Bank::at(std::size_t i) { return m_customers[i]; } // access one customer
+    const Customer& Bank::at(std::size_t i) const { return m_customers[i]; } // read only access
+    std::mutex& Bank::lockFor(std::size_t i) { return m_locks[i]; } // lock for one customer
+
+    long long Bank::findCard(std::string_view digits) const { // look up a checking card by its number
+        uint64_t number = 0; // card digits
+        if (!ParseCardDigits(digits, number)) return -1; // one to eighteen digits
+        return m_cards.find(CardId(CardKind::Checking, number)); // integer probe, no string hashing
+    } // end findCard
+
+    std::vector<Customer> DemoCustomers() { // build the sample customers
+        std::vector<Customer> customers; // list of customers
+        customers.push_back(Customer{ Account("Josh",  "Card. **** **** **** 4242", 1234, 1250.00), // add Josh checking
+                                      Account("Josh",  "Savings. **** **** **** 8844", 1234, 3000.00) }); // add Josh savings
+        customers.push_back(Customer{ Account("Ava",   "Card. **** **** **** 1111", 1111, 800.00), // add Ava checking
+                                      Account("Ava",   "Savings. **** **** **** 9111", 1111, 1200.00) }); // add Ava savings
+        customers.push_back(Customer{ Account("Liam",  "Card. **** **** **** 2222", 2222, 920.00), // add Liam checking
+                                      Account("Liam",  "Savings. **** **** **** 9222", 2222, 400.00) }); // add Liam savings
+        customers.push_back(Customer{ Account("Mia",   "Card. **** **** **** 3333", 3333, 450.50), // add Mia checking
+                                      Account("Mia",   "Savings. **** **** **** 9333", 3333, 610.00) }); // add Mia savings
+        customers.push_back(Customer{ Account("Noah",  "Card. **** **** **** 4444", 4444, 77.77), // add Noah checking
+                                      Account("Noah",  "Savings. **** **** **** 9444", 4444, 88.88) }); // add Noah savings
+        customers.push_back(Customer{ Account("Emma",  "Card. **** **** **** 5555", 5555, 5100.12), // add Emma checking
+                                      Account("Emma",  "Savings. **** **** **** 9555", 5555, 2500.00) }); // add Emma savings
+        customers.push_back(Customer{ Account("Lucas", "Card. **** **** **** 6666", 6666, 25.00), // add Lucas checking
+                                      Account("Lucas", "Savings. **** **** **** 9666", 6666, 75.00) }); // add Lucas savings
+        customers.push_back(Customer{ Account("Sophia","Card. **** **** **** 7777", 7777, 190.00), // add Sophia checking
+                                      Account("Sophia","Savings. **** **** **** 9777", 7777, 310.00) }); // add Sophia savings
+        customers.push_back(Customer{ Account("Elena", "Card. **** **** **** 8888", 8888, 999.99), // add Elena checking
+                                      Account("Elena", "Savings. **** **** **** 9888", 8888, 150.00) }); // add Elena savings
+        return customers; // return sample list
+    } // end DemoCustomers
+
+    std::vector<Customer> SyntheticCustomers(std::size_t count, uint64_t seed) { // generate many customers
+        std::mt19937_64 rng(seed); // repeatable generator
+        std::uniform_real_distribution<double> dbal(50.0, 20000.0); // opening balance range
+        std::vector<Customer> customers; // generated list
+        customers.reserve(count); // one allocation
+        for (std::size_t i = 0; i < count; ++i) { // build each customer
+            CardId checking(CardKind::Checking, SyntheticCardNumber(i)); // full number from the index
+            CardId savings(CardKind::Savings, SyntheticCardNumber(i) + 1000000000000000ull); // its own range so the numbers differ too
+            int pin = SyntheticPin(i); // four digit pin derived from the index
+            std::string owner = "Customer " + std::to_string(i + 1); // numbered owner name
+            customers.push_back(Customer{ Account(owner, checking, pin, dbal(rng)), Account(owner, savings, pin, dbal(rng)) }); // add the pair
+        } // end for
+        return customers; // return generated list
+    } // end SyntheticCustomers
+
+    int SyntheticPin(std::size_t index) { // pin rule for synthetic customers
+        return 1000 + static_cast<int>(index % 9000); // always four digits
+    } // end SyntheticPin
+
+    uint64_t SyntheticCardNumber(std::size_t index) { // card number rule for synthetic customers
+        return 4000000000000000ull + static_cast<uint64_t>(index); // sixteen digits for any store below a quadrillion customers
+    } // end SyntheticCardNumber
+
+}
@@ -0,0 +1,43 @@
+#pragma once // prevent multiple inclusion of this header file
+#include "Account.h" // include Account class definition
+#include <vector> // include vector container
+#include <memory> // include unique_ptr for the lock array
+#include <mutex> // include mutex for per customer locking
+#include <cstddef> // include size_t
+#include <cstdint> // include fixed width integer types
+#include <string_view> // include string_view lookups
+#include "CardId.h" // include card ids and the perfect hash directory
+#include "MemoryUsage.h" // include footprint reports
+
+namespace atmapp { // begin atmapp namespace
+
+    struct Customer { // define a simple customer record
+        Account checking; // checking account object
+        Account savings; // savings account object
+    }; // end of Customer
+
+    class Bank { // customer accounts plus one lock per customer so sessions can run concurrently
+    public: // public interface
+        explicit Bank(std::vector<Customer> customers); // take ownership of the customer list
+        std::size_t size() const; // number of customers
+        Customer& at(std::size_t i); // access one customer
+        const Customer& at(std::size_t i) const; // read only access to one customer
+        std::mutex& lockFor(std::size_t i); // lock guarding one customer's accounts, held for a whole session
+        long long findCard(std::string_view digits) const; // customer whose checking card number is these digits, or -1, a demo card's number is its four visible digits
+        long long findCard(CardId id) const { return m_cards.find(id); } // customer holding this checking or savings card, or -1
+        const MemoryUsage& memoryUsage() const { return m_usage; } // records, locks and the card directory, measured once since names and cards never change
+
+    private: // internal data
+        std::vector<Customer> m_customers; // every customer record
+        std::unique_ptr<std::mutex[]> m_locks; // one lock per customer, mutexes cannot live inside a growable vector
+        CardDirectory m_cards; // every checking and savings card to its customer, first customer wins
+        MemoryUsage m_usage; // footprint taken at construction
+    }; // end of Bank class
+
+    MemoryUsage CustomerMemory(const std::vector<Customer>& customers); // records and their name and card strings, one item per customer
+    std::vector<Customer> DemoCustomers(); // the sample customers offered at the card prompt
+    std::vector<Customer> SyntheticCustomers(std::size_t count, uint64_t seed); // many generated customers for load tests
+    int SyntheticPin(std::size_t index); // pin given to the synthetic customer at index
+    uint64_t SyntheticCardNumber(std::size_t index); // sixteen digit checking card number of the synthetic customer at index, unique per index
+
+}
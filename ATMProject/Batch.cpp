@@ -0,0 +1,166 @@
+#include "Batch.h" // include header for the batch protocol
+#include "Bank.h" // include customer records and locks
+#include "Transaction.h" // include transaction log
+#include "ShardedLog.h" // include per thread logging for concurrent sessions
+#include "Finance.h" // include finance log for credit estimates
+#include "Credit.h" // include credit scoring
+#include "PinThrottle.h" // include shared pin attempt limits
+
+#include <iostream> // include input and output stream library
+#include <charconv> // include from_chars and to_chars for fast number conversion
+#include <mutex> // include lock_guard for per customer locks
+#include <vector> // include vector for the read buffer
+
+namespace atmapp { // begin atmapp namespace
+
+    static const double kMinAmount = 0.01; // same bounds as the interactive prompts
+    static const double kMaxAmount = 1000000.0; // same bounds as the interactive prompts
+    static const std::size_t kReadChunk = 1 << 16; // bytes read from the input per call
+    static const std::size_t kFlushAt = 1 << 16; // reply bytes buffered before one large write
+
+    static std::string_view nextToken(std::string_view& rest) { // split off the next space separated token
+        std::size_t start = rest.find_first_not_of(" \t\r"); // skip leading blanks
+        if (start == std::string_view::npos) { rest = std::string_view(); return std::string_view(); } // nothing left
+        std::size_t end = rest.find_first_of(" \t\r", start); // end of the token
+        std::string_view tok = rest.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start); // token text
+        rest = end == std::string_view::npos ? std::string_view() : rest.substr(end); // remainder
+        return tok; // return token
+    } // end nextToken
+
+    static bool parseAmount(std::string_view tok, double& out) { // parse a money amount in range
+        if (tok.empty()) return false; // missing
+        auto res = std::from_chars(tok.data(), tok.data() + tok.size(), out); // locale free parse
+        return res.ec == std::errc() && res.ptr == tok.data() + tok.size() && out >= kMinAmount && out <= kMaxAmount; // whole token and in range
+    } // end parseAmount
+
+    static void appendMoney(std::string& reply, double v) { // two decimal amount without streams
+        char buf[32]; // scratch space
+        auto res = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, 2); // fixed point with cents
+        reply.append(buf, res.ptr); // append digits
+    } // end appendMoney
+
+    BatchSession::BatchSession(Bank& bank, TransactionLog* log, FinanceLog* fin) // bind session to shared state
+        : m_bank(bank), m_log(log), m_shards(nullptr), m_fin(fin), m_customer(-1), m_errors(0), m_stampTime(0) { // nobody signed in yet
+    } // end constructor
+
+    BatchSession::BatchSession(Bank& bank, ShardedTxLog* shards, FinanceLog* fin) // bind session to shared state and a sharded log
+        : m_bank(bank), m_log(nullptr), m_shards(shards), m_fin(fin), m_customer(-1), m_errors(0), m_stampTime(0) { // nobody signed in yet
+    } // end constructor
+
+    const std::string& BatchSession::stamp() { // timestamp text for log entries
+        std::time_t t = std::time(nullptr); // current second
+        if (t != m_stampTime || m_stamp.empty()) { // new second
+            std::tm localTime{}; // structure for local time data
+#if defined(_WIN32)
+            localtime_s(&localTime, &t); // convert to local time on Windows
+#else
+            localtime_r(&t, &localTime); // convert to local time on other systems
+#endif
+            char buf[32]; // buffer to hold formatted date
+            std::size_t n = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &localTime); // same format as interactive sessions
+            m_stamp.assign(buf, n); // cache text
+            m_stampTime = t; // remember its second
+        } // end if
+        return m_stamp; // return cached text
+    } // end stamp
+
+    bool BatchSession::execute(std::string_view line, std::string& reply) { // run one command
+        std::string_view rest = line; // unparsed remainder
+        std::string_view cmd = nextToken(rest); // command word
+        if (cmd.empty() || cmd[0] == '#') return false; // blank or comment
+        auto fail = [&](const char* why) { ++m_errors; reply += "ERR "; reply += why; reply += '\n'; return true; }; // error reply
+        if (cmd == "SIGNIN") { // authenticate a card
+            m_customer = -1; // any earlier card is released, even when this attempt fails
+            std::string_view card = nextToken(rest); // checking card number
+            std::string_view pinText = nextToken(rest); // pin digits
+            long long idx = m_bank.findCard(card); // find the customer
+            if (idx < 0) return fail("CARD"); // unknown card
+            int pin = 0; // parsed pin
+            auto res = std::from_chars(pinText.data(), pinText.data() + pinText.size(), pin); // parse pin
+            if (res.ec != std::errc() || pinText.empty()) return fail("PIN"); // not a pin, no attempt used
+            const Account& acct = m_bank.at(static_cast<std::size_t>(idx)).checking; // card holder
+            PinThrottle& throttle = SharedPinThrottle(); // attempts shared across every connection
+            uint32_t now = PinThrottle::Now(); // one clock read for the command
+            if (!throttle.beginAttempt(acct.id(), now)) return fail("LOCKED"); // too many wrong pins on this card
+            if (!acct.checkPin(pin)) return fail("PIN"); // wrong pin, the attempt stays counted
+            throttle.succeeded(acct.id(), now); // clear the failures
+            m_customer = idx; // card is now active
+            reply += "OK "; reply += m_bank.at(static_cast<std::size_t>(idx)).checking.owner(); reply += '\n'; // greet
+            return true; // handled
+        } // end if
+        if (cmd == "SIGNOUT") { m_customer = -1; reply += "OK\n"; return true; } // release the card
+        bool known = cmd == "BAL" || cmd == "DEP" || cmd == "WD" || cmd == "XFER" || cmd == "CREDIT"; // account commands
+        if (!known) return fail("COMMAND"); // unknown word
+        if (m_customer < 0) return fail("AUTH"); // no card active
+        std::size_t idx = static_cast<std::size_t>(m_customer); // active customer
+        double amt = 0.0; // amount for money commands
+        if ((cmd == "DEP" || cmd == "WD" || cmd == "XFER") && !parseAmount(nextToken(rest), amt)) return fail("AMOUNT"); // bad amount
+        std::lock_guard<std::mutex> guard(m_bank.lockFor(idx)); // other sessions may share the customer
+        Customer& c = m_bank.at(idx); // account pair
+        if (cmd == "BAL") { // balances
+            reply += "OK "; appendMoney(reply, c.checking.getBalance()); reply += ' '; appendMoney(reply, c.savings.getBalance()); reply += '\n'; // both balances
+        }
+        else if (cmd == "DEP") { // deposit into checking
+            if (!c.checking.deposit(amt)) return fail("AMOUNT"); // rejected
+            if (m_log) m_log->logDeposit(c.checking.id(), amt, c.checking.getBalance(), stamp()); // log deposit
+            if (m_shards) m_shards->logDeposit(c.checking.id(), amt, c.checking.getBalance()); // log deposit in this thread's shard
+            reply += "OK "; appendMoney(reply, c.checking.getBalance()); reply += '\n'; // new balance
+        }
+        else if (cmd == "WD") { // withdraw from checking
+            if (!c.checking.withdraw(amt)) return fail("FUNDS"); // insufficient funds
+            if (m_log) m_log->logWithdraw(c.checking.id(), amt, c.checking.getBalance(), stamp()); // log withdrawal
+            if (m_shards) m_shards->logWithdraw(c.checking.id(), amt, c.checking.getBalance()); // log withdrawal in this thread's shard
+            reply += "OK "; appendMoney(reply, c.checking.getBalance()); reply += '\n'; // new balance
+        }
+        else if (cmd == "XFER") { // checking to savings
+            if (!c.checking.transferTo(c.savings, amt)) return fail("FUNDS"); // insufficient funds
+            if (m_log) m_log->logTransfer(c.checking.id(), c.savings.id(), amt, c.checking.getBalance(), stamp()); // log transfer
+            if (m_shards) m_shards->logTransfer(c.checking.id(), c.savings.id(), amt, c.checking.getBalance()); // log transfer in this thread's shard
+            reply += "OK "; appendMoney(reply, c.checking.getBalance()); reply += ' '; appendMoney(reply, c.savings.getBalance()); reply += '\n'; // both balances
+        }
+        else { // CREDIT
+            CreditProfile credit; // scratch profile
+            double income = m_fin ? m_fin->monthlyIncomeEstimate() : 0.0; // cached per published version, so a new history is picked up at once
+            double spend = m_fin ? m_fin->monthlySpendEstimate() : 0.0; // spending estimate of the same kind
+            credit.compute(c.checking.getBalance(), c.savings.getBalance(), income, spend); // same scoring as the menu
+            char buf[16]; // scratch space
+            auto res = std::to_chars(buf, buf + sizeof(buf), credit.score()); // score digits
+            reply += "OK "; reply.append(buf, res.ptr); reply += '\n'; // score reply
+        }
+        return true; // handled
+    } // end execute
+
+    uint64_t RunBatch(std::istream& in, std::ostream& out, Bank& bank, TransactionLog* log, FinanceLog* fin) { // pipelined read, execute, reply loop
+        BatchSession session(bank, log, fin); // one client for the whole input
+        std::vector<char> buf(kReadChunk); // read buffer
+        std::string carry; // partial line left over from the previous chunk
+        std::string reply; // replies waiting for one large write
+        reply.reserve(kFlushAt + 256); // avoid regrowth between flushes
+        uint64_t executed = 0; // commands that produced a reply
+        while (in) { // until end of input
+            in.read(buf.data(), static_cast<std::streamsize>(buf.size())); // fill the buffer
+            std::size_t got = static_cast<std::size_t>(in.gcount()); // bytes read
+            if (got == 0) break; // nothing more
+            std::string_view chunk(buf.data(), got); // view over the new bytes
+            std::size_t pos = 0; // scan position
+            while (true) { // each complete line in the chunk
+                std::size_t nl = chunk.find('\n', pos); // end of line
+                if (nl == std::string_view::npos) break; // partial line
+                if (!carry.empty()) { // line started in an earlier chunk
+                    carry.append(chunk.data() + pos, nl - pos); // finish it
+                    if (session.execute(carry, reply)) ++executed; // run it
+                    carry.clear(); // reset
+                }
+                else if (session.execute(chunk.substr(pos, nl - pos), reply)) ++executed; // run the line in place
+                pos = nl + 1; // next line
+                if (reply.size() >= kFlushAt) { out.write(reply.data(), static_cast<std::streamsize>(reply.size())); reply.clear(); } // large write
+            } // end while
+            carry.append(chunk.data() + pos, chunk.size() - pos); // keep the partial line
+        } // end while
+        if (!carry.empty() && session.execute(carry, reply)) ++executed; // last line without a newline
+        out.write(reply.data(), static_cast<std::streamsize>(reply.size())); // final write
+        out.flush(); // make replies visible
+        return executed; // commands executed
+    } // end RunBatch
+
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <string> // include string for reply buffers
+#include <string_view> // include string_view for zero copy command parsing
+#include <iosfwd> // forward declare iostream types for efficiency
+#include <ctime> // include time_t for the timestamp cache
+#include <cstdint> // include fixed width integer types
+
+namespace atmapp { // begin atmapp namespace
+
+    class Bank; // forward declaration of Bank class
+    class TransactionLog; // forward declaration of TransactionLog class
+    class ShardedTxLog; // forward declaration of ShardedTxLog class
+    class FinanceLog; // forward declaration of FinanceLog class
+
+    // Line protocol, one command per line, one reply line per command.
+    //   SIGNIN <card> <pin>    OK <owner>              | ERR CARD | ERR PIN | ERR LOCKED, card is the checking card number
+    //   BAL                    OK <checking> <savings>
+    //   DEP <amount>           OK <checking>           | ERR AMOUNT
+    //   WD <amount>            OK <checking>           | ERR AMOUNT | ERR FUNDS
+    //   XFER <amount>          OK <checking> <savings> | ERR AMOUNT | ERR FUNDS
+    //   CREDIT                 OK <score>
+    //   SIGNOUT                OK
+    // Account commands before a successful SIGNIN answer ERR AUTH, anything else ERR COMMAND. A failed SIGNIN leaves no card signed in.
+    // Blank lines and lines starting with # are skipped without a reply.
+    // Wrong pins count against the card in SharedPinThrottle, so ERR LOCKED holds across connections until the count decays.
+
+    class BatchSession { // protocol state for one client, replaces the menu loop of RunSession
+    public: // public interface
+        BatchSession(Bank& bank, TransactionLog* log = nullptr, FinanceLog* fin = nullptr); // bind to the shared account store
+        BatchSession(Bank& bank, ShardedTxLog* shards, FinanceLog* fin); // same, logging into the calling thread's shard so concurrent sessions share no lock
+        bool execute(std::string_view line, std::string& reply); // run one command and append its reply, false when the line was skipped
+        bool signedIn() const { return m_customer >= 0; } // whether a card is active
+        uint64_t errors() const { return m_errors; } // commands answered with ERR
+
+    private: // internal helpers and data
+        const std::string& stamp(); // timestamp text, reformatted at most once per second
+        Bank& m_bank; // account store
+        TransactionLog* m_log; // optional transaction log
+        ShardedTxLog* m_shards; // optional sharded log for concurrent sessions
+        FinanceLog* m_fin; // optional history for credit estimates
+        long long m_customer; // signed in customer index or -1
+        uint64_t m_errors; // error replies so far
+        std::time_t m_stampTime; // second the cached stamp belongs to
+        std::string m_stamp; // cached timestamp text
+    }; // end of BatchSession class
+
+    uint64_t RunBatch(std::istream& in, std::ostream& out, Bank& bank, TransactionLog* log = nullptr, FinanceLog* fin = nullptr); // read commands until end of input, return commands executed
+
+}
\ No newline at end of file
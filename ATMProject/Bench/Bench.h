@@ -0,0 +1,38 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <iosfwd> // forward declare iostream types for efficiency
+#include <streambuf> // include streambuf for the discarding sink
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace for benchmark entry points
+
+        class DiscardBuffer : public std::streambuf { // accepts and drops all output so formatting cost stays in the measurement
+        protected: // streambuf overrides
+            int_type overflow(int_type c) override { return traits_type::not_eof(c); } // drop one character
+            std::streamsize xsputn(const char*, std::streamsize n) override { return n; } // drop a block
+        }; // end DiscardBuffer
+
+        int RunAlloc(std::ostream& out, int argc, char** argv); // heap, pool and arena lists of events and transactions, build and drop
+        int RunBatch(std::ostream& out, int argc, char** argv); // batch protocol commands per second
+        int RunCards(std::ostream& out, int argc, char** argv); // perfect hash card directory against a string keyed map
+        int RunClients(std::ostream& out, int argc, char** argv); // simulated terminals against the epoll server
+        int RunDataGen(std::ostream& out, int argc, char** argv); // date and event generation throughput
+        int RunFormat(std::ostream& out, int argc, char** argv); // statement rows per second through RowBuffer
+        int RunHistory(std::ostream& out, int argc, char** argv); // columnar history file against the in memory list
+        int RunImport(std::ostream& out, int argc, char** argv); // statement CSV import MiB per second
+        int RunMemory(std::ostream& out, int argc, char** argv); // walked memory footprints against counting resources and the cost of one report
+        int RunMetrics(std::ostream& out, int argc, char** argv); // cost of recording one instrumented operation
+        int RunMicro(std::ostream& out, int argc, char** argv); // library microbenchmarks, median and MAD per operation, JSON report
+        int RunPacked(std::ostream& out, int argc, char** argv); // compressed history size, decode speed and random access
+        int RunProjection(std::ostream& out, int argc, char** argv); // Monte Carlo credit outlook latency, thread scaling and the batch scoring kernel
+        int RunSessions(std::ostream& out, int argc, char** argv); // scripted concurrent sessions with per option latency
+        int RunShards(std::ostream& out, int argc, char** argv); // per thread transaction log shards against one locked log
+        int RunSnapshots(std::ostream& out, int argc, char** argv); // reader latency on FinanceLog while the history is republished
+        int RunStatements(std::ostream& out, int argc, char** argv); // monthly statement files per second
+        int RunThrottle(std::ostream& out, int argc, char** argv); // lock free PIN attempt table against a locked map, and lockout under contention
+        int RunTimeline(std::ostream& out, int argc, char** argv); // per customer radix sort and the streaming bank wide merge against a heap and a full sort
+        int RunTxLog(std::ostream& out, int argc, char** argv); // tiered transaction log memory and scan speed
+
+    } // end bench namespace
+
+}
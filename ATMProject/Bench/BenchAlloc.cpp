@@ -0,0 +1,118 @@
+#include "Bench.h" // include benchmark entry points
+#include "Finance.h" // include FinEvent, FinEventList and FinBatch
+#include "Transaction.h" // include allocator aware Transaction
+#include "DataGen.h" // include event stream
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for timing
+#include <cstdio> // include snprintf for stamp text
+#include <cstdlib> // include strtoll for arguments
+#include <memory_resource> // include pool and monotonic resources
+#include <new> // include placement new for a list inside an arena
+#include <string> // include string type
+#include <type_traits> // include is_same for the FinBatch path
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        class CountingResource : public std::pmr::memory_resource { // new and delete with a tally, the allocations the heap would see
+        public: // counters read after each phase
+            uint64_t allocs = 0; // allocate calls
+            uint64_t frees = 0; // deallocate calls
+            uint64_t live = 0; // bytes currently held
+
+        protected: // memory_resource overrides
+            void* do_allocate(std::size_t bytes, std::size_t align) override { ++allocs; live += bytes; return std::pmr::new_delete_resource()->allocate(bytes, align); } // count and forward
+            void do_deallocate(void* p, std::size_t bytes, std::size_t align) override { ++frees; live -= bytes; std::pmr::new_delete_resource()->deallocate(p, bytes, align); } // count and forward
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; } // only itself
+        }; // end of CountingResource class
+
+        enum class AllocMode { Heap, Pool, Arena }; // where a list and its strings live
+
+        struct AllocResult { double genSecs = 0.0; uint64_t allocs = 0; double mib = 0.0; double dropSecs = 0.0; uint64_t frees = 0; }; // one measured row
+
+        static void fillEvents(FinEventList& list, long long n) { // n generated events built in place on the list's resource
+            DataGen gen(5); // fixed seed
+            FinEventStream stream = gen.stream(static_cast<int>(n / 60 + 1), 56, 4); // about sixty events per month
+            list.reserve(static_cast<std::size_t>(n) + 1); // slots up front, plus the one an exhausted stream leaves empty
+            for (long long i = 0; i < n; ++i) if (!stream.next(list.emplace_back())) { list.pop_back(); break; } // fill each slot in place
+        } // end fillEvents
+
+        static void fillTransactions(std::pmr::vector<Transaction>& list, long long n) { // n session-like transactions on the list's resource
+            CardId cards[1000]; // card ids
+            for (int i = 0; i < 1000; ++i) cards[i] = CardId(CardKind::Checking, static_cast<uint64_t>(i)); // a thousand customers
+            char stamp[32] = {}; // current timestamp text
+            list.reserve(static_cast<std::size_t>(n)); // slots up front
+            for (long long i = 0; i < n; ++i) { // each transaction
+                if (i % 3 == 0) { long long s = i / 3, day = s / 86400, t = s % 86400; std::snprintf(stamp, sizeof(stamp), "2025-%02lld-%02lld %02lld:%02lld:%02lld", day / 28 % 12 + 1, day % 28 + 1, t / 3600, t / 60 % 60, t % 60); } // three per second
+                TxType type = static_cast<TxType>(i % 3); // rotate kinds
+                list.emplace_back(type, cards[i * 31 % 1000], type == TxType::Transfer ? cards[(i + 1) * 31 % 1000] : CardId(), static_cast<double>((i * 7919) % 50000 + 1) / 100.0, 1000.0 + static_cast<double>(i % 977), stamp); // stamp on the list's resource
+            } // end for
+        } // end fillTransactions
+
+        template <typename T, typename Fill> static AllocResult measure(AllocMode mode, long long n, Fill fill) { // build n entries, then drop them
+            using List = std::pmr::vector<T>; // container under test
+            CountingResource counter; // stands in for the global heap
+            AllocResult r; // result
+            auto t0 = std::chrono::steady_clock::now(); // build start
+            if (mode == AllocMode::Heap) { // one allocation per long string, freed one by one
+                auto list = new List(&counter); // list on the counted heap
+                fill(*list, n); // build
+                auto t1 = std::chrono::steady_clock::now(); // build end
+                r.genSecs = std::chrono::duration<double>(t1 - t0).count(); r.allocs = counter.allocs; r.mib = static_cast<double>(counter.live) / (1024.0 * 1024.0); // build figures
+                delete list; // every entry and string freed
+                r.dropSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count(); // drop time
+            } else if (mode == AllocMode::Pool) { // size class free lists, entries still destroyed one by one
+                auto pool = new std::pmr::unsynchronized_pool_resource(&counter); // pool over the counted heap
+                auto list = new List(pool); // list on the pool
+                fill(*list, n); // build
+                auto t1 = std::chrono::steady_clock::now(); // build end
+                r.genSecs = std::chrono::duration<double>(t1 - t0).count(); r.allocs = counter.allocs; r.mib = static_cast<double>(counter.live) / (1024.0 * 1024.0); // build figures
+                delete list; // entries back to the pool
+                delete pool; // pool chunks back to the heap
+                r.dropSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count(); // drop time
+            } else if constexpr (std::is_same_v<T, FinEvent>) { // the arena FinanceLog publishes
+                auto batch = std::make_unique<FinBatch>(64 * 1024, &counter); // arena over the counted heap
+                fill(batch->events(), n); // build
+                auto t1 = std::chrono::steady_clock::now(); // build end
+                r.genSecs = std::chrono::duration<double>(t1 - t0).count(); r.allocs = counter.allocs; r.mib = static_cast<double>(counter.live) / (1024.0 * 1024.0); // build figures
+                batch.reset(); // chunks freed, entries never visited
+                r.dropSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count(); // drop time
+            } else { // the same arena pattern for transactions
+                auto arena = new std::pmr::monotonic_buffer_resource(64 * 1024, &counter); // arena over the counted heap
+                List* list = new (arena->allocate(sizeof(List), alignof(List))) List(arena); // list inside the arena
+                fill(*list, n); // build
+                auto t1 = std::chrono::steady_clock::now(); // build end
+                r.genSecs = std::chrono::duration<double>(t1 - t0).count(); r.allocs = counter.allocs; r.mib = static_cast<double>(counter.live) / (1024.0 * 1024.0); // build figures
+                delete arena; // chunks freed, the list and its entries are never destroyed
+                r.dropSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count(); // drop time
+            } // end if
+            r.frees = counter.frees; // deallocations across the drop
+            return r; // result
+        } // end measure
+
+        static void report(std::ostream& out, const char* label, const AllocResult& r) { // one table row
+            out << " " << std::left << std::setw(20) << label << std::right << std::fixed << std::setprecision(0) << std::setw(10) << r.genSecs * 1000.0 << std::setw(12) << r.allocs << std::setw(9) << r.mib // build
+                << std::setprecision(3) << std::setw(12) << r.dropSecs * 1000.0 << std::setw(12) << r.frees << "\n"; // drop
+        } // end report
+
+        int RunAlloc(std::ostream& out, int argc, char** argv) { // heap, pool and arena lists of events and transactions
+            long long n = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 10000000; // entries per list
+            if (n <= 0) n = 10000000; // guard against bad input
+            out << "Allocation benchmark. " << n << " entries per list, build then drop\n"; // header
+            out << std::left << std::setw(21) << " list" << std::right << std::setw(10) << "build ms" << std::setw(12) << "allocs" << std::setw(9) << "MiB" << std::setw(12) << "drop ms" << std::setw(12) << "frees" << "\n"; // columns
+            report(out, "FinEvent, heap", measure<FinEvent>(AllocMode::Heap, n, fillEvents)); // every string on its own
+            report(out, "FinEvent, pool", measure<FinEvent>(AllocMode::Pool, n, fillEvents)); // size class pool
+            report(out, "FinEvent, FinBatch", measure<FinEvent>(AllocMode::Arena, n, fillEvents)); // monotonic arena
+            report(out, "Transaction, heap", measure<Transaction>(AllocMode::Heap, n, fillTransactions)); // every string on its own
+            report(out, "Transaction, pool", measure<Transaction>(AllocMode::Pool, n, fillTransactions)); // size class pool
+            report(out, "Transaction, arena", measure<Transaction>(AllocMode::Arena, n, fillTransactions)); // monotonic arena
+            return 0; // signal success
+        } // end RunAlloc
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,69 @@
+#include "Bench.h" // include benchmark entry points
+#include "Batch.h" // include batch protocol under test
+#include "Bank.h" // include customer records
+#include "Transaction.h" // include transaction log
+#include "Finance.h" // include finance log
+#include "DataGen.h" // include history generator
+
+#include <iostream> // include stream io
+#include <sstream> // include string stream input
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for timing
+#include <cstdio> // include snprintf for command text
+#include <cstdlib> // include strtoll for arguments
+#include <random> // include command mix randomness
+#include <string> // include string type
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static std::string buildCommands(long long n, std::size_t customers, uint64_t seed) { // protocol text for n commands
+            std::mt19937_64 rng(seed); // repeatable mix
+            std::uniform_int_distribution<std::size_t> dcust(0, customers - 1); // any customer
+            std::discrete_distribution<int> dop({ 25, 25, 20, 15, 15 }); // BAL, DEP, WD, XFER, CREDIT
+            std::uniform_int_distribution<int> dcents(100, 50000); // one to five hundred dollars
+            static const char* const kOps[] = { "BAL", "DEP", "WD", "XFER", "CREDIT" }; // command words
+            std::string text; // script
+            text.reserve(static_cast<std::size_t>(n) * 14); // rough size
+            char line[64]; // one command
+            long long written = 0; // commands so far
+            while (written < n) { // one session at a time
+                std::size_t c = dcust(rng); // customer
+                std::snprintf(line, sizeof(line), "SIGNIN %llu %d\n", static_cast<unsigned long long>(SyntheticCardNumber(c)), SyntheticPin(c)); // sign in
+                text += line; ++written; // count it
+                for (int k = 0; k < 20 && written < n; ++k, ++written) { // twenty commands per session
+                    int op = dop(rng); // command kind
+                    if (op >= 1 && op <= 3) { int cents = dcents(rng); std::snprintf(line, sizeof(line), "%s %d.%02d\n", kOps[op], cents / 100, cents % 100); } // money command
+                    else std::snprintf(line, sizeof(line), "%s\n", kOps[op]); // plain command
+                    text += line; // append
+                } // end for
+            } // end while
+            return text; // return script
+        } // end buildCommands
+
+        int RunBatch(std::ostream& out, int argc, char** argv) { // time the batch protocol end to end
+            long long n = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 5000000; // commands
+            long long store = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 100000; // customers
+            if (n <= 0) n = 5000000; // guard against bad input
+            if (store <= 0) store = 100000; // guard against bad input
+            const std::size_t customers = static_cast<std::size_t>(store); // every customer has its own card number
+            Bank bank(SyntheticCustomers(customers, 7)); // account store
+            FinanceLog fin; // history for credit commands
+            fin.set(DataGen(3).generateQuarterHistory(18, 2)); // same size as the interactive app
+            TransactionLog log; // every money command is logged
+            std::istringstream in(buildCommands(n, customers, 5)); // input built before timing
+            DiscardBuffer sinkBuf; // replies are produced and dropped
+            std::ostream sink(&sinkBuf); // stream over the discarding buffer
+            auto start = std::chrono::steady_clock::now(); // start time
+            uint64_t done = atmapp::RunBatch(in, sink, bank, &log, &fin); // run everything
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // elapsed seconds
+            out << std::fixed << std::setprecision(0); // whole numbers
+            out << "Batch protocol benchmark. " << done << " commands, " << customers << " customers\n"; // header
+            out << " commands/sec. " << (secs > 0.0 ? static_cast<double>(done) / secs : 0.0) << "\n"; // throughput
+            return 0; // signal success
+        } // end RunBatch
+
+    } // end bench namespace
+
+}
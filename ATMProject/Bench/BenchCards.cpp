@@ -0,0 +1,80 @@
+#include "Bench.h" // include benchmark entry points
+#include "CardId.h" // include card ids and the perfect hash directory
+#include "Bank.h" // include the bank lookup built on the directory
+#include "Transaction.h" // include Transaction for its size
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <random> // include lookup order
+#include <string> // include string keys for the baseline
+#include <unordered_map> // include the string keyed baseline
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        int RunCards(std::ostream& out, int argc, char** argv) { // card directory against a string keyed hash map
+            long long n = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 1000000; // distinct cards
+            long long lookups = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 10000000; // probes per structure
+            if (n <= 0 || n > 100000000) n = 1000000; // guard against bad input
+            if (lookups <= 0) lookups = 10000000; // guard against bad input
+
+            std::mt19937_64 rng(11); // card numbers and probe order
+            std::vector<CardId> ids; // cards under test
+            std::vector<std::pair<CardId, uint32_t>> entries; // directory input
+            ids.reserve(static_cast<std::size_t>(n)); entries.reserve(static_cast<std::size_t>(n)); // one allocation each
+            for (long long i = 0; i < n; ++i) { // sixteen digit numbers, both kinds
+                CardId id(i % 2 ? CardKind::Savings : CardKind::Checking, 4000000000000000ull + rng() % 1000000000000000ull); // random card
+                ids.push_back(id); entries.emplace_back(id, static_cast<uint32_t>(i)); // value is the position
+            } // end for
+
+            auto b0 = std::chrono::steady_clock::now(); // directory build
+            CardDirectory dir(entries); // perfect hash
+            double dirBuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - b0).count(); // build time
+            std::vector<std::string> texts; // what Transaction and the bank index held before, full digits so keys stay distinct
+            texts.reserve(ids.size()); // one per card
+            for (CardId id : ids) texts.push_back(std::string(id.kind() == CardKind::Savings ? "Savings. " : "Card. ") + std::to_string(id.number())); // display style text
+            auto m0 = std::chrono::steady_clock::now(); // map build
+            std::unordered_map<std::string, uint32_t> map; // baseline
+            map.reserve(texts.size()); // no rehash while filling
+            for (std::size_t i = 0; i < texts.size(); ++i) map.emplace(texts[i], static_cast<uint32_t>(i)); // first wins like the directory
+            double mapBuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m0).count(); // build time
+
+            std::vector<uint32_t> order(static_cast<std::size_t>(std::min<long long>(lookups, 1 << 20))); // probe positions, reused cyclically
+            for (auto& o : order) o = static_cast<uint32_t>(rng() % static_cast<uint64_t>(n)); // random hits
+            bool ok = dir.size() == ids.size(); // every card got a slot
+            for (std::size_t i = 0; i < ids.size(); ++i) ok = ok && dir.find(ids[i]) == static_cast<long long>(map.find(texts[i])->second); // same answer as the map
+            for (int i = 0; i < 1000; ++i) ok = ok && dir.find(CardId(CardKind::Checking, 1000 + static_cast<uint64_t>(i))) == -1; // numbers never issued miss
+
+            long long sum = 0; // keeps the probes alive
+            auto d0 = std::chrono::steady_clock::now(); // directory probes
+            for (long long i = 0; i < lookups; ++i) sum += dir.find(ids[order[static_cast<std::size_t>(i) % order.size()]]); // integer key
+            double dirNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - d0).count() / static_cast<double>(lookups); // per probe
+            auto h0 = std::chrono::steady_clock::now(); // map probes
+            for (long long i = 0; i < lookups; ++i) sum -= map.find(texts[order[static_cast<std::size_t>(i) % order.size()]])->second; // string hash and compare
+            double mapNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - h0).count() / static_cast<double>(lookups); // per probe
+            ok = ok && sum == 0; // both returned the same values
+
+            Bank bank(SyntheticCustomers(static_cast<std::size_t>(n / 2), 3)); // the application path, two cards per customer
+            for (std::size_t i = 0; i < bank.size(); ++i) { // every customer
+                const Account& checking = bank.at(i).checking; // card holder
+                ok = ok && bank.findCard(std::to_string(SyntheticCardNumber(i))) == static_cast<long long>(i) && bank.findCard(bank.at(i).savings.id()) == static_cast<long long>(i); // both lookups
+                ok = ok && CardText(checking.id()) == checking.card() && CardId::Parse(checking.card()).number() == checking.id().number() % 10000; // display text shows only the last four digits
+            } // end for
+
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << "Card directory benchmark. " << n << " cards, " << lookups << " random lookups\n"; // header
+            out << "                       build ms   lookup ns   MiB\n"; // columns
+            out << " perfect hash        " << std::setw(10) << dirBuildMs << std::setw(12) << dirNs << std::setw(8) << static_cast<double>(dir.memoryBytes()) / (1024.0 * 1024.0) << "\n"; // directory
+            out << " unordered_map<str>  " << std::setw(10) << mapBuildMs << std::setw(12) << mapNs << std::setw(8) << "-" << "\n"; // baseline
+            out << " sizeof(CardId) " << sizeof(CardId) << " bytes, sizeof(Transaction) " << sizeof(Transaction) << " bytes\n"; // footprint
+            out << " lookups agree. " << (ok ? "yes" : "NO") << "\n"; // correctness
+            return ok ? 0 : 1; // fail on a wrong answer
+        } // end RunCards
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,178 @@
+#include "Bench.h" // include benchmark entry points
+#include "Server.h" // include terminal server under test
+#include "Bank.h" // include customer records
+#include "Finance.h" // include finance log
+#include "DataGen.h" // include history generator
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include sort
+#include <atomic> // include server stop flag
+#include <chrono> // include clocks for timing
+#include <cstdio> // include snprintf for command text
+#include <cstdlib> // include strtoll for arguments
+#include <string> // include string type
+#include <thread> // include server thread
+#include <vector> // include vector container
+
+#if defined(__linux__)
+#include <sys/epoll.h> // include epoll for the client side
+#include <sys/resource.h> // include descriptor limits
+#include <sys/socket.h> // include socket calls
+#include <sys/un.h> // include Unix domain addresses
+#include <unistd.h> // include close, read and getpid
+#include <fcntl.h> // include non blocking flags
+#include <cerrno> // include errno codes
+#include <cstring> // include memcpy
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+#if defined(__linux__)
+
+        static const char* const kClientOps[] = { "BAL\n", "DEP 12.50\n", "WD 10.00\n", "XFER 1.25\n", "BAL\n", "CREDIT\n" }; // command cycle after sign in
+
+        struct SimClient { // one simulated terminal, waits for each reply before sending the next command
+            int fd; // socket
+            std::size_t customer; // card it signs in with
+            long long sent; // commands written
+            long long answered; // replies read
+            uint64_t sentAt; // nanosecond clock when the outstanding command was written
+        }; // end SimClient
+
+        static uint64_t nowNs() { // monotonic nanoseconds
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); // steady clock
+        } // end nowNs
+
+        static int connectTo(const std::string& path) { // blocking connect, then non blocking for the event loop
+            int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0); // client socket
+            if (fd < 0) return -1; // out of descriptors
+            sockaddr_un addr{}; // server address
+            addr.sun_family = AF_UNIX; // Unix domain
+            std::memcpy(addr.sun_path, path.c_str(), std::min(path.size() + 1, sizeof(addr.sun_path) - 1)); // copy path
+            if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) { ::close(fd); return -1; } // refused
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK); // replies are read from epoll
+            return fd; // connected
+        } // end connectTo
+
+        static bool sendNext(SimClient& c) { // write the client's next command
+            char line[32]; // command text
+            int len; // command length
+            if (c.sent == 0) len = std::snprintf(line, sizeof(line), "SIGNIN %llu %d\n", static_cast<unsigned long long>(SyntheticCardNumber(c.customer)), SyntheticPin(c.customer)); // sign in first
+            else len = std::snprintf(line, sizeof(line), "%s", kClientOps[(c.sent - 1) % 6]); // then cycle the mix
+            c.sentAt = nowNs(); // start the round trip
+            ++c.sent; // count it
+            return ::send(c.fd, line, static_cast<std::size_t>(len), MSG_NOSIGNAL) == len; // one small write always fits an idle socket
+        } // end sendNext
+
+        struct ClientRun { // result of one connection count
+            long long connected; // terminals that connected
+            long long commands; // replies received
+            double connectSecs; // time spent opening connections
+            double secs; // time spent exchanging commands
+            std::vector<uint64_t> rtt; // round trip samples in nanoseconds
+        }; // end ClientRun
+
+        static ClientRun runClients(const std::string& path, long long connections, long long perClient, std::size_t customers) { // drive every terminal from one epoll loop
+            ClientRun r{ 0, 0, 0.0, 0.0, {} }; // results
+            std::vector<SimClient> clients; // terminals
+            clients.reserve(static_cast<std::size_t>(connections)); // no regrowth while epoll holds pointers
+            int ep = epoll_create1(EPOLL_CLOEXEC); // client side epoll set
+            auto t0 = std::chrono::steady_clock::now(); // connect start
+            for (long long i = 0; i < connections; ++i) { // open every terminal
+                int fd = connectTo(path); // connect
+                if (fd < 0) break; // limit reached
+                clients.push_back(SimClient{ fd, static_cast<std::size_t>(i) % customers, 0, 0, 0 }); // record it
+                epoll_event ev{}; // registration
+                ev.events = EPOLLIN; // replies
+                ev.data.ptr = &clients.back(); // client state
+                epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev); // watch it
+            } // end for
+            auto t1 = std::chrono::steady_clock::now(); // connect end
+            r.connected = static_cast<long long>(clients.size()); // terminals open
+            r.connectSecs = std::chrono::duration<double>(t1 - t0).count(); // connect time
+            r.rtt.reserve(static_cast<std::size_t>(r.connected * perClient)); // every sample
+            long long active = 0; // clients still sending
+            for (auto& c : clients) if (sendNext(c)) ++active; // every terminal starts with its sign in
+            std::vector<epoll_event> events(512); // ready list
+            char buf[4096]; // reply buffer
+            while (active > 0) { // until every script finishes
+                int n = epoll_wait(ep, events.data(), static_cast<int>(events.size()), 1000); // wait for replies
+                if (n <= 0) break; // server stalled
+                for (int i = 0; i < n; ++i) { // each ready client
+                    SimClient& c = *static_cast<SimClient*>(events[i].data.ptr); // client state
+                    ssize_t got = ::read(c.fd, buf, sizeof(buf)); // reply bytes
+                    if (got <= 0) { if (got == 0 || errno != EAGAIN) { epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr); --active; } continue; } // closed or spurious
+                    long long lines = std::count(buf, buf + got, '\n'); // whole replies, one per command
+                    if (lines == 0) continue; // partial reply
+                    r.rtt.push_back(nowNs() - c.sentAt); // round trip of the outstanding command
+                    c.answered += lines; // count replies
+                    if (c.sent >= perClient) { epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr); --active; continue; } // script done
+                    if (!sendNext(c)) { epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr); --active; } // send failed
+                } // end for
+            } // end while
+            r.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count(); // exchange time
+            for (auto& c : clients) { r.commands += c.answered; ::close(c.fd); } // totals and cleanup
+            ::close(ep); // release the epoll set
+            return r; // results
+        } // end runClients
+
+        int RunClients(std::ostream& out, int argc, char** argv) { // connection scaling against the epoll server
+            long long total = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 200000; // commands per connection count
+            long long threads = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 2; // server event loops
+            if (total <= 0) total = 200000; // guard against bad input
+            if (threads <= 0) threads = 2; // guard against bad input
+            std::vector<long long> counts; // connection counts to sweep
+            for (int i = 2; i < argc; ++i) { long long v = std::strtoll(argv[i], nullptr, 10); if (v > 0) counts.push_back(v); } // explicit counts
+            if (counts.empty()) counts = { 1, 16, 256, 2048 }; // default sweep
+
+            rlimit lim{}; // descriptor limit, each in process connection costs two
+            if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) { lim.rlim_cur = lim.rlim_max; setrlimit(RLIMIT_NOFILE, &lim); } // raise to the hard limit
+
+            const std::size_t customers = 100000; // every customer has its own card number
+            Bank bank(SyntheticCustomers(customers, 7)); // account store
+            FinanceLog fin; // history for credit commands
+            fin.set(DataGen(3).generateQuarterHistory(18, 2)); // same size as the interactive app
+            std::atomic<bool> stop(false); // server stop flag
+            ServerOptions opts; // server settings
+            opts.socketPath = "/tmp/atmbench-" + std::to_string(::getpid()) + ".sock"; // private socket
+            opts.threads = static_cast<int>(threads); // event loops
+            opts.stop = &stop; // stopped by this benchmark
+            ServerStats stats{ 0, 0 }; // server totals
+            std::thread server([&] { RunServer(opts, bank, &fin, stats, std::cerr); }); // serve in the background
+            for (int tries = 0; tries < 200 && ::access(opts.socketPath.c_str(), F_OK) != 0; ++tries) std::this_thread::sleep_for(std::chrono::milliseconds(5)); // wait for the listener
+
+            out << std::fixed << std::setprecision(0); // whole numbers
+            out << "Terminal server benchmark. " << threads << " server threads, one client thread, about " << total << " commands per row\n"; // header
+            out << std::setw(8) << "conns" << std::setw(12) << "connect us" << std::setw(14) << "commands/sec" << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(10) << "p999 us" << "\n"; // columns
+            for (long long conns : counts) { // each connection count
+                long long perClient = std::max<long long>(8, total / conns); // commands per terminal including sign in
+                ClientRun r = runClients(opts.socketPath, conns, perClient, customers); // run it
+                std::sort(r.rtt.begin(), r.rtt.end()); // order samples
+                auto pct = [&](double p) { return r.rtt.empty() ? 0.0 : static_cast<double>(r.rtt[static_cast<std::size_t>(p * static_cast<double>(r.rtt.size() - 1) + 0.5)]) / 1000.0; }; // nearest rank in microseconds
+                out << std::setw(8) << r.connected << std::setw(12) << (r.connected > 0 ? r.connectSecs * 1e6 / static_cast<double>(r.connected) : 0.0) // per connection setup
+                    << std::setw(14) << (r.secs > 0.0 ? static_cast<double>(r.commands) / r.secs : 0.0) // throughput
+                    << std::setprecision(1) << std::setw(10) << pct(0.50) << std::setw(10) << pct(0.99) << std::setw(10) << pct(0.999) << std::setprecision(0) << "\n"; // round trips
+                if (r.connected < conns) out << "  only " << r.connected << " of " << conns << " connected, raise the open file limit\n"; // descriptor limit hit
+            } // end for
+            stop.store(true); // shut the server down
+            server.join(); // wait for it
+            out << " Server totals. " << stats.connections << " connections, " << stats.commands << " commands\n"; // cross check
+            if (std::thread::hardware_concurrency() <= 1) out << " Note. one hardware thread, client and server share it\n"; // single core caveat
+            return 0; // signal success
+        } // end RunClients
+
+#else
+
+        int RunClients(std::ostream& out, int, char**) { // server mode is Linux only
+            out << "The terminal server needs Linux epoll and Unix domain sockets.\n"; // explain
+            return 1; // signal failure
+        } // end RunClients
+
+#endif
+
+    } // end bench namespace
+
+}
\ No newline at end of file
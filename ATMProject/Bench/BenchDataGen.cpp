@@ -0,0 +1,75 @@
+#include "Bench.h" // include benchmark entry points
+#include "DataGen.h" // include generator under test
+#include "Calendar.h" // include packed date helpers
+
+#include <iostream> // include stream io
+#include <sstream> // include string stream for the legacy date path
+#include <iomanip> // include formatting manipulators
+#include <ctime> // include time handling for the legacy date path
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtol for arguments
+#include <string> // include string type
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static std::string legacyDate(std::mt19937_64& rng, int monthsBack) { // per event date path used before the calendar context existed
+            std::uniform_int_distribution<int> dday(0, 27); // random day generator
+            std::time_t t = std::time(nullptr); // clock read for every event
+            std::tm tm{}; // create a tm structure
+#if defined(_WIN32)
+            localtime_s(&tm, &t); // convert time to local on Windows
+#else
+            localtime_r(&t, &tm); // convert time to local on other systems
+#endif
+            int month = tm.tm_mon + 1 - monthsBack; // step back
+            int year = tm.tm_year + 1900; // current year
+            while (month <= 0) { month += 12; --year; } // adjust year if month goes below January
+            std::ostringstream os; // string builder for formatted date
+            os << std::setfill('0') << std::setw(4) << year << "-" << std::setw(2) << month << "-" << std::setw(2) << 1 + dday(rng); // format YYYY-MM-DD
+            return os.str(); // return formatted date
+        } // end legacyDate
+
+        static std::string packedDate(std::mt19937_64& rng, const CalendarContext& cal, int monthsBack) { // per event date path with a shared calendar
+            std::uniform_int_distribution<int> dday(0, 27); // random day generator
+            std::string s(kDateTextLength, '0'); // fits the small string buffer
+            FormatDate(cal.monthStart(monthsBack) + static_cast<PackedDate>(dday(rng)), &s[0]); // day offset is plain addition
+            return s; // return formatted date
+        } // end packedDate
+
+        template <class F> static double eventsPerSecond(long long n, F&& body) { // time n iterations of body
+            auto start = std::chrono::steady_clock::now(); // start time
+            for (long long i = 0; i < n; ++i) body(i); // run workload
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // elapsed seconds
+            return secs > 0.0 ? static_cast<double>(n) / secs : 0.0; // rate
+        } // end eventsPerSecond
+
+        int RunDataGen(std::ostream& out, int argc, char** argv) { // compare date generation paths and whole event throughput
+            long long n = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 2000000; // events per measurement
+            if (n <= 0) n = 2000000; // guard against bad input
+            std::mt19937_64 rng(42); // fixed seed for repeatable work
+            std::size_t sink = 0; // keeps results observable so the work is not optimized away
+            out << std::fixed << std::setprecision(0); // whole numbers for rates
+            out << "DataGen benchmark. " << n << " events per run\n"; // header
+
+            double legacy = eventsPerSecond(n, [&](long long i) { sink += legacyDate(rng, static_cast<int>(i % 3)).size(); sink += legacyDate(rng, static_cast<int>(i % 3)).size(); }); // old path formatted two dates per event
+            out << " dates, time + localtime + ostringstream x2   " << legacy << " events/sec\n"; // before
+
+            CalendarContext cal = CalendarContext::Now(); // captured once per run
+            double packed = eventsPerSecond(n, [&](long long i) { sink += packedDate(rng, cal, static_cast<int>(i % 3)).size(); }); // new path formats one date per event
+            out << " dates, calendar context + packed date        " << packed << " events/sec\n"; // after
+            out << " speedup. " << std::setprecision(1) << (legacy > 0.0 ? packed / legacy : 0.0) << "x\n" << std::setprecision(0); // ratio
+
+            DataGen gen(42); // generator under test
+            FinEventStream events = gen.stream(cal, 1, static_cast<int>(n), 2); // one month holding all purchases
+            FinEvent e; // reusable event
+            double stream = eventsPerSecond(n, [&](long long) { if (events.next(e)) sink += e.date.size(); }); // full events including dates
+            out << " FinEventStream, full events                  " << stream << " events/sec\n"; // whole generator rate
+            out << " (checksum " << sink << ")\n"; // print sink so it stays live
+            return 0; // signal success
+        } // end RunDataGen
+
+    } // end bench namespace
+
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Bench.h" // include benchmark entry points
+#include "Format.h" // include row formatter under test
+#include "Transaction.h" // include transaction log
+#include "CardId.h" // include card ids and their display text
+#include "Finance.h" // include finance log
+#include "DataGen.h" // include history generator
+
+#include <iostream> // include stream io
+#include <sstream> // include string streams for the output check
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <string> // include string type
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        struct LegacyRow { // a transaction as it was stored before card ids, cards as display text
+            TxType type; // row kind
+            std::string fromCard; // originating card text
+            std::string toCard; // destination card text
+            double amount; // amount
+            double balanceAfter; // balance after
+            std::string timestamp; // time text
+        }; // end of LegacyRow struct
+
+        static void legacyPrint(std::ostream& out, const std::vector<LegacyRow>& rows) { // the stream formatting TransactionLog::print used before RowBuffer
+            out << "\n=== Transaction History ===\n"; // header
+            for (const auto& tx : rows) { // each row
+                out << " [" << tx.timestamp << "] "; // timestamp
+                switch (tx.type) { // row kind
+                case TxType::Deposit:  out << "Deposit $" << tx.amount << " on " << tx.fromCard; break; // deposit
+                case TxType::Withdraw: out << "Withdraw $" << tx.amount << " on " << tx.fromCard; break; // withdrawal
+                case TxType::Transfer: out << "Transfer $" << tx.amount << " from " << tx.fromCard << " to " << tx.toCard; break; // transfer
+                } // end switch
+                out << "  Balance after. $" << tx.balanceAfter << "\n"; // balance
+            } // end for
+        } // end legacyPrint
+
+        template <typename Fn> static double rowsPerSec(long long rows, int reps, Fn fn) { // best of several runs
+            double best = 0.0; // fastest rate seen
+            for (int r = 0; r < reps; ++r) { // repeat to skip cold caches
+                auto start = std::chrono::steady_clock::now(); // start time
+                fn(); // format everything
+                double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // elapsed seconds
+                if (secs > 0.0 && static_cast<double>(rows) / secs > best) best = static_cast<double>(rows) / secs; // keep the best
+            } // end for
+            return best; // rows per second
+        } // end rowsPerSec
+
+        int RunFormat(std::ostream& out, int argc, char** argv) { // statement formatting throughput
+            long long n = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 1000000; // statement rows
+            if (n <= 0) n = 1000000; // guard against bad input
+            TransactionLog log; // statement rows
+            std::vector<LegacyRow> copy; // same rows for the legacy path
+            copy.reserve(static_cast<std::size_t>(n)); // no regrowth
+            const CardId other(CardKind::Checking, 9999); // transfer destination
+            double balance = 1000.0; // running balance
+            for (long long i = 0; i < n; ++i) { // fill the log
+                CardId card(CardKind::Checking, static_cast<uint64_t>(i % 10000)); // card number
+                double amt = static_cast<double>((i * 7919) % 50000 + 1) / 100.0; // one cent to five hundred dollars
+                int kind = static_cast<int>(i % 3); // rotate kinds
+                balance += kind == 0 ? amt : -amt; // running balance
+                if (kind == 0) log.logDeposit(card, amt, balance, "2025-10-14 12:30:45"); // deposit
+                else if (kind == 1) log.logWithdraw(card, amt, balance, "2025-10-14 12:30:45"); // withdrawal
+                else log.logTransfer(card, other, amt, balance, "2025-10-14 12:30:45"); // transfer
+                copy.push_back(LegacyRow{ static_cast<TxType>(kind), CardText(card), kind == 2 ? CardText(other) : std::string(), amt, balance, "2025-10-14 12:30:45" }); // same row
+            } // end for
+
+            std::ostringstream a, b; // output check on a prefix of the rows
+            a << std::fixed << std::setprecision(2); // sessions print money this way
+            std::vector<LegacyRow> head(copy.begin(), copy.begin() + std::min<long long>(n, 1000)); // first rows
+            legacyPrint(a, head); // legacy text
+            TransactionLog headLog; // same rows through the new path
+            for (const auto& tx : head) { // rebuild, card text parsed back into ids
+                if (tx.type == TxType::Deposit) headLog.logDeposit(CardId::Parse(tx.fromCard), tx.amount, tx.balanceAfter, tx.timestamp); // deposit
+                else if (tx.type == TxType::Withdraw) headLog.logWithdraw(CardId::Parse(tx.fromCard), tx.amount, tx.balanceAfter, tx.timestamp); // withdrawal
+                else headLog.logTransfer(CardId::Parse(tx.fromCard), CardId::Parse(tx.toCard), tx.amount, tx.balanceAfter, tx.timestamp); // transfer
+            } // end for
+            headLog.print(b); // new text
+
+            DiscardBuffer sinkBuf; // output is produced and dropped
+            std::ostream sink(&sinkBuf); // stream over the discarding buffer
+            sink << std::fixed << std::setprecision(2); // same state as a session
+            double legacy = rowsPerSec(n, 3, [&] { legacyPrint(sink, copy); }); // operator<< per field
+            double rows = rowsPerSec(n, 3, [&] { log.print(sink); }); // RowBuffer
+
+            FinanceLog fin; // purchase history
+            DataGen gen(3); // history generator
+            FinEventList events; // many quarters of events
+            while (static_cast<long long>(events.size()) < n) { auto q = gen.generateQuarterHistory(18, 2); events.insert(events.end(), q.begin(), q.end()); } // fill
+            long long purchases = 0; // rows printed
+            for (const auto& e : events) if (e.kind == FinEvent::Kind::Purchase) ++purchases; // count them
+            fin.set(std::move(events)); // load
+            double fins = rowsPerSec(purchases, 3, [&] { fin.printPurchases(sink, static_cast<int>(purchases)); }); // purchase listing
+
+            out << std::fixed << std::setprecision(0); // whole numbers
+            out << "Statement formatting benchmark. " << n << " rows\n"; // header
+            out << " transactions ostream.   " << legacy << " rows/sec\n"; // before
+            out << " transactions RowBuffer. " << rows << " rows/sec\n"; // after
+            out << " purchases RowBuffer.    " << fins << " rows/sec\n"; // finance listing
+            out << " output identical.       " << (a.str() == b.str() ? "yes" : "NO") << "\n"; // byte for byte check
+            return a.str() == b.str() ? 0 : 1; // fail when the text changed
+        } // end RunFormat
+
+    } // end bench namespace
+
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "Bench.h" // include benchmark entry points
+#include "Finance.h" // include FinanceLog backends under test
+#include "FinanceFile.h" // include columnar history file for block counts
+#include "DataGen.h" // include history generator
+#include "Format.h" // include exact cent rounding for the round trip check
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include reverse
+#include <chrono> // include clocks for timing
+#include <cmath> // include fabs for the estimate check
+#include <cstdio> // include remove
+#include <cstdlib> // include strtoll for arguments
+#include <string> // include string type
+#include <vector> // include vector container
+
+#if !defined(_WIN32)
+#include <unistd.h> // include getpid for a private file name
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static double secondsSince(std::chrono::steady_clock::time_point t0) { // elapsed wall time
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); // seconds
+        } // end secondsSince
+
+        struct ScanResult { long long rows; int64_t cents; double seconds; }; // one timed walk
+
+        static ScanResult timedScan(const FinanceLog& fin, PackedDate from, PackedDate to) { // visit every row in range and sum purchases
+            ScanResult r{ 0, 0, 0.0 }; // totals
+            auto t0 = std::chrono::steady_clock::now(); // start
+            fin.forEach(from, to, [&](const FinRow& row) { ++r.rows; if (row.kind == FinEvent::Kind::Purchase) r.cents += row.cents; return true; }); // touch every row
+            r.seconds = secondsSince(t0); // elapsed
+            return r; // result
+        } // end timedScan
+
+        int RunHistory(std::ostream& out, int argc, char** argv) { // columnar history file against the in memory event list
+            long long rows = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 2000000; // events in the history
+            if (rows <= 0) rows = 2000000; // guard against bad input
+#if defined(_WIN32)
+            std::string path = argc > 1 ? argv[1] : "atmbench-history.fin"; // history file
+#else
+            std::string path = argc > 1 ? argv[1] : "/tmp/atmbench-history-" + std::to_string(::getpid()) + ".fin"; // history file
+#endif
+            DataGen gen(33); // history source
+            FinEventStream stream = gen.stream(static_cast<int>(rows / 60 + 1), 56, 4); // about sixty events per month, oldest first
+            FinEventList events; // generated history
+            events.reserve(static_cast<std::size_t>(rows)); // one allocation
+            FinEvent e; // reusable event
+            while (static_cast<long long>(events.size()) < rows && stream.next(e)) events.push_back(e); // fill
+            std::reverse(events.begin(), events.end()); // FinanceLog keeps newest first
+            PackedDate newest = 0; // most recent day, picks the range query month
+            ParseDate(events.front().date.data(), events.front().date.size(), newest); // first row
+            PackedDate first = PackDate(DateYear(newest), DateMonth(newest), 1); // range query start
+            PackedDate last = PackDate(DateYear(newest), DateMonth(newest), 31); // range query end
+
+            FinanceLog memory; // in memory backend
+            memory.set(events); // copy so the generated list survives for the check
+            std::string error; // failures
+            auto t0 = std::chrono::steady_clock::now(); // save start
+            if (!memory.save(path, error)) { out << "Save failed. " << error << "\n"; return 1; } // cannot write
+            double saveSecs = secondsSince(t0); // save time
+
+            FinanceLog mapped; // file backend
+            t0 = std::chrono::steady_clock::now(); // open start
+            bool opened = mapped.open(path, error); // map and validate only
+            double openSecs = secondsSince(t0); // open time
+            FinanceFile file; // direct view for block statistics
+            if (!opened || !file.open(path, error)) { std::remove(path.c_str()); out << "Open failed. " << error << "\n"; return 1; } // cannot map
+
+            ScanResult memAll = timedScan(memory, 0, 0xFFFFFFFFu); // every row from the list
+            ScanResult mapAll = timedScan(mapped, 0, 0xFFFFFFFFu); // every row from the file
+            ScanResult memMonth = timedScan(memory, first, last); // one month from the list
+            ScanResult mapMonth = timedScan(mapped, first, last); // one month from the file
+            std::size_t blocksRead = file.scan(first, last, [](const FinRow&, void*) { return true; }, nullptr); // blocks the range touches
+
+            t0 = std::chrono::steady_clock::now(); // estimate start
+            double memEstimate = memory.monthlySpendEstimate() + memory.monthlyIncomeEstimate(); // two passes over the list
+            double memEstSecs = secondsSince(t0); // list time
+            t0 = std::chrono::steady_clock::now(); // estimate start
+            double mapEstimate = mapped.monthlySpendEstimate() + mapped.monthlyIncomeEstimate(); // two column sums
+            double mapEstSecs = secondsSince(t0); // file time
+
+            t0 = std::chrono::steady_clock::now(); // copy out start
+            FinanceLog::Snapshot copied = mapped.all(); // owned strings for legacy callers
+            double copySecs = secondsSince(t0); // copy time
+            bool same = copied.size() == events.size(); // row count check
+            for (std::size_t i = 0; same && i < events.size(); ++i) { // every row round trips
+                const FinEvent& a = events[i]; const FinEvent& b = copied[i]; // pair
+                same = a.kind == b.kind && a.date.compare(0, 10, b.date) == 0 && a.store == b.store && a.location == b.location && a.item == b.item && ToCents(a.amount) == ToCents(b.amount); // fields
+            } // end for
+            same = same && memAll.cents == mapAll.cents && memMonth.rows == mapMonth.rows && memMonth.cents == mapMonth.cents; // scans agree
+            std::remove(path.c_str()); // delete the file
+
+            auto rate = [](long long n, double s) { return s > 0.0 ? static_cast<double>(n) / s : 0.0; }; // rows per second
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << "History file benchmark. " << rows << " events, " << static_cast<double>(file.blocks() > 0 ? file.block(0).offset : 0) / 1024.0 << " KiB of header and names, " << file.blocks() << " blocks\n"; // header
+            out << " save.          " << saveSecs * 1000.0 << " ms\n"; // write time
+            out << " open.          " << openSecs * 1000000.0 << " us, no rows parsed\n"; // zero copy load
+            out << std::setprecision(0); // whole numbers
+            out << " full scan.     list " << rate(memAll.rows, memAll.seconds) << " rows/sec, file " << rate(mapAll.rows, mapAll.seconds) << " rows/sec\n"; // every row
+            out << " one month.     list " << memMonth.seconds * 1000000.0 << " us, file " << mapMonth.seconds * 1000000.0 << " us, " << mapMonth.rows << " rows, " << blocksRead << " of " << file.blocks() << " blocks read\n"; // range query
+            out << " estimates.     list " << memEstSecs * 1000000.0 << " us, file " << mapEstSecs * 1000000.0 << " us\n"; // column sums
+            out << " copy out.      " << copySecs * 1000.0 << " ms for all()\n"; // legacy path
+            out << " round trip.    " << (same && std::fabs(memEstimate - mapEstimate) < 0.01 ? "identical" : "MISMATCH") << "\n"; // correctness
+            return same && std::fabs(memEstimate - mapEstimate) < 0.01 ? 0 : 1; // fail when the file loses data
+        } // end RunHistory
+
+    } // end bench namespace
+
+}
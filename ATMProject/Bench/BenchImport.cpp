@@ -0,0 +1,84 @@
+#include "Bench.h" // include benchmark entry points
+#include "CsvImport.h" // include statement importer under test
+#include "MappedFile.h" // include file mapping for the baseline scan
+#include "DataGen.h" // include history generator for the sample file
+
+#include <iostream> // include stream io
+#include <fstream> // include file output for the sample
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include count
+#include <chrono> // include clocks for timing
+#include <cstdio> // include remove
+#include <cstdlib> // include strtoll for arguments
+#include <string> // include string type
+#include <vector> // include vector container
+
+#if !defined(_WIN32)
+#include <unistd.h> // include getpid for a private file name
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static uint64_t writeSample(const std::string& path, long long rows) { // statement export in the shape banks produce
+            std::ofstream f(path, std::ios::binary); // sample file
+            f << "Date,Type,Amount,Merchant,City,Category\n"; // header
+            DataGen gen(21); // history source
+            FinEventStream events = gen.stream(static_cast<int>(rows / 60 + 1), 56, 4); // about sixty events per month, oldest first
+            FinEvent e; // reusable event
+            std::string line; // one CSV line
+            long long written = 0; // rows so far
+            while (written < rows && events.next(e)) { // each event
+                bool purchase = e.kind == FinEvent::Kind::Purchase; // sign and type
+                char amount[32]; // amount text
+                std::snprintf(amount, sizeof(amount), "%s%.2f", purchase ? "-" : "", e.amount); // debits negative
+                line.assign(e.date).append(purchase ? ",Purchase," : ",Paycheck,").append(amount).append(","); // fixed fields
+                if (written % 7 == 0) line.append("\"").append(e.store).append(", Inc.\""); // some quoted names with commas
+                else line.append(e.store); // plain name
+                line.append(",").append(e.location).append(",").append(e.item).append("\n"); // remaining fields
+                f.write(line.data(), static_cast<std::streamsize>(line.size())); // append
+                ++written; // count it
+            } // end while
+            return static_cast<uint64_t>(f.tellp()); // bytes written
+        } // end writeSample
+
+        int RunImport(std::ostream& out, int argc, char** argv) { // importer throughput against a plain scan of the same bytes
+            long long rows = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 5000000; // rows in the sample
+            long long threads = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 0; // workers, zero for every hardware thread
+            if (rows <= 0) rows = 5000000; // guard against bad input
+            if (threads < 0) threads = 0; // guard against bad input
+#if defined(_WIN32)
+            std::string path = argc > 2 ? argv[2] : "atmbench-import.csv"; // sample file
+#else
+            std::string path = argc > 2 ? argv[2] : "/tmp/atmbench-import-" + std::to_string(::getpid()) + ".csv"; // sample file
+#endif
+            uint64_t bytes = writeSample(path, rows); // build the sample before timing
+            double mib = static_cast<double>(bytes) / (1024.0 * 1024.0); // size in MiB
+
+            std::string error; // open failures
+            MappedFile map; // baseline mapping
+            auto t0 = std::chrono::steady_clock::now(); // baseline start
+            long long lines = map.open(path, error) ? std::count(map.data(), map.data() + map.size(), '\n') : 0; // touch every byte once
+            double scanSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); // baseline time
+            map.close(); // release
+
+            FinEventList events; // imported history
+            CsvImportStats stats{}; // import totals
+            bool ok = ImportStatementCsv(path, events, stats, error, static_cast<int>(threads)); // run the importer
+            std::remove(path.c_str()); // delete the sample
+            if (!ok) { out << "Import failed. " << error << "\n"; return 1; } // report failure
+
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << "Statement CSV import benchmark. " << stats.rows << " rows, " << mib << " MiB, " << stats.names << " distinct names\n"; // header
+            out << " newline scan.  " << (scanSecs > 0.0 ? mib / scanSecs : 0.0) << " MiB/s over " << lines << " lines\n"; // page cache speed
+            out << " import.        " << (stats.seconds > 0.0 ? mib / stats.seconds : 0.0) << " MiB/s, " << std::setprecision(0) << (stats.seconds > 0.0 ? static_cast<double>(stats.rows) / stats.seconds : 0.0) << " rows/sec\n"; // importer speed
+            if (stats.skipped) out << " skipped.       " << stats.skipped << " lines\n"; // parse failures
+            bool ordered = std::is_sorted(events.begin(), events.end(), [](const FinEvent& a, const FinEvent& b) { return a.date > b.date; }); // newest first check
+            out << " newest first.  " << (ordered ? "yes" : "NO") << "\n"; // order check
+            return ordered ? 0 : 1; // fail when the merge is wrong
+        } // end RunImport
+
+    } // end bench namespace
+
+}
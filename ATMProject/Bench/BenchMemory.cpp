@@ -0,0 +1,82 @@
+#include "Bench.h" // include benchmark entry points
+#include "MemoryUsage.h" // include memory accounting under test
+#include "Transaction.h" // include TransactionLog
+#include "Finance.h" // include FinanceLog and FinBatch
+#include "Bank.h" // include Bank and synthetic customers
+#include "DataGen.h" // include event stream
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for timing
+#include <cstdio> // include snprintf for stamp text
+#include <cstdlib> // include strtoll for arguments
+#include <memory> // include unique_ptr for the batch
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static void fillLog(TransactionLog& log, long long n) { // n session-like transactions, three per second
+            char stamp[32] = {}; // current timestamp text
+            for (long long i = 0; i < n; ++i) { // each transaction
+                if (i % 3 == 0) { long long s = i / 3, day = s / 86400, t = s % 86400; std::snprintf(stamp, sizeof(stamp), "2025-%02lld-%02lld %02lld:%02lld:%02lld", day / 28 % 12 + 1, day % 28 + 1, t / 3600, t / 60 % 60, t % 60); } // stays a valid date
+                CardId card(CardKind::Checking, static_cast<uint64_t>(i * 31 % 1000)); // customer
+                log.logDeposit(card, static_cast<double>((i * 7919) % 50000 + 1) / 100.0, 1000.0 + static_cast<double>(i % 977), stamp); // one row
+            } // end for
+        } // end fillLog
+
+        static double nsPer(std::chrono::steady_clock::time_point t0, long long reps) { return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / static_cast<double>(reps); } // average nanoseconds
+
+        int RunMemory(std::ostream& out, int argc, char** argv) { // walked footprints against counted bytes, and what a report costs
+            long long events = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 1000000; // finance events
+            long long txs = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 1000000; // transactions
+            long long customers = argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 100000; // customers
+            if (events <= 0) events = 1000000; // guard against bad input
+            if (txs <= 0) txs = 1000000; // guard against bad input
+            if (customers <= 0) customers = 100000; // guard against bad input
+
+            MemoryCounter logHeap; // exact bytes behind the transaction log
+            TransactionLog log(kTxHotRows, &logHeap); // log on the counter
+            auto t0 = std::chrono::steady_clock::now(); // counted build start
+            fillLog(log, txs); // build
+            double countedNs = nsPer(t0, txs); // per append with counting
+            TransactionLog plain; // same log on the default heap
+            t0 = std::chrono::steady_clock::now(); // plain build start
+            fillLog(plain, txs); // build
+            double plainNs = nsPer(t0, txs); // per append without counting
+
+            MemoryCounter finHeap; // exact bytes behind the finance history
+            auto batch = std::make_unique<FinBatch>(64 * 1024, &finHeap); // arena on the counter
+            DataGen gen(7); // fixed seed
+            FinEventStream stream = gen.stream(static_cast<int>(events / 60 + 1), 56, 4); // about sixty events per month
+            FinEventList& list = batch->events(); // fill in place
+            list.reserve(static_cast<std::size_t>(events) + 1); // slots up front
+            for (long long i = 0; i < events; ++i) if (!stream.next(list.emplace_back())) { list.pop_back(); break; } // generated history
+            FinanceLog fin; // versioned log
+            fin.set(std::move(batch)); // publish
+
+            Bank bank(SyntheticCustomers(static_cast<std::size_t>(customers), 11)); // account set
+
+            t0 = std::chrono::steady_clock::now(); // first report, walks the finance version
+            MemoryReport first = SnapshotMemory(bank.memoryUsage(), &log, &fin); // cold
+            double firstUs = nsPer(t0, 1) / 1000.0; // microseconds
+            const long long reps = 1000; // repeated reports
+            t0 = std::chrono::steady_clock::now(); // repeated reports, finance and accounts cached
+            for (long long i = 0; i < reps; ++i) SnapshotMemory(bank.memoryUsage(), &log, &fin); // warm
+            double warmUs = nsPer(t0, reps) / 1000.0; // microseconds
+
+            out << "Memory accounting benchmark. " << first.finance.items << " events, " << first.transactions.items << " transactions, " << first.accounts.items << " customers\n"; // header
+            PrintMemory(out, first); // the report itself
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << std::left << std::setw(15) << " structure" << std::right << std::setw(14) << "walked KiB" << std::setw(14) << "counted KiB" << std::setw(14) << "allocs walked" << std::setw(15) << "allocs counted" << "\n"; // columns
+            out << std::left << std::setw(15) << " transactions" << std::right << std::setw(14) << first.transactions.bytes() / 1024.0 << std::setw(14) << logHeap.liveBytes() / 1024.0 << std::setw(14) << first.transactions.allocations << std::setw(15) << logHeap.allocations() - logHeap.frees() << "\n"; // log against its counter
+            out << std::left << std::setw(15) << " finance" << std::right << std::setw(14) << first.finance.bytes() / 1024.0 << std::setw(14) << finHeap.liveBytes() / 1024.0 << std::setw(14) << first.finance.allocations << std::setw(15) << finHeap.allocations() - finHeap.frees() << "\n"; // arena against its counter
+            out << " report cost. first " << firstUs << " us, then " << warmUs << " us per report\n"; // production interval cost
+            out << " counting resource. " << countedNs << " ns per append counted, " << plainNs << " ns uncounted\n"; // allocation path overhead
+            return 0; // signal success
+        } // end RunMemory
+
+    } // end bench namespace
+
+}
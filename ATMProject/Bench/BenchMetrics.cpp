@@ -0,0 +1,59 @@
+#include "Bench.h" // include benchmark entry points
+#include "Metrics.h" // include instrumentation under test
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <thread> // include worker threads
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static double nsPerRecord(long long n) { // time n empty instrumented scopes on this thread
+            volatile long long work = 0; // keeps the loop body from vanishing
+            auto start = std::chrono::steady_clock::now(); // start time
+            for (long long i = 0; i < n; ++i) { // one scope per iteration
+                ScopedLatency timer(static_cast<MetricOp>(i % kMetricOps)); // the instrumentation being measured
+                work = work + 1; // trivial body
+            } // end for
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // elapsed seconds
+            return secs * 1e9 / static_cast<double>(n); // nanoseconds per scope
+        } // end nsPerRecord
+
+        static double nsPerClockPair(long long n) { // time the two clock reads every scope makes, nothing recorded
+            volatile uint64_t sink = 0; // keeps the reads from vanishing
+            auto start = std::chrono::steady_clock::now(); // start time
+            for (long long i = 0; i < n; ++i) { uint64_t t0 = MetricsTicks(); sink = sink + (MetricsTicks() - t0); } // start and stop reads
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // elapsed seconds
+            return secs * 1e9 / static_cast<double>(n); // nanoseconds per pair
+        } // end nsPerClockPair
+
+        int RunMetrics(std::ostream& out, int argc, char** argv) { // measure recording overhead single and multi threaded
+            long long n = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 20000000; // scopes per thread
+            long long threads = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : static_cast<long long>(std::thread::hardware_concurrency()); // threads for the parallel run
+            if (n <= 0) n = 20000000; // guard against bad input
+            if (threads <= 0) threads = 4; // guard against bad input
+            out << std::fixed << std::setprecision(1); // one decimal
+            nsPerRecord(n / 10); // warm up and register this thread
+            out << "Metrics overhead benchmark. " << n << " scopes per thread\n"; // header
+            double single = nsPerRecord(n); // single thread cost
+            double clocks = nsPerClockPair(n); // share of it spent reading the clock
+            out << " 1 thread.  " << single << " ns per instrumented operation, " << clocks << " ns of it the two clock reads, budget 50 ns " << (single < 50.0 ? "met" : "MISSED") << "\n"; // single thread cost
+            std::vector<double> costs(static_cast<std::size_t>(threads)); // per thread result
+            std::vector<std::thread> pool; // worker threads
+            for (long long t = 0; t < threads; ++t) pool.emplace_back([&costs, n, t] { costs[static_cast<std::size_t>(t)] = nsPerRecord(n); }); // each thread records into its own counters
+            for (auto& t : pool) t.join(); // wait
+            double worst = 0.0; // slowest thread
+            for (double c : costs) worst = c > worst ? c : worst; // find it
+            out << " " << threads << " threads. " << worst << " ns per instrumented operation (slowest thread)\n"; // contention check
+            if (static_cast<unsigned>(threads) > std::thread::hardware_concurrency()) out << " (more threads than cores, per thread time includes time slicing)\n"; // explain inflated numbers
+            PrintMetrics(out, SnapshotMetrics()); // merged view, also exercises the snapshot path
+            return 0; // signal success
+        } // end RunMetrics
+
+    } // end bench namespace
+
+}
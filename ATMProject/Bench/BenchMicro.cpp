@@ -0,0 +1,180 @@
+#include "Bench.h" // include benchmark entry points and the discarding sink
+#include "Account.h" // include account operations under test
+#include "Transaction.h" // include transaction log append paths
+#include "ShardedLog.h" // include the sharded append path
+#include "Finance.h" // include estimates and prints
+#include "DataGen.h" // include history generation
+#include "Credit.h" // include credit scoring
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <fstream> // include the JSON report file
+#include <algorithm> // include sort
+#include <chrono> // include clocks for timing
+#include <cmath> // include fabs for deviations
+#include <cstdlib> // include strtol for arguments
+#include <functional> // include function for case bodies
+#include <memory> // include shared fixtures
+#include <mutex> // include the contended account lock
+#include <string> // include string type
+#include <thread> // include contended workers
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static volatile double g_microSink = 0.0; // results land here so the work is never optimized away
+
+        struct MicroCase { // one named operation, the body performs it iters times
+            std::string name; // dotted name, stable across commits so reports can be diffed
+            std::function<void(uint64_t iters)> body; // timed work
+        }; // end of MicroCase struct
+
+        struct MicroResult { // statistics over the timed samples of one case
+            std::string name; // case name
+            uint64_t iters; // operations per sample after calibration
+            int runs; // timed samples
+            double medianNs; // median time per operation
+            double madNs; // median absolute deviation of the time per operation
+            double minNs; // fastest sample
+            double opsPerSec; // operations per second at the median
+        }; // end of MicroResult struct
+
+        static double sampleNs(const MicroCase& c, uint64_t iters) { // wall time of one sample in nanoseconds
+            auto t0 = std::chrono::steady_clock::now(); // start
+            c.body(iters); // work
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count(); // elapsed
+        } // end sampleNs
+
+        static double median(std::vector<double> v) { // middle value, mean of the middle two for even counts
+            std::sort(v.begin(), v.end()); // order
+            std::size_t n = v.size(); // count
+            return n == 0 ? 0.0 : (n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2.0); // middle
+        } // end median
+
+        static MicroResult runCase(const MicroCase& c, int runs, int warmups, double minSampleNs) { // calibrate, warm up, then time
+            uint64_t iters = 1; // operations per sample
+            for (;;) { // grow until one sample is long enough to time reliably, this also warms caches
+                double ns = sampleNs(c, iters); // try
+                if (ns >= minSampleNs || iters >= (1ull << 32)) break; // long enough
+                double scale = ns > 0.0 ? minSampleNs / ns * 1.2 : 100.0; // aim a little past the target
+                iters = static_cast<uint64_t>(static_cast<double>(iters) * std::min(100.0, std::max(2.0, scale))); // at least double, at most a hundredfold
+            } // end for
+            for (int w = 0; w < warmups; ++w) sampleNs(c, iters); // discarded runs at the final size
+            std::vector<double> per(static_cast<std::size_t>(runs)); // time per operation of each sample
+            for (auto& p : per) p = sampleNs(c, iters) / static_cast<double>(iters); // timed runs
+            MicroResult r; // result
+            r.name = c.name; r.iters = iters; r.runs = runs; // identity
+            r.medianNs = median(per); // typical cost
+            std::vector<double> dev; // distances from the median
+            for (double p : per) dev.push_back(std::fabs(p - r.medianNs)); // absolute deviations
+            r.madNs = median(dev); // robust spread
+            r.minNs = *std::min_element(per.begin(), per.end()); // best case
+            r.opsPerSec = r.medianNs > 0.0 ? 1e9 / r.medianNs : 0.0; // throughput
+            return r; // result
+        } // end runCase
+
+        static std::shared_ptr<FinanceLog> financeOfSize(std::size_t events) { // list backend with about events rows, newest first
+            auto fin = std::make_shared<FinanceLog>(); // fixture
+            if (events <= 60) { fin->set(DataGen(3).generateQuarterBatch(18, 2)); return fin; } // the interactive app's history
+            auto batch = std::make_unique<FinBatch>(); // arena for the rows
+            DataGen gen(3); // fixed seed
+            FinEventStream stream = gen.stream(static_cast<int>(events / 60), 56, 4); // sixty events per month, oldest first
+            FinEventList& list = batch->events(); // destination
+            while (stream.next(list.emplace_back())) {} // fill in place
+            list.pop_back(); // slot the exhausted stream left empty
+            std::reverse(list.begin(), list.end()); // newest first like the rest of the finance views expect
+            fin->set(std::move(batch)); // publish
+            return fin; // fixture
+        } // end financeOfSize
+
+        static std::vector<MicroCase> buildCases() { // every case, fixtures captured by the bodies
+            std::vector<MicroCase> cases; // list
+            const CardId card(CardKind::Checking, 1234), other(CardKind::Checking, 5678); // session cards
+            const std::string stamp = "2025-10-14 12:30:45"; // session time text
+
+            cases.push_back({ "account.deposit", [](uint64_t n) { Account a("Bench", "Card", 1234, 0.0); for (uint64_t i = 0; i < n; ++i) a.deposit(1.25); g_microSink = a.getBalance(); } }); // single thread
+            cases.push_back({ "account.withdraw", [](uint64_t n) { Account a("Bench", "Card", 1234, 1e15); for (uint64_t i = 0; i < n; ++i) a.withdraw(1.25); g_microSink = a.getBalance(); } }); // single thread
+            cases.push_back({ "account.transfer", [](uint64_t n) { Account a("A", "Card", 1234, 1e12), b("B", "Card", 1234, 1e12); for (uint64_t i = 0; i < n; ++i) (i & 1 ? b : a).transferTo(i & 1 ? a : b, 1.25); g_microSink = a.getBalance(); } }); // back and forth
+            cases.push_back({ "account.deposit.locked", [](uint64_t n) { Account a("Bench", "Card", 1234, 0.0); std::mutex m; for (uint64_t i = 0; i < n; ++i) { std::lock_guard<std::mutex> g(m); a.deposit(1.25); } g_microSink = a.getBalance(); } }); // per customer lock, no contention
+            unsigned hw = std::thread::hardware_concurrency(); // contended thread count
+            int threads = static_cast<int>(std::max(2u, std::min(hw, 8u))); // at least two so the lock is shared
+            cases.push_back({ "account.deposit.contended." + std::to_string(threads) + "t", [threads](uint64_t n) { // every thread on one customer
+                Account a("Bench", "Card", 1234, 0.0); std::mutex m; // shared account and its lock
+                std::vector<std::thread> pool; // workers
+                for (int t = 0; t < threads; ++t) pool.emplace_back([&, t] { for (uint64_t i = static_cast<uint64_t>(t); i < n; i += static_cast<uint64_t>(threads)) { std::lock_guard<std::mutex> g(m); a.deposit(1.25); } }); // share of n
+                for (auto& th : pool) th.join(); // wait
+                g_microSink = a.getBalance(); // observe
+            } }); // end case
+
+            auto log = std::make_shared<TransactionLog>(); // sustained log, sealing included once the ring fills
+            cases.push_back({ "txlog.deposit", [log, card, stamp](uint64_t n) { for (uint64_t i = 0; i < n; ++i) log->logDeposit(card, 1.25, 100.0, stamp); } }); // append
+            cases.push_back({ "txlog.withdraw", [log, card, stamp](uint64_t n) { for (uint64_t i = 0; i < n; ++i) log->logWithdraw(card, 1.25, 100.0, stamp); } }); // append
+            cases.push_back({ "txlog.transfer", [log, card, other, stamp](uint64_t n) { for (uint64_t i = 0; i < n; ++i) log->logTransfer(card, other, 1.25, 100.0, stamp); } }); // append
+            Transaction prebuilt(TxType::Deposit, card, CardId(), 1.25, 100.0, stamp); // merged shard entry
+            cases.push_back({ "txlog.append", [log, prebuilt](uint64_t n) { for (uint64_t i = 0; i < n; ++i) log->append(prebuilt); } }); // append
+            auto shards = std::make_shared<ShardedTxLog>(); // merged in the background
+            shards->start(); // merger running for the whole suite
+            cases.push_back({ "sharded.deposit", [shards, card](uint64_t n) { for (uint64_t i = 0; i < n; ++i) shards->logDeposit(card, 1.25, 100.0); } }); // append from one thread
+
+            for (std::size_t size : { std::size_t(60), std::size_t(6000), std::size_t(600000) }) { // several history sizes
+                auto fin = financeOfSize(size); // fixture
+                std::string suffix = "." + std::to_string(size); // size in the name
+                cases.push_back({ "finance.income" + suffix, [fin](uint64_t n) { double s = 0.0; for (uint64_t i = 0; i < n; ++i) s += fin->monthlyIncomeEstimate(); g_microSink = s; } }); // estimate
+                cases.push_back({ "finance.spend" + suffix, [fin](uint64_t n) { double s = 0.0; for (uint64_t i = 0; i < n; ++i) s += fin->monthlySpendEstimate(); g_microSink = s; } }); // estimate
+                cases.push_back({ "finance.purchases" + suffix, [fin](uint64_t n) { DiscardBuffer b; std::ostream sink(&b); for (uint64_t i = 0; i < n; ++i) fin->printPurchases(sink, 25); } }); // menu option 6
+                cases.push_back({ "finance.paychecks" + suffix, [fin](uint64_t n) { DiscardBuffer b; std::ostream sink(&b); for (uint64_t i = 0; i < n; ++i) fin->printPaychecks(sink, 25); } }); // menu option 7
+            } // end for
+
+            auto gen = std::make_shared<DataGen>(7); // one generator, as the app keeps
+            cases.push_back({ "datagen.quarter", [gen](uint64_t n) { std::size_t s = 0; for (uint64_t i = 0; i < n; ++i) s += gen->generateQuarterHistory(18, 2).size(); g_microSink = static_cast<double>(s); } }); // heap list
+            cases.push_back({ "datagen.quarter.batch", [gen](uint64_t n) { std::size_t s = 0; for (uint64_t i = 0; i < n; ++i) s += gen->generateQuarterBatch(18, 2)->events().size(); g_microSink = static_cast<double>(s); } }); // arena, as option 8 publishes
+
+            cases.push_back({ "credit.compute", [](uint64_t n) { CreditProfile c; int s = 0; for (uint64_t i = 0; i < n; ++i) { c.compute(1500.0 + static_cast<double>(i & 1023), 3200.0, 5400.0, 3100.0 + static_cast<double>(i & 255)); s += c.score(); } g_microSink = s; } }); // scoring
+            return cases; // list
+        } // end buildCases
+
+        static void writeJson(std::ostream& out, const std::vector<MicroResult>& results, int runs, int warmups) { // machine readable report for diffing runs
+            out << std::fixed << std::setprecision(3); // stable number format
+            out << "{\n  \"suite\": \"atmapp\",\n  \"runs\": " << runs << ",\n  \"warmups\": " << warmups << ",\n  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n  \"results\": [\n"; // header
+            for (std::size_t i = 0; i < results.size(); ++i) { // one object per case, names never need escaping
+                const MicroResult& r = results[i]; // case
+                out << "    { \"name\": \"" << r.name << "\", \"iterations\": " << r.iters << ", \"median_ns\": " << r.medianNs << ", \"mad_ns\": " << r.madNs << ", \"min_ns\": " << r.minNs << ", \"ops_per_sec\": " << r.opsPerSec << " }" << (i + 1 < results.size() ? "," : "") << "\n"; // fields
+            } // end for
+            out << "  ]\n}\n"; // footer
+        } // end writeJson
+
+        int RunMicro(std::ostream& out, int argc, char** argv) { // library microbenchmarks with warm-up and robust statistics
+            int runs = argc > 0 ? static_cast<int>(std::strtol(argv[0], nullptr, 10)) : 15; // timed samples per case
+            std::string filter = argc > 1 ? argv[1] : "all"; // substring of the case names to run
+            std::string jsonPath = argc > 2 ? argv[2] : ""; // report file, - for stdout
+            if (runs <= 0) runs = 15; // guard against bad input
+            const int warmups = 2; // discarded samples after calibration
+            const double minSampleNs = 20e6; // each sample lasts at least 20 ms
+
+            std::vector<MicroResult> results; // every case run
+            std::ostream& table = jsonPath == "-" ? std::cerr : out; // keep stdout clean for JSON
+            table << std::fixed; // fixed point
+            table << "Microbenchmarks. " << runs << " runs after " << warmups << " warm-ups, samples of at least " << std::setprecision(0) << minSampleNs / 1e6 << " ms\n"; // header
+            table << std::left << std::setw(34) << " case" << std::right << std::setw(12) << "median ns" << std::setw(10) << "MAD ns" << std::setw(8) << "MAD %" << std::setw(14) << "ops/sec" << "\n"; // columns
+            for (const MicroCase& c : buildCases()) { // in a fixed order
+                if (filter != "all" && c.name.find(filter) == std::string::npos) continue; // not selected
+                MicroResult r = runCase(c, runs, warmups, minSampleNs); // measure
+                table << " " << std::left << std::setw(33) << r.name << std::right << std::setprecision(1) << std::setw(12) << r.medianNs << std::setw(10) << r.madNs // time
+                      << std::setw(8) << (r.medianNs > 0.0 ? 100.0 * r.madNs / r.medianNs : 0.0) << std::setprecision(0) << std::setw(14) << r.opsPerSec << "\n"; // spread and rate
+                results.push_back(r); // keep for the report
+            } // end for
+            if (jsonPath == "-") writeJson(out, results, runs, warmups); // report on stdout
+            else if (!jsonPath.empty()) { // report file
+                std::ofstream file(jsonPath); // create
+                if (!file) { table << "Error. cannot write " << jsonPath << "\n"; return 1; } // unwritable
+                writeJson(file, results, runs, warmups); // report
+                table << " report written to " << jsonPath << "\n"; // confirm
+            } // end if
+            return results.empty() ? 1 : 0; // a filter that matches nothing is an error
+        } // end RunMicro
+
+    } // end bench namespace
+
+}
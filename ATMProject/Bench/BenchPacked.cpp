@@ -0,0 +1,106 @@
+#include "Bench.h" // include benchmark entry points
+#include "Finance.h" // include FinanceLog backends under test
+#include "PackedHistory.h" // include compressed history for direct decode timing
+#include "DataGen.h" // include history generator
+#include "Format.h" // include exact cent rounding for the round trip check
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include reverse
+#include <chrono> // include clocks for timing
+#include <cmath> // include fabs for the estimate check
+#include <cstdlib> // include strtoll for arguments
+#include <random> // include random row picks
+#include <string> // include string type
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static double elapsed(std::chrono::steady_clock::time_point t0) { // seconds since t0
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); // wall time
+        } // end elapsed
+
+        int RunPacked(std::ostream& out, int argc, char** argv) { // compressed history size, decode speed and random access
+            long long rows = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 2000000; // events in the history
+            long long probes = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 1000000; // random row lookups
+            if (rows <= 0) rows = 2000000; // guard against bad input
+            if (probes <= 0) probes = 1000000; // guard against bad input
+            DataGen gen(37); // history source
+            FinEventStream stream = gen.stream(static_cast<int>(rows / 60 + 1), 56, 4); // about sixty events per month, oldest first
+            FinEventList events; // generated history
+            events.reserve(static_cast<std::size_t>(rows)); // one allocation
+            FinEvent e; // reusable event
+            while (static_cast<long long>(events.size()) < rows && stream.next(e)) events.push_back(e); // fill
+            std::reverse(events.begin(), events.end()); // FinanceLog keeps newest first
+
+            FinanceLog fin; // log under test
+            fin.set(events); // list backend, copied so the originals survive for the check
+            std::size_t listBytes = fin.memoryBytes(); // FinEvent slots and their strings
+            double listIncome = fin.monthlyIncomeEstimate(), listSpend = fin.monthlySpendEstimate(); // reference estimates
+            auto t0 = std::chrono::steady_clock::now(); // compress start
+            fin.compress(); // re encode
+            double compressSecs = elapsed(t0); // encode time
+            std::size_t packedBytes = fin.memoryBytes(); // columns, headers and dictionary
+
+            PackedHistory packed; // direct handle for decode timing
+            for (const FinEvent& ev : events) { // same rows
+                PackedDate d = 0; // parsed date
+                ParseDate(ev.date.data(), ev.date.size(), d); // text to packed
+                packed.append(FinRow{ ev.kind, d, ToCents(ev.amount), ev.store, ev.location, ev.item }); // one row
+            } // end for
+            packed.seal(); // tail block
+
+            PackedRows block; // decoded columns
+            uint64_t check = 0; // keeps the decode from being optimized away
+            int passes = 0; // full decodes
+            t0 = std::chrono::steady_clock::now(); // decode start
+            do { // at least a quarter second of decoding
+                for (std::size_t b = 0; b < packed.blocks(); ++b) { std::size_t n = packed.decode(b, block); check += block.dates[n - 1] + static_cast<uint64_t>(block.cents[n / 2]) + block.items[0]; } // every block
+                ++passes; // one full pass
+            } while (elapsed(t0) < 0.25); // end do
+            double decodeSecs = elapsed(t0) / passes; // one pass
+            const double rowBytes = sizeof(PackedDate) + sizeof(int64_t) + 1 + 3 * sizeof(uint32_t); // decoded column bytes per row
+
+            long long scanned = 0; // rows visited
+            t0 = std::chrono::steady_clock::now(); // scan start
+            fin.forEach(0, 0xFFFFFFFFu, [&](const FinRow& r) { ++scanned; check += r.store.size(); return true; }); // rows with dictionary names
+            double scanSecs = elapsed(t0); // scan time
+
+            std::mt19937_64 rng(5); // repeatable picks
+            std::uniform_int_distribution<std::size_t> pick(0, packed.size() - 1); // row index
+            t0 = std::chrono::steady_clock::now(); // lookup start
+            for (long long i = 0; i < probes; ++i) check += static_cast<uint64_t>(packed.row(pick(rng)).cents); // one random row each
+            double probeSecs = elapsed(t0); // lookup time
+
+            t0 = std::chrono::steady_clock::now(); // estimate start
+            double income = fin.monthlyIncomeEstimate(), spend = fin.monthlySpendEstimate(); // from the skip headers
+            double estimateSecs = elapsed(t0); // estimate time
+
+            bool same = fin.size() == events.size() && packed.size() == events.size(); // row counts
+            for (std::size_t i = 0; same && i < events.size(); i += 97) { // sample rows through random access
+                FinRow r = packed.row(i); // decoded row
+                const FinEvent& a = events[i]; // original
+                same = r.kind == a.kind && DateString(r.date) == std::string_view(a.date).substr(0, kDateTextLength) && r.cents == ToCents(a.amount) && r.store == a.store && r.location == a.location && r.item == a.item; // fields
+            } // end for
+            FinanceLog::Snapshot copied = fin.all(); // full round trip through FinanceLog
+            for (std::size_t i = 0; same && i < events.size(); ++i) same = copied[i].store == events[i].store && ToCents(copied[i].amount) == ToCents(events[i].amount); // every row
+            same = same && std::fabs(income - listIncome) < 0.01 && std::fabs(spend - listSpend) < 0.01; // estimates agree
+
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << "Packed history benchmark. " << rows << " events, " << packed.blocks() << " blocks (check " << (check & 0xFF) << ")\n"; // header
+            out << " memory.        list " << static_cast<double>(listBytes) / (1024.0 * 1024.0) << " MiB, packed " << static_cast<double>(packedBytes) / (1024.0 * 1024.0) << " MiB, " << static_cast<double>(listBytes) / static_cast<double>(packedBytes) << "x smaller, " << static_cast<double>(packedBytes) * 8.0 / static_cast<double>(rows) << " bits/row\n"; // footprint
+            out << " compress.      " << compressSecs * 1000.0 << " ms\n"; // encode time
+            out << " block decode.  " << rowBytes * static_cast<double>(rows) / decodeSecs / 1e9 << " GB/s of columns, " << std::setprecision(0) << static_cast<double>(rows) / decodeSecs << " rows/sec\n"; // sequential decode
+            out << " row scan.      " << static_cast<double>(scanned) / scanSecs << " rows/sec through forEach\n"; // rows with names
+            out << std::setprecision(1); // one decimal
+            out << " random row.    " << probeSecs * 1e9 / static_cast<double>(probes) << " ns per row over " << probes << " lookups\n"; // block level random access
+            out << " estimates.     " << estimateSecs * 1e6 << " us from the skip headers\n"; // header sums
+            out << " round trip.    " << (same ? "identical" : "MISMATCH") << "\n"; // correctness
+            return same ? 0 : 1; // fail when the encoding loses data
+        } // end RunPacked
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,87 @@
+#include "Bench.h" // include benchmark entry points
+#include "CreditProjection.h" // include projection under test
+#include "Credit.h" // include the batch scoring kernel
+#include "Finance.h" // include finance log for the history
+#include "DataGen.h" // include history generator
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include sort
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <thread> // include hardware thread count
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static bool sameRows(const CreditProjection& a, const CreditProjection& b) { // identical distributions
+            if (a.months.size() != b.months.size()) return false; // different horizons
+            for (std::size_t m = 0; m < a.months.size(); ++m) { // each month
+                const ProjectionMonth& x = a.months[m]; const ProjectionMonth& y = b.months[m]; // rows
+                if (x.p10 != y.p10 || x.p25 != y.p25 || x.p50 != y.p50 || x.p75 != y.p75 || x.p90 != y.p90 || x.mean != y.mean) return false; // any difference
+            } // end for
+            return true; // same
+        } // end sameRows
+
+        static double medianMs(const ProjectionOptions& opts, const FinanceLog& fin, int runs, CreditProjection& last) { // median wall time of repeated projections
+            std::vector<double> ms; // per run
+            for (int r = 0; r < runs; ++r) { last = ProjectCredit(opts, 1250.0, 3000.0, fin); ms.push_back(last.seconds * 1000.0); } // Josh's demo balances
+            std::sort(ms.begin(), ms.end()); // order
+            return ms[ms.size() / 2]; // median
+        } // end medianMs
+
+        int RunProjection(std::ostream& out, int argc, char** argv) { // Monte Carlo credit outlook latency for one customer
+            long long paths = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 4000; // simulated futures
+            long long threads = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 0; // workers, zero for every hardware thread
+            long long runs = argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 9; // timed repetitions
+            if (paths <= 0) paths = 4000; // guard against bad input
+            if (threads < 0) threads = 0; // guard against bad input
+            if (runs <= 0) runs = 9; // guard against bad input
+
+            FinanceLog fin; // customer history
+            fin.set(DataGen(7).generateQuarterHistory(18, 2)); // the interactive app's history size
+            ProjectionOptions opts; // settings under test
+            opts.paths = static_cast<int>(paths); // futures
+            CreditProjection one, many; // results kept for the consistency check
+            opts.threads = 1; // single worker baseline
+            double oneMs = medianMs(opts, fin, static_cast<int>(runs), one); // timed
+            opts.threads = static_cast<int>(threads); // requested workers
+            double manyMs = medianMs(opts, fin, static_cast<int>(runs), many); // timed
+            unsigned hw = std::thread::hardware_concurrency(); // default worker count for the report
+
+            const std::size_t n = 1 << 20; // score kernel batch
+            std::vector<double> c(n), s(n), in(n), sp(n); // input columns
+            std::vector<int> scores(n); // output column
+            for (std::size_t i = 0; i < n; ++i) { c[i] = static_cast<double>(i % 5000) - 1000.0; s[i] = static_cast<double>(i % 12000); in[i] = static_cast<double>(i % 3000) * 1.5; sp[i] = static_cast<double>(i % 4000); } // spread of inputs
+            auto k0 = std::chrono::steady_clock::now(); // kernel start
+            CreditScores(c.data(), s.data(), in.data(), sp.data(), scores.data(), n); // whole batch
+            double kernelNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - k0).count() / static_cast<double>(n); // per score
+            CreditProfile single; // one at a time through compute
+            int mismatched = 0; // kernel and compute disagreements
+            for (std::size_t i = 0; i < n; ++i) { single.compute(c[i], s[i], in[i], sp[i]); if (single.score() != scores[i]) ++mismatched; } // spot check
+            auto k1 = std::chrono::steady_clock::now(); // scalar start
+            long long sink = 0; // keep the loop alive
+            for (std::size_t i = 0; i < n; ++i) { single.compute(c[i], s[i], in[i], sp[i]); sink += single.score(); } // one call per score
+            double scalarNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - k1).count() / static_cast<double>(n); // per score
+
+            out << std::fixed << std::setprecision(2); // two decimals
+            out << "Credit projection benchmark. " << paths << " paths x " << one.months.size() << " months, median of " << runs << " runs\n"; // header
+            out << " 1 thread.        " << std::setw(9) << oneMs << " ms  " << std::setw(8) << paths * static_cast<double>(one.months.size()) / oneMs / 1000.0 << " M path-months/s\n"; // baseline
+            unsigned workers = threads ? static_cast<unsigned>(threads) : (hw ? hw : 1); // requested workers
+            out << " " << workers << (workers == 1 ? " thread.  " : " threads. ") << "      " << std::setw(9) << manyMs << " ms  " << std::setw(8) << paths * static_cast<double>(many.months.size()) / manyMs / 1000.0 << " M path-months/s\n"; // requested workers
+            out << " score kernel.    " << std::setw(9) << kernelNs << " ns per score, compute() " << scalarNs << " ns (" << (sink ? "ok" : "") << ")\n"; // vectorized against one call at a time
+            out << " month 12. p10 " << many.months.back().p10 << "  median " << many.months.back().p50 << "  p90 " << many.months.back().p90 << ", today " << many.startScore << "\n"; // sample output
+            bool same = sameRows(one, many); // streams are per path, so thread count must not matter
+            bool agree = mismatched == 0; // kernel matches compute
+            bool fast = manyMs < 100.0; // interactive target
+            out << " same distribution for any thread count. " << (same ? "yes" : "NO") << "\n"; // determinism
+            out << " kernel matches compute. " << (agree ? "yes" : "NO") << "\n"; // formula check
+            out << " under 100 ms. " << (fast ? "yes" : "NO") << "\n"; // latency target
+            return same && agree && fast ? 0 : 1; // fail on any check
+        } // end RunProjection
+
+    } // end bench namespace
+
+}
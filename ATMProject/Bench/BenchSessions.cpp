@@ -0,0 +1,142 @@
+#include "Bench.h" // include benchmark entry points
+#include "ATM.h" // include session handlers under test
+#include "Bank.h" // include customer records and locks
+#include "Transaction.h" // include transaction log
+#include "Finance.h" // include finance log
+#include "Credit.h" // include credit profile
+#include "DataGen.h" // include history generator
+#include "Metrics.h" // include built in operation metrics
+
+#include <iostream> // include stream io
+#include <sstream> // include string streams for scripted input
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include sort
+#include <atomic> // include atomic work counter
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <random> // include script randomness
+#include <string> // include string type
+#include <thread> // include worker threads
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        struct ScriptedSession { // one terminal's worth of scripted input
+            std::size_t customer; // which customer inserts their card
+            std::string pinLine; // text answering the pin prompt
+            std::vector<int> options; // menu options in order
+            std::vector<std::string> inputs; // text consumed by each option, empty when it reads nothing
+        }; // end ScriptedSession
+
+        static const int kSignInSlot = 0; // latency slot for sign in, menu options use their own number
+        static const char* const kSlotNames[] = { "signin", "balance", "deposit", "withdraw", "transfer", "credit" }; // report labels
+        static const int kSlots = 6; // sign in plus menu options one to five
+
+        static std::vector<ScriptedSession> buildScripts(const Bank& bank, std::size_t sessions, uint64_t seed) { // make repeatable scripts
+            std::mt19937_64 rng(seed); // script randomness
+            std::uniform_int_distribution<std::size_t> dcust(0, bank.size() - 1); // any customer
+            std::uniform_int_distribution<int> dlen(5, 20); // operations per session
+            std::discrete_distribution<int> dop({ 25, 25, 20, 15, 15 }); // balance, deposit, withdraw, transfer, credit mix
+            std::uniform_int_distribution<int> dcents(100, 50000); // one to five hundred dollars
+            std::vector<ScriptedSession> scripts(sessions); // output list
+            for (auto& s : scripts) { // fill each session
+                s.customer = dcust(rng); // pick a customer
+                s.pinLine = std::to_string(SyntheticPin(s.customer)) + "\n"; // pin answer
+                int len = dlen(rng); // number of operations
+                for (int i = 0; i < len; ++i) { // pick each operation
+                    int option = dop(rng) + 1; // menu option one to five
+                    s.options.push_back(option); // record it
+                    if (option >= 2 && option <= 4) { // money options read an amount
+                        int cents = dcents(rng); // amount in cents
+                        s.inputs.push_back(std::to_string(cents / 100) + "." + std::to_string(cents % 100 / 10) + std::to_string(cents % 10) + "\n"); // amount text
+                    }
+                    else { // balance and credit read nothing
+                        s.inputs.emplace_back(); // no input
+                    }
+                } // end for
+            } // end for
+            return scripts; // return scripts
+        } // end buildScripts
+
+        static double percentile(const std::vector<uint64_t>& sorted, double p) { // nearest rank percentile of sorted samples
+            if (sorted.empty()) return 0.0; // nothing measured
+            std::size_t rank = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5); // nearest rank
+            return static_cast<double>(sorted[rank]); // sample at that rank
+        } // end percentile
+
+        int RunSessions(std::ostream& out, int argc, char** argv) { // drive scripted sessions concurrently
+            long long sessions = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 20000; // scripted sessions
+            long long threads = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : static_cast<long long>(std::thread::hardware_concurrency()); // worker threads
+            long long customers = argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 5000; // customers in the store
+            if (sessions <= 0) sessions = 20000; // guard against bad input
+            if (threads <= 0) threads = 4; // guard against bad input
+            if (customers <= 0) customers = 5000; // guard against bad input
+
+            Bank bank(SyntheticCustomers(static_cast<std::size_t>(customers), 7)); // account store shared by every worker
+            std::vector<ScriptedSession> scripts = buildScripts(bank, static_cast<std::size_t>(sessions), 11); // scripts built before timing
+            FinanceLog fin; // history shared read only by every session
+            fin.set(DataGen(3).generateQuarterHistory(18, 2)); // same history size as the interactive app
+
+            std::vector<std::vector<std::vector<uint64_t>>> samples(static_cast<std::size_t>(threads), std::vector<std::vector<uint64_t>>(kSlots)); // latency samples per worker per slot
+            std::atomic<std::size_t> nextSession{ 0 }; // work queue cursor
+            std::atomic<long long> failedSignIns{ 0 }; // sign ins that were rejected
+
+            auto worker = [&](std::size_t id) { // one pool thread
+                DiscardBuffer sinkBuf; // output is formatted and dropped
+                std::ostream sink(&sinkBuf); // stream over the discarding buffer
+                sink << std::fixed << std::setprecision(2); // same formatting as RunSession
+                TransactionLog log; // per worker log so workers never share one
+                CreditProfile credit; // per worker credit scratch
+                auto& mine = samples[id]; // this worker's samples
+                while (true) { // pull sessions until none are left
+                    std::size_t i = nextSession.fetch_add(1, std::memory_order_relaxed); // claim a session
+                    if (i >= scripts.size()) break; // queue drained
+                    const ScriptedSession& s = scripts[i]; // script to run
+                    std::lock_guard<std::mutex> card(bank.lockFor(s.customer)); // card is in use for the whole session
+                    Customer& c = bank.at(s.customer); // account pair
+                    std::istringstream pin(s.pinLine); // pin prompt input
+                    auto t0 = std::chrono::steady_clock::now(); // start sign in
+                    bool ok = SignIn(pin, sink, c.checking); // authenticate
+                    auto t1 = std::chrono::steady_clock::now(); // end sign in
+                    mine[kSignInSlot].push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count())); // record
+                    if (!ok) { failedSignIns.fetch_add(1, std::memory_order_relaxed); continue; } // skip rejected sessions
+                    for (std::size_t k = 0; k < s.options.size(); ++k) { // run each option
+                        std::istringstream in(s.inputs[k]); // option input
+                        auto a = std::chrono::steady_clock::now(); // start option
+                        DoMenuOption(s.options[k], in, sink, c.checking, c.savings, &log, &fin, &credit); // same dispatch as RunSession
+                        auto b = std::chrono::steady_clock::now(); // end option
+                        mine[s.options[k]].push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count())); // record
+                    } // end for
+                } // end while
+            }; // end worker
+
+            auto start = std::chrono::steady_clock::now(); // wall clock start
+            std::vector<std::thread> pool; // worker threads
+            for (long long t = 0; t < threads; ++t) pool.emplace_back(worker, static_cast<std::size_t>(t)); // start workers
+            for (auto& t : pool) t.join(); // wait for all sessions
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // wall time
+
+            out << "Session load benchmark. " << sessions << " sessions, " << threads << " threads, " << customers << " customers\n"; // header
+            long long totalOps = 0; // operations across every slot
+            out << std::left << std::setw(10) << " option" << std::right << std::setw(10) << "count" << std::setw(12) << "p50 ns" << std::setw(12) << "p99 ns" << std::setw(12) << "p999 ns" << "\n"; // table header
+            for (int slot = 0; slot < kSlots; ++slot) { // merge and report each slot
+                std::vector<uint64_t> merged; // samples from every worker
+                for (const auto& w : samples) merged.insert(merged.end(), w[slot].begin(), w[slot].end()); // merge
+                std::sort(merged.begin(), merged.end()); // order for percentiles
+                totalOps += static_cast<long long>(merged.size()); // count operations
+                out << std::left << std::setw(10) << (std::string(" ") + kSlotNames[slot]) << std::right << std::setw(10) << merged.size() // slot name and count
+                    << std::setw(12) << std::fixed << std::setprecision(0) << percentile(merged, 0.50) // median
+                    << std::setw(12) << percentile(merged, 0.99) // tail
+                    << std::setw(12) << percentile(merged, 0.999) << "\n"; // far tail
+            } // end for
+            out << " failed sign ins. " << failedSignIns.load() << "\n"; // rejected sessions
+            out << " operations/sec. " << (secs > 0.0 ? static_cast<double>(totalOps) / secs : 0.0) << "  (" << std::setprecision(3) << secs << " s)\n"; // throughput
+            PrintMetrics(out, SnapshotMetrics()); // handler side view from the built in instrumentation
+            return 0; // signal success
+        } // end RunSessions
+
+    } // end bench namespace
+
+}
\ No newline at end of file
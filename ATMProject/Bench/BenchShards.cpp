@@ -0,0 +1,123 @@
+#include "Bench.h" // include benchmark entry points
+#include "ShardedLog.h" // include sharded log under test
+#include "Transaction.h" // include the single locked log baseline
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <atomic> // include the stall flag and counters
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <ctime> // include time and strftime for stamps
+#include <mutex> // include the baseline lock
+#include <string> // include string type
+#include <thread> // include worker threads
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        struct StampCache { // wall clock text, rebuilt once per second like a batch session
+            std::time_t second = 0; // cached second
+            std::string text; // cached text
+            const std::string& now() { // current stamp
+                std::time_t t = std::time(nullptr); // current second
+                if (t != second || text.empty()) { // new second
+                    std::tm tm{}; // local time
+#if defined(_WIN32)
+                    localtime_s(&tm, &t); // convert on Windows
+#else
+                    localtime_r(&t, &tm); // convert elsewhere
+#endif
+                    char buf[32]; // text
+                    text.assign(buf, std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm)); // session format
+                    second = t; // remember
+                } // end if
+                return text; // stamp
+            } // end now
+        }; // end of StampCache struct
+
+        template <typename Append> static double runThreads(int threads, long long perThread, Append append) { // appends per second across threads
+            auto t0 = std::chrono::steady_clock::now(); // start
+            std::vector<std::thread> pool; // workers
+            for (int t = 0; t < threads; ++t) pool.emplace_back([&, t] { // one worker
+                CardId card(CardKind::Checking, static_cast<uint64_t>(t)); // this worker's card
+                StampCache stamp; // per thread stamp cache
+                for (long long i = 0; i < perThread; ++i) append(card, static_cast<double>(i % 50000 + 1) / 100.0, stamp.now()); // append
+            }); // end worker
+            for (auto& th : pool) th.join(); // wait
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); // elapsed
+            return secs > 0.0 ? static_cast<double>(perThread) * threads / secs : 0.0; // appends per second
+        } // end runThreads
+
+        static bool orderedHistory(ShardedTxLog& log, uint64_t& seen) { // timestamps never go backwards, counts the entries
+            bool ordered = true; // verdict
+            std::string prev; // previous stamp
+            seen = 0; // merged entries
+            log.forEach([&](const Transaction& tx) { ordered = ordered && std::string_view(prev) <= tx.timestamp; prev.assign(tx.timestamp); ++seen; return true; }); // walk the history
+            return ordered; // result
+        } // end orderedHistory
+
+        static bool runStalled(int threads, std::ostream& out) { // a session stamps its work, stalls across a second boundary, then logs it
+            ShardedTxLog log; // log under test
+            log.start(); // background merger
+            std::atomic<bool> stalledDone{ false }; // the paused writer has appended
+            std::atomic<uint64_t> total{ 0 }; // appends across writers
+            std::vector<std::thread> pool; // writers
+            for (int t = 0; t < threads; ++t) pool.emplace_back([&, t] { // one writer
+                CardId card(CardKind::Checking, static_cast<uint64_t>(t)); // this writer's card
+                StampCache stamp; // stamp taken before the append, the way BatchSession does
+                uint64_t n = 0; // this writer's appends
+                if (t == 0) { // the paused writer
+                    stamp.now(); // stamp taken, then the thread is descheduled
+                    std::this_thread::sleep_until(std::chrono::system_clock::from_time_t(std::time(nullptr) + 1) + std::chrono::milliseconds(20)); // past the next second
+                    log.logDeposit(card, 1.0, 100.0); // append after newer entries were merged
+                    ++n; // counted
+                    stalledDone.store(true); // let the others finish
+                } else { // busy writers
+                    for (; !stalledDone.load(std::memory_order_relaxed) || n < 1000; ++n) { stamp.now(); log.logDeposit(card, static_cast<double>(n % 50000 + 1) / 100.0, 100.0); } // keep appending across the boundary
+                } // end if
+                total.fetch_add(n); // running total
+            }); // end writer
+            for (auto& th : pool) th.join(); // wait
+            log.stop(); // merge the rest
+            uint64_t seen = 0; // merged entries
+            bool ordered = orderedHistory(log, seen); // stamps in order
+            bool complete = seen == total.load() && log.appended() == seen; // nothing lost
+            out << " stalled.  stamp taken before a pause across a second boundary, " << seen << " entries, " << (complete ? "all merged" : "LOST") << ", " << (ordered ? "ordered" : "NOT ORDERED") << "\n"; // one row
+            return ordered && complete; // verdict
+        } // end runStalled
+
+        int RunShards(std::ostream& out, int argc, char** argv) { // single locked log against per thread shards
+            long long perThread = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 1000000; // appends per thread
+            if (perThread <= 0) perThread = 1000000; // guard against bad input
+            std::vector<int> counts; // thread counts to try
+            for (int i = 1; i < argc; ++i) { long long v = std::strtoll(argv[i], nullptr, 10); if (v > 0) counts.push_back(static_cast<int>(v)); } // from the command line
+            if (counts.empty()) { unsigned hw = std::thread::hardware_concurrency(); counts = { 1, 2, 4 }; if (hw > 4) counts.push_back(static_cast<int>(hw)); } // defaults
+            out << std::fixed << std::setprecision(0); // whole numbers
+            out << "Sharded transaction log benchmark. " << perThread << " appends per thread\n"; // header
+            out << "  threads   locked log/sec   sharded/sec   merged   ordered\n"; // columns
+            bool allGood = true; // order and count checks
+            for (int threads : counts) { // each thread count
+                TransactionLog locked; // baseline, one vector behind one mutex
+                std::mutex lock; // global lock every session would take
+                double base = runThreads(threads, perThread, [&](CardId card, double amt, const std::string& ts) { std::lock_guard<std::mutex> guard(lock); locked.logDeposit(card, amt, 100.0, ts); }); // locked appends
+
+                ShardedTxLog sharded; // log under test
+                sharded.start(); // background merger
+                double shardRate = runThreads(threads, perThread, [&](CardId card, double amt, const std::string&) { sharded.logDeposit(card, amt, 100.0); }); // sharded appends, the log stamps them itself
+                sharded.stop(); // merge the rest
+                uint64_t seen = 0; // merged entries
+                bool ordered = orderedHistory(sharded, seen); // timestamps never go backwards
+                bool complete = seen == static_cast<uint64_t>(perThread) * threads && sharded.appended() == seen; // nothing lost
+                allGood = allGood && ordered && complete; // running verdict
+                out << "  " << std::setw(7) << threads << "  " << std::setw(15) << base << "  " << std::setw(12) << shardRate << "  " << std::setw(7) << (complete ? "all" : "LOST") << "   " << (ordered ? "yes" : "NO") << "\n"; // one row
+            } // end for
+            allGood = runStalled(counts.back() > 1 ? counts.back() : 2, out) && allGood; // regression case for stamps taken before the append
+            if (std::thread::hardware_concurrency() <= 1) out << " Note. one hardware thread, the merger shares it with the writers and the locked log never contends\n"; // caveat for single core runs
+            return allGood ? 0 : 1; // fail on a lost or misordered entry
+        } // end RunShards
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,118 @@
+#include "Bench.h" // include benchmark entry points
+#include "Finance.h" // include versioned finance log under test
+#include "Format.h" // include exact cent rounding for the baseline sums
+#include "DataGen.h" // include history generator
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include sort
+#include <atomic> // include run flags and counters
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <shared_mutex> // include the reader writer lock baseline
+#include <string> // include string type
+#include <thread> // include reader and writer threads
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        struct HistorySums { int64_t purchases = 0; int64_t paychecks = 0; std::size_t rows = 0; }; // what one read computes
+
+        static bool operator==(const HistorySums& a, const HistorySums& b) { return a.purchases == b.purchases && a.paychecks == b.paychecks && a.rows == b.rows; } // same history
+
+        static HistorySums sumsOf(const FinEventList& events) { // expected result for one history
+            HistorySums s; // totals
+            for (const auto& e : events) { (e.kind == FinEvent::Kind::Purchase ? s.purchases : s.paychecks) += ToCents(e.amount); ++s.rows; } // add each event
+            return s; // totals
+        } // end sumsOf
+
+        struct PhaseResult { double p50 = 0.0, p99 = 0.0, p999 = 0.0; long long torn = 0; long long published = 0; }; // one measured phase
+
+        template <typename Read, typename Write> static PhaseResult runPhase(int readers, long long reads, bool writing, const HistorySums& a, const HistorySums& b, Read read, Write write) { // readers against an optional writer
+            std::vector<std::vector<uint64_t>> samples(static_cast<std::size_t>(readers)); // latency per reader
+            std::atomic<long long> torn{ 0 }; // reads that saw neither history
+            std::atomic<int> running{ readers }; // readers still going
+            std::atomic<long long> published{ 0 }; // versions the writer installed
+            std::thread writer; // regenerating thread
+            if (writing) writer = std::thread([&] { // publish back to back while readers run
+                for (bool flip = false; running.load(std::memory_order_acquire) > 0; flip = !flip) { write(flip); published.fetch_add(1, std::memory_order_relaxed); } // alternate histories
+            }); // end writer
+            std::vector<std::thread> pool; // reader threads
+            for (int t = 0; t < readers; ++t) pool.emplace_back([&, t] { // one reader
+                auto& mine = samples[static_cast<std::size_t>(t)]; // this reader's samples
+                mine.reserve(static_cast<std::size_t>(reads)); // no growth while timing
+                long long bad = 0; // reads that mixed two histories
+                for (long long i = 0; i < reads; ++i) { // timed reads
+                    auto t0 = std::chrono::steady_clock::now(); // start
+                    HistorySums s = read(); // whole history in one read
+                    auto t1 = std::chrono::steady_clock::now(); // end
+                    mine.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count())); // record
+                    if (!(s == a) && !(s == b)) ++bad; // a torn read
+                } // end for
+                torn.fetch_add(bad, std::memory_order_relaxed); // report
+                running.fetch_sub(1, std::memory_order_release); // done
+            }); // end reader
+            for (auto& th : pool) th.join(); // wait for readers
+            if (writer.joinable()) writer.join(); // then the writer
+            std::vector<uint64_t> merged; // every sample
+            for (const auto& s : samples) merged.insert(merged.end(), s.begin(), s.end()); // merge
+            std::sort(merged.begin(), merged.end()); // order for percentiles
+            auto at = [&](double p) { return merged.empty() ? 0.0 : static_cast<double>(merged[static_cast<std::size_t>(p * static_cast<double>(merged.size() - 1) + 0.5)]); }; // nearest rank
+            PhaseResult r; // result
+            r.p50 = at(0.50); r.p99 = at(0.99); r.p999 = at(0.999); // percentiles
+            r.torn = torn.load(); r.published = published.load(); // counts
+            return r; // result
+        } // end runPhase
+
+        static void report(std::ostream& out, const char* label, const PhaseResult& r) { // one table row
+            out << " " << std::left << std::setw(26) << label << std::right << std::setw(10) << r.p50 << std::setw(10) << r.p99 << std::setw(10) << r.p999 << std::setw(12) << r.published << std::setw(8) << r.torn << "\n"; // latencies and counts
+        } // end report
+
+        int RunSnapshots(std::ostream& out, int argc, char** argv) { // reader latency while the history is regenerated
+            long long reads = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 200000; // reads per reader
+            long long readers = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 2; // reader threads
+            long long perMonth = argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 18; // purchases per month, 18 is the interactive app
+            if (reads <= 0) reads = 200000; // guard against bad input
+            if (readers <= 0) readers = 2; // guard against bad input
+            if (perMonth <= 0) perMonth = 18; // guard against bad input
+
+            const FinEventList histA = DataGen(3).generateQuarterHistory(static_cast<int>(perMonth), 2); // first history
+            const FinEventList histB = DataGen(4).generateQuarterHistory(static_cast<int>(perMonth), 2); // the history it is swapped with
+            HistorySums a = sumsOf(histA), b = sumsOf(histB); // what a consistent read returns
+
+            FinanceLog fin; // versioned log under test
+            fin.set(histA); // first version
+            auto snapshotRead = [&] { HistorySums s; fin.forEach(0, 0xFFFFFFFFu, [&](const FinRow& r) { (r.kind == FinEvent::Kind::Purchase ? s.purchases : s.paychecks) += r.cents; ++s.rows; return true; }); return s; }; // one pinned version
+            auto snapshotWrite = [&](bool flip) { fin.set(flip ? histB : histA); }; // copy built outside, then one pointer swap
+
+            FinanceLog locked; // baseline, the same log behind a reader writer lock as it would need without versions
+            locked.set(histA); // first history
+            std::shared_mutex lock; // readers share, the writer excludes them while it replaces the history
+            auto lockedRead = [&] { std::shared_lock<std::shared_mutex> guard(lock); HistorySums s; locked.forEach(0, 0xFFFFFFFFu, [&](const FinRow& r) { (r.kind == FinEvent::Kind::Purchase ? s.purchases : s.paychecks) += r.cents; ++s.rows; return true; }); return s; }; // same walk under the lock
+            auto lockedWrite = [&](bool flip) { std::unique_lock<std::shared_mutex> guard(lock); locked.set(flip ? histB : histA); }; // copy and publish with readers shut out
+
+            out << std::fixed << std::setprecision(0); // whole numbers
+            out << "Finance snapshot benchmark. " << readers << " readers x " << reads << " full history reads, " << a.rows << " events per history\n"; // header
+            out << std::left << std::setw(27) << " phase" << std::right << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(10) << "p999 ns" << std::setw(12) << "published" << std::setw(8) << "torn" << "\n"; // columns
+            PhaseResult quiet = runPhase(static_cast<int>(readers), reads, false, a, b, snapshotRead, snapshotWrite); // no writer
+            PhaseResult busy = runPhase(static_cast<int>(readers), reads, true, a, b, snapshotRead, snapshotWrite); // writer publishing continuously
+            PhaseResult lockQuiet = runPhase(static_cast<int>(readers), reads, false, a, b, lockedRead, lockedWrite); // baseline without a writer
+            PhaseResult lockBusy = runPhase(static_cast<int>(readers), reads, true, a, b, lockedRead, lockedWrite); // baseline with a writer
+            report(out, "snapshots, quiet", quiet); // row
+            report(out, "snapshots, regenerating", busy); // row
+            report(out, "shared lock, quiet", lockQuiet); // row
+            report(out, "shared lock, regenerating", lockBusy); // row
+            std::size_t held = fin.retiredVersions(); // versions a preempted reader was still pinning when the writer stopped
+            fin.set(histA); // one more publish with no reader pinned
+            out << " retired versions. " << held << " held when the readers finished, " << fin.retiredVersions() << " after the next publish\n"; // reclamation check
+            if (std::thread::hardware_concurrency() <= 1) out << " Note. one hardware thread, the writer is time sliced with the readers so tails include its quanta\n"; // caveat for single core runs
+            bool ok = quiet.torn == 0 && busy.torn == 0; // every snapshot read saw exactly one version
+            out << " consistent reads. " << (ok ? "yes" : "NO") << "\n"; // correctness
+            return ok ? 0 : 1; // fail on a torn read
+        } // end RunSnapshots
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,74 @@
+#include "Bench.h" // include benchmark entry points
+#include "Statement.h" // include statement job under test
+#include "Bank.h" // include customer records
+#include "Transaction.h" // include transaction log
+#include "Finance.h" // include finance log
+#include "DataGen.h" // include history generator
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <cstdlib> // include strtoll for arguments
+#include <filesystem> // include remove_all for cleanup
+#include <random> // include activity randomness
+#include <string> // include string type
+
+#if !defined(_WIN32)
+#include <unistd.h> // include getpid for a private directory
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static void report(std::ostream& out, const char* label, const StatementStats& s) { // one result row
+            out << " " << label << ". " << s.customers << " statements, " << s.bytes / (1024 * 1024) << " MiB, " // volume
+                << (s.seconds > 0.0 ? static_cast<double>(s.customers) / s.seconds : 0.0) << " statements/sec, " // throughput
+                << "render " << s.renderSeconds << " s, files " << s.writeSeconds << " s summed over workers"; // where the time went
+            if (s.failed) out << ", " << s.failed << " failed"; // write errors
+            out << "\n"; // end row
+        } // end report
+
+        int RunStatements(std::ostream& out, int argc, char** argv) { // statement job throughput
+            long long customers = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 100000; // customers
+            long long threads = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 0; // workers, zero for every hardware thread
+            if (customers <= 0) customers = 100000; // guard against bad input
+            if (threads < 0) threads = 0; // guard against bad input
+#if defined(_WIN32)
+            std::string dir = argc > 2 ? argv[2] : "atmbench-statements"; // output directory
+#else
+            std::string dir = argc > 2 ? argv[2] : "/tmp/atmbench-statements-" + std::to_string(::getpid()); // output directory
+#endif
+
+            Bank bank(SyntheticCustomers(static_cast<std::size_t>(customers), 7)); // account store
+            FinanceLog fin; // shared purchase and paycheck history
+            fin.set(DataGen(3).generateQuarterHistory(18, 2)); // same size as the interactive app
+            TransactionLog log; // month activity
+            PackedDate month = CalendarContext::Now().monthStart(0); // statement month
+            std::string stamp = DateString(month) + " 12:00:00"; // timestamp inside the month
+            std::mt19937_64 rng(9); // activity randomness
+            for (long long i = 0; i < customers * 2; ++i) { // two transactions per customer on average
+                const Customer& c = bank.at(static_cast<std::size_t>(rng() % static_cast<uint64_t>(customers))); // any customer
+                double amt = static_cast<double>(rng() % 50000 + 100) / 100.0; // one to five hundred dollars
+                switch (rng() % 3) { // kind
+                case 0: log.logDeposit(c.checking.id(), amt, c.checking.getBalance(), stamp); break; // deposit
+                case 1: log.logWithdraw(c.checking.id(), amt, c.checking.getBalance(), stamp); break; // withdrawal
+                default: log.logTransfer(c.checking.id(), c.savings.id(), amt, c.checking.getBalance(), stamp); break; // transfer
+                } // end switch
+            } // end for
+
+            StatementOptions opts; // job settings
+            opts.threads = static_cast<int>(threads); // workers
+            opts.month = month; // statement month
+            out << std::fixed << std::setprecision(2); // two decimals
+            out << "Statement job benchmark. " << customers << " customers\n"; // header
+            report(out, "render only", WriteStatements(opts, bank, &log, &fin)); // CPU cost without files
+            opts.dir = dir; // now write files
+            report(out, "render and write", WriteStatements(opts, bank, &log, &fin)); // full job
+            std::error_code ec; // cleanup errors are ignored
+            std::filesystem::remove_all(dir, ec); // remove the statements
+            return 0; // signal success
+        } // end RunStatements
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,77 @@
+#include "Bench.h" // include benchmark entry points
+#include "PinThrottle.h" // include the attempt table under test
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <atomic> // include shared counters
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <mutex> // include the locked baseline
+#include <thread> // include session threads
+#include <unordered_map> // include the locked baseline table
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        class LockedThrottle { // the obvious shared table, one mutex around a hash map
+        public: // same calls as PinThrottle
+            bool beginAttempt(CardId card) { std::lock_guard<std::mutex> guard(m_lock); int& n = m_counts[card.bits()]; if (n >= 3) return false; ++n; return true; } // reserve
+            void succeeded(CardId card) { std::lock_guard<std::mutex> guard(m_lock); m_counts[card.bits()] = 0; } // clear
+
+        private: // internal data
+            std::mutex m_lock; // guards m_counts
+            std::unordered_map<uint64_t, int> m_counts; // failures per card
+        }; // end of LockedThrottle class
+
+        template <typename Body> static double nsPerCheck(int threads, long long checks, Body body) { // run body(thread, i) on every thread, average ns per call
+            std::vector<std::thread> pool; // session threads
+            std::atomic<int> ready{ 0 }; // start together
+            auto t0 = std::chrono::steady_clock::now(); // start
+            for (int t = 0; t < threads; ++t) pool.emplace_back([&, t] { ready.fetch_add(1); while (ready.load() < threads) std::this_thread::yield(); for (long long i = 0; i < checks; ++i) body(t, i); }); // one session stream
+            for (auto& th : pool) th.join(); // wait
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / static_cast<double>(checks * threads); // per call, across threads
+        } // end nsPerCheck
+
+        int RunThrottle(std::ostream& out, int argc, char** argv) { // sign in checks per second and lockout under contention
+            long long threads = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 4; // concurrent sessions
+            long long checks = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 2000000; // sign ins per thread
+            if (threads <= 0 || threads > 4096) threads = 4; // guard against bad input
+            if (checks <= 0) checks = 2000000; // guard against bad input
+            const int t = static_cast<int>(threads); // thread count
+            const uint32_t now = PinThrottle::Now(); // one bucket for the whole run
+            auto cardOf = [](int thread, long long i) { return CardId(CardKind::Checking, static_cast<uint64_t>(thread) * 1000003ull + static_cast<uint64_t>(i % 20000)); }; // twenty thousand cards per thread
+
+            PinThrottle table; // table under test
+            double goodNs = nsPerCheck(t, checks, [&](int th, long long i) { CardId c = cardOf(th, i); if (table.beginAttempt(c, now)) table.succeeded(c, now); }); // correct pin every time
+            double checkNs = nsPerCheck(t, checks, [&](int th, long long i) { if (table.failures(cardOf(th, i), now) > 99) std::abort(); }); // read only check
+            LockedThrottle locked; // baseline
+            double lockedNs = nsPerCheck(t, checks, [&](int th, long long i) { CardId c = cardOf(th, i); if (locked.beginAttempt(c)) locked.succeeded(c); }); // same pattern under one lock
+
+            PinThrottle attack; // fresh table for the lockout check
+            const int cards = 64; // cards under attack
+            std::atomic<long long> allowed{ 0 }; // attempts that got through
+            nsPerCheck(t, checks / 10 + cards, [&](int, long long i) { if (attack.beginAttempt(CardId(CardKind::Checking, 9000 + static_cast<uint64_t>(i % cards)), now)) allowed.fetch_add(1, std::memory_order_relaxed); }); // wrong pin every time from every thread
+            long long expected = static_cast<long long>(cards) * attack.maxFailures(); // exact limit within one bucket
+            bool decays = attack.attemptsLeft(CardId(CardKind::Checking, 9000), now + 300) > 0; // one quiet bucket later
+            PinThrottle edge(1024, 3, 300); // lockout reached just before a multiple of the bucket
+            CardId edgeCard(CardKind::Checking, 77); // card under attack
+            const uint32_t lockedAt = (now / 300 + 1) * 300 - 1; // one second before the boundary
+            for (int i = 0; i < 3; ++i) edge.beginAttempt(edgeCard, lockedAt); // three wrong pins
+            bool holds = edge.attemptsLeft(edgeCard, lockedAt + 2) == 0 && edge.attemptsLeft(edgeCard, lockedAt + 299) == 0 && edge.attemptsLeft(edgeCard, lockedAt + 300) > 0; // a full bucket from the last failure
+
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << "PIN throttle benchmark. " << threads << " threads x " << checks << " sign ins, " << table.memoryBytes() / 1024 << " KiB table\n"; // header
+            out << " lock free, sign in        " << std::setw(8) << goodNs << " ns per check\n"; // attempt plus clear
+            out << " lock free, read only      " << std::setw(8) << checkNs << " ns per check\n"; // failures lookup
+            out << " mutex and map, sign in    " << std::setw(8) << lockedNs << " ns per check\n"; // baseline
+            out << " lockout. " << allowed.load() << " wrong pins allowed across " << threads << " threads on " << cards << " cards, limit " << expected << "\n"; // contention check
+            out << " decay. " << (decays ? "attempts back after one bucket" : "STILL LOCKED") << ", " << (holds ? "a lockout just before a bucket boundary holds a full bucket" : "LOCKOUT LIFTED EARLY") << "\n"; // lockout lifts, and not early
+            if (std::thread::hardware_concurrency() <= 1) out << " Note. one hardware thread, threads are time sliced so the mutex is rarely contended\n"; // caveat for single core runs
+            return allowed.load() == expected && decays && holds ? 0 : 1; // fail when the limit leaks
+        } // end RunThrottle
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,128 @@
+#include "Bench.h" // include benchmark entry points
+#include "Timeline.h" // include the radix sort and the loser tree under test
+#include "Calendar.h" // include packed timestamps and their text
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include stable_sort
+#include <chrono> // include clocks for timing
+#include <cstdlib> // include strtoll for arguments
+#include <functional> // include greater for the min heap
+#include <queue> // include priority_queue for the heap baseline
+#include <string> // include string type
+#include <utility> // include pair
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        static uint64_t nextRandom(uint64_t& s) { // SplitMix64 step
+            uint64_t z = (s += 0x9E3779B97F4A7C15ull); // advance
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull; // mix
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull; // mix
+            return z ^ (z >> 31); // output
+        } // end nextRandom
+
+        static PackedTime randomTime(uint64_t& s) { // any second of one quarter, coarse enough that customers share seconds
+            uint64_t r = nextRandom(s); // one draw
+            int month = 7 + static_cast<int>(r % 3); // July to September
+            int day = 1 + static_cast<int>((r >> 8) % 28); // day of month
+            int second = static_cast<int>((r >> 16) % 86400) / 60 * 60; // whole minutes
+            return PackTime(PackDate(2025, month, day), second); // packed
+        } // end randomTime
+
+        static uint64_t mixEntry(uint64_t h, const TimelineEntry& e) { // order sensitive checksum of a stream
+            return (h ^ (e.time * 31 + e.customer * 7 + e.row)) * 0x100000001B3ull; // FNV style step
+        } // end mixEntry
+
+        static double msSince(std::chrono::steady_clock::time_point t0) { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count(); } // elapsed milliseconds
+
+        int RunTimeline(std::ostream& out, int argc, char** argv) { // per customer sorting and the bank wide merge
+            long long customers = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 50000; // histories
+            long long perCustomer = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 96; // rows per history, about a quarter of events
+            if (customers <= 0) customers = 50000; // guard against bad input
+            if (perCustomer <= 0) perCustomer = 96; // guard against bad input
+            const std::size_t n = static_cast<std::size_t>(perCustomer); // rows per history
+
+            std::vector<TimedRow> rows(static_cast<std::size_t>(customers) * n); // every history back to back
+            std::vector<std::pair<std::string, uint32_t>> texts(n); // one history as stamp text, the old representation
+            std::vector<TimedRow> scratch; // radix scratch reused across customers
+            double textMs = 0.0, parseMs = 0.0, radixMs = 0.0; // sort phase timings
+            bool sameOrder = true; // radix order matches stable_sort on text
+            uint64_t seed = 45; // fixed data
+            char buf[kTimeTextLength]; // stamp text
+            for (long long c = 0; c < customers; ++c) { // each customer
+                for (std::size_t i = 0; i < n; ++i) { FormatTime(randomTime(seed), buf); texts[i] = { std::string(buf, kTimeTextLength), static_cast<uint32_t>(i) }; } // unsorted history
+                std::vector<std::pair<std::string, uint32_t>> byText = texts; // copy for the baseline
+                auto t0 = std::chrono::steady_clock::now(); // baseline start
+                std::stable_sort(byText.begin(), byText.end(), [](const auto& a, const auto& b) { return a.first < b.first; }); // string compare per step
+                textMs += msSince(t0); // baseline time
+                TimedRow* mine = rows.data() + static_cast<std::size_t>(c) * n; // this customer's rows
+                t0 = std::chrono::steady_clock::now(); // parse start
+                for (std::size_t i = 0; i < n; ++i) { ParseTime(texts[i].first.data(), texts[i].first.size(), mine[i].time); mine[i].row = texts[i].second; } // pack once
+                parseMs += msSince(t0); // parse time
+                if (scratch.size() < n) scratch.resize(n); // sized once
+                t0 = std::chrono::steady_clock::now(); // radix start
+                RadixSortByKey(mine, scratch.data(), n, [](const TimedRow& r) { return r.time; }); // the SortHistory kernel on the shared buffer
+                radixMs += msSince(t0); // radix time
+                for (std::size_t i = 0; i < n; ++i) sameOrder = sameOrder && mine[i].row == byText[i].second; // both stable, so identical
+            } // end for
+
+            const std::size_t total = rows.size(); // rows in the timeline
+            std::vector<HistorySpan> spans(static_cast<std::size_t>(customers)); // one span per customer
+            for (std::size_t c = 0; c < spans.size(); ++c) spans[c] = { rows.data() + c * n, rows.data() + (c + 1) * n }; // sorted histories
+
+            auto t0 = std::chrono::steady_clock::now(); // loser tree start
+            TimelineMerge merge(spans); // build
+            uint64_t treeSum = 0; // stream checksum
+            bool ordered = true; // nondecreasing time, customer order on ties
+            TimelineEntry last{ 0, 0, 0 }; // previous row
+            uint64_t streamed = merge.forEach([&](const TimelineEntry& e) { ordered = ordered && (last.time < e.time || (last.time == e.time && last.customer <= e.customer)); last = e; treeSum = mixEntry(treeSum, e); return true; }); // consume
+            double treeMs = msSince(t0); // loser tree time
+
+            t0 = std::chrono::steady_clock::now(); // heap baseline start
+            using Head = std::pair<PackedTime, uint32_t>; // time and customer
+            std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap; // min heap of customer heads
+            std::vector<HistorySpan> cursors = spans; // remaining rows per customer
+            for (uint32_t c = 0; c < cursors.size(); ++c) if (cursors[c].begin != cursors[c].end) heap.push({ cursors[c].begin->time, c }); // first rows
+            uint64_t heapSum = 0; // stream checksum
+            while (!heap.empty()) { // drain
+                Head h = heap.top(); heap.pop(); // earliest
+                HistorySpan& run = cursors[h.second]; // its history
+                heapSum = mixEntry(heapSum, TimelineEntry{ h.first, h.second, run.begin->row }); // same stream
+                if (++run.begin != run.end) heap.push({ run.begin->time, h.second }); // next row of that customer
+            } // end while
+            double heapMs = msSince(t0); // heap time
+
+            t0 = std::chrono::steady_clock::now(); // materialized baseline start
+            std::vector<TimelineEntry> all; // whole timeline in memory
+            all.reserve(total); // one allocation
+            for (uint32_t c = 0; c < spans.size(); ++c) for (const TimedRow* r = spans[c].begin; r != spans[c].end; ++r) all.push_back(TimelineEntry{ r->time, c, r->row }); // customer order
+            std::vector<TimelineEntry> allScratch(total); // radix scratch
+            RadixSortByKey(all.data(), allScratch.data(), total, [](const TimelineEntry& e) { return e.time; }); // stable, so customer order on ties
+            uint64_t flatSum = 0; // stream checksum
+            for (const auto& e : all) flatSum = mixEntry(flatSum, e); // consume
+            double flatMs = msSince(t0); // materialized time
+            std::size_t flatBytes = (all.capacity() + allScratch.capacity()) * sizeof(TimelineEntry); // what it held
+
+            double mrows = static_cast<double>(total) / 1e6; // millions of rows
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << "Timeline benchmark. " << customers << " customers x " << perCustomer << " rows, " << total << " rows\n"; // header
+            out << std::left << std::setw(31) << " phase" << std::right << std::setw(10) << "ms" << std::setw(12) << "Mrows/s" << std::setw(12) << "state MiB" << "\n"; // columns
+            auto row = [&](const char* label, double ms, double mib) { out << " " << std::left << std::setw(30) << label << std::right << std::setw(10) << ms << std::setw(12) << (ms > 0.0 ? mrows / (ms / 1000.0) : 0.0) << std::setw(12) << mib << "\n"; }; // one table row
+            const double mib = 1024.0 * 1024.0; // bytes per MiB
+            row("stable_sort on stamp text", textMs, 0.0); // baseline
+            row("parse to packed time", parseMs, 0.0); // one time conversion
+            row("radix sort on packed time", radixMs, static_cast<double>(scratch.capacity() * sizeof(TimedRow)) / mib); // per customer sort
+            row("loser tree stream", treeMs, static_cast<double>(merge.memoryBytes()) / mib); // streaming merge
+            row("binary heap stream", heapMs, static_cast<double>(cursors.capacity() * sizeof(HistorySpan) + spans.size() * sizeof(Head)) / mib); // baseline merge
+            row("materialize and radix sort", flatMs, static_cast<double>(flatBytes) / mib); // whole timeline in memory
+            bool ok = sameOrder && ordered && streamed == total && treeSum == heapSum && treeSum == flatSum; // every method agrees
+            out << " same order as stable_sort. " << (sameOrder ? "yes" : "NO") << ", timeline ordered. " << (ordered ? "yes" : "NO") << ", streams agree. " << (treeSum == heapSum && treeSum == flatSum ? "yes" : "NO") << "\n"; // correctness
+            return ok ? 0 : 1; // fail on any disagreement
+        } // end RunTimeline
+
+    } // end bench namespace
+
+}
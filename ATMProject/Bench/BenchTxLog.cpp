@@ -0,0 +1,99 @@
+#include "Bench.h" // include benchmark entry points
+#include "Transaction.h" // include tiered transaction log under test
+#include "Format.h" // include exact cent rounding for the round trip check
+
+#include <iostream> // include stream io
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for timing
+#include <cstdio> // include snprintf for stamp text
+#include <cstdlib> // include strtoll for arguments
+#include <string> // include string type
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    namespace bench { // begin bench namespace
+
+        struct TxSource { // repeatable stream of session-like transactions, a few per second
+            std::vector<CardId> cards; // card ids
+            std::string stamp; // current timestamp text
+            long long second = -1; // second the stamp was built for
+
+            TxSource() { // a thousand customers
+                for (int i = 0; i < 1000; ++i) cards.emplace_back(CardKind::Checking, static_cast<uint64_t>(i)); // cards
+            } // end constructor
+
+            const std::string& stampFor(long long i) { // three transactions per second from 2025-01-01
+                long long s = i / 3; // second
+                if (s != second) { // new second
+                    long long day = s / 86400, t = s % 86400; // day and time of day
+                    char buf[32]; // text
+                    std::snprintf(buf, sizeof(buf), "2025-%02lld-%02lld %02lld:%02lld:%02lld", day / 28 % 12 + 1, day % 28 + 1, t / 3600, t / 60 % 60, t % 60); // stays a valid date
+                    stamp.assign(buf); second = s; // cache
+                } // end if
+                return stamp; // text
+            } // end stampFor
+
+            static double amount(long long i) { return static_cast<double>((i * 7919) % 50000 + 1) / 100.0; } // one cent to five hundred dollars
+        }; // end of TxSource struct
+
+        static void logOne(TransactionLog& log, TxSource& src, long long i) { // append transaction i
+            CardId card = src.cards[static_cast<std::size_t>(i * 31 % 1000)]; // customer
+            double amt = TxSource::amount(i); // amount
+            double balance = 1000.0 + static_cast<double>(i % 977); // balance after
+            switch (i % 3) { // rotate kinds
+            case 0: log.logDeposit(card, amt, balance, src.stampFor(i)); break; // deposit
+            case 1: log.logWithdraw(card, amt, balance, src.stampFor(i)); break; // withdrawal
+            default: log.logTransfer(card, src.cards[static_cast<std::size_t>((i + 1) * 31 % 1000)], amt, balance, src.stampFor(i)); break; // transfer
+            } // end switch
+        } // end logOne
+
+        int RunTxLog(std::ostream& out, int argc, char** argv) { // sustained logging against the tiered log
+            long long n = argc > 0 ? std::strtoll(argv[0], nullptr, 10) : 4000000; // transactions
+            if (n <= 0) n = 4000000; // guard against bad input
+            TransactionLog log; // log under test
+            TxSource src; // transaction source
+            out << std::fixed << std::setprecision(1); // one decimal
+            out << "Tiered transaction log benchmark. " << n << " transactions, ring of " << kTxHotRows << "\n"; // header
+            auto t0 = std::chrono::steady_clock::now(); // append start
+            double appendSecs = 0.0; // time inside the log
+            for (int quarter = 1; quarter <= 4; ++quarter) { // report memory as the log grows
+                long long end = n * quarter / 4; // rows by the end of this quarter
+                auto q0 = std::chrono::steady_clock::now(); // quarter start
+                for (long long i = n * (quarter - 1) / 4; i < end; ++i) logOne(log, src, i); // append
+                appendSecs += std::chrono::duration<double>(std::chrono::steady_clock::now() - q0).count(); // quarter time
+                double flat = static_cast<double>(end) * (sizeof(Transaction) + 20.0); // a plain vector of Transaction, stamp strings on the heap
+                out << " " << std::setw(9) << end << " rows.  " << static_cast<double>(log.memoryBytes()) / (1024.0 * 1024.0) << " MiB, " << log.segments() << " segments, a flat vector would need about " << flat / (1024.0 * 1024.0) << " MiB\n"; // footprint
+            } // end for
+            double totalSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); // wall time
+
+            DiscardBuffer sinkBuf; // output is produced and dropped
+            std::ostream sink(&sinkBuf); // stream over the discarding buffer
+            auto r0 = std::chrono::steady_clock::now(); // recent print start
+            for (int i = 0; i < 1000; ++i) log.printRecent(sink, 20); // last twenty, as a screen would show
+            double recentUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - r0).count() / 1000.0; // per call
+
+            long long seen = 0; // rows visited
+            bool same = true; // round trip check
+            TxSource check; // same stream again
+            auto s0 = std::chrono::steady_clock::now(); // scan start
+            log.forEach([&](const Transaction& tx) { // every row, oldest first
+                long long i = seen++; // row index
+                same = same && tx.type == static_cast<TxType>(i % 3) && tx.fromCard == check.cards[static_cast<std::size_t>(i * 31 % 1000)] && ToCents(tx.amount) == ToCents(TxSource::amount(i)) && std::string_view(tx.timestamp) == check.stampFor(i); // fields
+                return true; // keep going
+            }); // end forEach
+            double scanSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - s0).count(); // scan time
+            same = same && seen == n; // nothing lost
+
+            out << std::setprecision(0); // whole numbers
+            out << " append.        " << static_cast<double>(n) / appendSecs << " rows/sec including sealing, " << std::setprecision(2) << totalSecs << " s total\n"; // append speed
+            out << " recent 20.     " << recentUs << " us per screen from the ring\n"; // hot tier display
+            out << std::setprecision(0); // whole numbers
+            out << " full history.  " << static_cast<double>(seen) / scanSecs << " rows/sec decoded oldest first\n"; // cold and hot scan
+            out << " round trip.    " << (same ? "identical" : "MISMATCH") << "\n"; // correctness
+            return same ? 0 : 1; // fail when the segments lose data
+        } // end RunTxLog
+
+    } // end bench namespace
+
+}
@@ -0,0 +1,49 @@
+#include "Bench.h" // include benchmark entry points
+
+#include <iostream> // include stream io
+#include <cstring> // include strcmp for command matching
+
+using namespace atmapp; // use the atmapp namespace for brevity
+
+struct BenchCommand { // one runnable benchmark
+    const char* name; // command line name
+    const char* summary; // one line description for usage text
+    int (*run)(std::ostream& out, int argc, char** argv); // entry point receiving the remaining arguments
+}; // end of BenchCommand
+
+static const BenchCommand kCommands[] = { // every benchmark this tool knows
+    { "alloc", "[entries] allocation counts and build and drop time for FinEvent and Transaction lists on the heap, a pool and an arena", bench::RunAlloc },
+    { "batch", "[commands] [customers] batch protocol throughput through RunBatch", bench::RunBatch },
+    { "cards", "[cards] [lookups] perfect hash card directory build and probe time against unordered_map<string>, plus the Bank lookups", bench::RunCards },
+    { "clients", "[commands] [server threads] [connections...] connection scaling against the socket server", bench::RunClients },
+    { "datagen", "events/sec for date and FinEvent generation", bench::RunDataGen },
+    { "format", "[rows] statement and purchase formatting rows/sec", bench::RunFormat },
+    { "history", "[rows] [path] mapped history file save, open, scans and range queries", bench::RunHistory },
+    { "import", "[rows] [threads] [path] statement CSV import against a plain newline scan", bench::RunImport },
+    { "memory", "[events] [transactions] [customers] memory report accuracy against counting resources, report cost and counting overhead", bench::RunMemory },
+    { "metrics", "[scopes] [threads] overhead of ScopedLatency per operation", bench::RunMetrics },
+    { "micro", "[runs] [case filter] [json file or -] Account, TransactionLog, FinanceLog, DataGen and CreditProfile microbenchmarks with warm-up, median, MAD and ops/sec", bench::RunMicro },
+    { "packed", "[rows] [lookups] compressed history footprint, block decode GB/s and random row access", bench::RunPacked },
+    { "projection", "[paths] [threads] [runs] Monte Carlo credit outlook for one customer, one thread against many, and the vectorized scoring kernel", bench::RunProjection },
+    { "sessions", "[sessions] [threads] [customers] scripted RunSession load with latency percentiles", bench::RunSessions },
+    { "shards", "[appends per thread] [threads...] per thread log shards with background merge against one locked log", bench::RunShards },
+    { "snapshots", "[reads per reader] [readers] [purchases per month] FinanceLog reader latency while the history is regenerated, against a reader writer lock", bench::RunSnapshots },
+    { "statements", "[customers] [threads] [dir] monthly statement job, render only and with files", bench::RunStatements },
+    { "throttle", "[threads] [sign ins per thread] shared PIN attempt table check cost against a mutex and map, exact lockout under contention and decay", bench::RunThrottle },
+    { "timeline", "[customers] [rows per customer] radix sort of packed timestamps against stable_sort on text, loser tree timeline against a binary heap and a materialized sort", bench::RunTimeline },
+    { "txlog", "[transactions] tiered transaction log memory under sustained load, recent display and full history scan", bench::RunTxLog },
+};
+
+static void usage(std::ostream& out) { // list available benchmarks
+    out << "Usage. ATMBench <benchmark> [options]\n"; // command shape
+    for (const auto& c : kCommands) out << "  " << c.name << "  " << c.summary << "\n"; // one row per benchmark
+} // end usage
+
+int main(int argc, char** argv) { // program entry point
+    if (argc < 2) { usage(std::cout); return 1; } // nothing to run
+    for (const auto& c : kCommands) { // find the requested benchmark
+        if (std::strcmp(argv[1], c.name) == 0) return c.run(std::cout, argc - 2, argv + 2); // run it with its own arguments
+    } // end for
+    usage(std::cout); // unknown benchmark
+    return 1; // signal failure
+}
@@ -0,0 +1,84 @@
+#include "Calendar.h" // include header for packed date helpers
+#include <ctime> // include time handling functions
+
+namespace atmapp { // begin atmapp namespace
+
+    static void putDigits(char* out, int value, int width) { // write a zero padded number right to left
+        for (int i = width - 1; i >= 0; --i) { out[i] = static_cast<char>('0' + value % 10); value /= 10; } // one digit per position
+    } // end putDigits
+
+    void FormatDate(PackedDate d, char* out) { // write YYYY-MM-DD without touching streams
+        putDigits(out, DateYear(d), 4); // year
+        out[4] = '-'; // separator
+        putDigits(out + 5, DateMonth(d), 2); // month
+        out[7] = '-'; // separator
+        putDigits(out + 8, DateDay(d), 2); // day
+    } // end FormatDate
+
+    std::string DateString(PackedDate d) { // format into a new string
+        char buf[kDateTextLength]; // fixed size scratch space
+        FormatDate(d, buf); // fill digits
+        return std::string(buf, kDateTextLength); // short enough for the small string buffer
+    } // end DateString
+
+    bool ParseDate(const char* text, std::size_t len, PackedDate& out) { // read YYYY-MM-DD
+        if (len < kDateTextLength || text[4] != '-' || text[7] != '-') return false; // wrong shape
+        int fields[3] = { 0, 0, 0 }; // year, month, day
+        const int starts[3] = { 0, 5, 8 }; // field offsets
+        const int widths[3] = { 4, 2, 2 }; // field widths
+        for (int f = 0; f < 3; ++f) { // parse each field
+            for (int i = 0; i < widths[f]; ++i) { // parse each digit
+                char c = text[starts[f] + i]; // current character
+                if (c < '0' || c > '9') return false; // not a digit
+                fields[f] = fields[f] * 10 + (c - '0'); // accumulate
+            } // end for
+        } // end for
+        if (fields[1] < 1 || fields[1] > 12 || fields[2] < 1 || fields[2] > 31) return false; // out of range
+        out = PackDate(fields[0], fields[1], fields[2]); // pack result
+        return true; // parsed
+    } // end ParseDate
+
+    void FormatTime(PackedTime t, char* out) { // write YYYY-MM-DD HH:MM:SS
+        FormatDate(TimeDate(t), out); // day part
+        int s = TimeSecond(t); // second of the day
+        out[10] = ' '; // separator
+        putDigits(out + 11, s / 3600, 2); // hours
+        out[13] = ':'; // separator
+        putDigits(out + 14, s / 60 % 60, 2); // minutes
+        out[16] = ':'; // separator
+        putDigits(out + 17, s % 60, 2); // seconds
+    } // end FormatTime
+
+    bool ParseTime(const char* text, std::size_t len, PackedTime& out) { // read YYYY-MM-DD HH:MM:SS
+        PackedDate d = 0; // day part
+        if (len < kTimeTextLength || text[10] != ' ' || text[13] != ':' || text[16] != ':' || !ParseDate(text, kDateTextLength, d)) return false; // wrong shape
+        int fields[3] = { 0, 0, 0 }; // hours, minutes, seconds
+        for (int f = 0; f < 3; ++f) { // parse each field
+            for (int i = 0; i < 2; ++i) { // two digits
+                char c = text[11 + f * 3 + i]; // current character
+                if (c < '0' || c > '9') return false; // not a digit
+                fields[f] = fields[f] * 10 + (c - '0'); // accumulate
+            } // end for
+        } // end for
+        if (fields[0] > 23 || fields[1] > 59 || fields[2] > 59) return false; // out of range
+        out = PackTime(d, fields[0] * 3600 + fields[1] * 60 + fields[2]); // pack result
+        return true; // parsed
+    } // end ParseTime
+
+    CalendarContext CalendarContext::Now() { // capture the local month
+        std::time_t t = std::time(nullptr); // current time in seconds
+        std::tm tm{}; // create a tm structure
+#if defined(_WIN32)
+        localtime_s(&tm, &t); // convert time to local on Windows
+#else
+        localtime_r(&t, &tm); // convert time to local on other systems
+#endif
+        return CalendarContext{ tm.tm_year + 1900, tm.tm_mon + 1 }; // keep year and month only
+    } // end Now
+
+    PackedDate CalendarContext::monthStart(int monthsBack) const { // walk back whole months
+        int total = year * 12 + (month - 1) - monthsBack; // months since year zero
+        return PackDate(total / 12, total % 12 + 1, 1); // split back into year and month
+    } // end monthStart
+
+}
\ No newline at end of file
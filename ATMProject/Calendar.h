@@ -0,0 +1,47 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <cstdint> // include fixed width integer types
+#include <cstddef> // include size_t
+#include <string> // include string for convenience formatting
+
+namespace atmapp { // begin atmapp namespace
+
+    using PackedDate = uint32_t; // calendar day packed as year << 9 | month << 5 | day, orders like the YYYY-MM-DD text
+
+    inline PackedDate PackDate(int year, int month, int day) { // combine calendar fields into one integer
+        return (static_cast<uint32_t>(year) << 9) | (static_cast<uint32_t>(month) << 5) | static_cast<uint32_t>(day); // shift fields into place
+    } // end PackDate
+
+    inline int DateYear(PackedDate d) { return static_cast<int>(d >> 9); } // extract the year
+    inline int DateMonth(PackedDate d) { return static_cast<int>((d >> 5) & 0xF); } // extract the month
+    inline int DateDay(PackedDate d) { return static_cast<int>(d & 0x1F); } // extract the day of month
+
+    inline int MonthSpan(PackedDate first, PackedDate last) { // calendar months touched by [first, last], one when there are no dates
+        if (last == 0 || first > last) return 1; // nothing dated
+        return (DateYear(last) - DateYear(first)) * 12 + DateMonth(last) - DateMonth(first) + 1; // three for a generated quarter
+    } // end MonthSpan
+
+    const std::size_t kDateTextLength = 10; // characters in YYYY-MM-DD
+
+    void FormatDate(PackedDate d, char* out); // write exactly kDateTextLength characters, no terminator
+    std::string DateString(PackedDate d); // format into a new string
+    bool ParseDate(const char* text, std::size_t len, PackedDate& out); // read YYYY-MM-DD, return false when malformed
+
+    using PackedTime = uint64_t; // calendar second packed as PackedDate << 17 | second of day, orders like the YYYY-MM-DD HH:MM:SS text
+
+    inline PackedTime PackTime(PackedDate d, int secondOfDay) { return (static_cast<uint64_t>(d) << 17) | static_cast<uint64_t>(secondOfDay); } // 86400 seconds fit in 17 bits
+    inline PackedDate TimeDate(PackedTime t) { return static_cast<PackedDate>(t >> 17); } // extract the day
+    inline int TimeSecond(PackedTime t) { return static_cast<int>(t & 0x1FFFF); } // extract the second of the day
+
+    const std::size_t kTimeTextLength = 19; // characters in YYYY-MM-DD HH:MM:SS
+
+    void FormatTime(PackedTime t, char* out); // write exactly kTimeTextLength characters, no terminator
+    bool ParseTime(const char* text, std::size_t len, PackedTime& out); // read YYYY-MM-DD HH:MM:SS, return false when malformed
+
+    struct CalendarContext { // local calendar month captured once per generation run
+        int year; // current year
+        int month; // current month 1 to 12
+        static CalendarContext Now(); // read the clock and time zone once
+        PackedDate monthStart(int monthsBack) const; // first day of the month monthsBack months before the current one
+    }; // end of CalendarContext struct
+
+}
\ No newline at end of file
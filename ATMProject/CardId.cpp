@@ -0,0 +1,99 @@
+#include "CardId.h" // include header for card ids and the directory
+#include <algorithm> // include sort and unique
+#include <climits> // include INT32_MAX for the seed search
+#include <cstring> // include memcpy for the display text
+
+namespace atmapp { // begin atmapp namespace
+
+    static const std::string_view kCardPrefixes[] = { "", "Card. ", "Savings. " }; // display prefix per CardKind
+    static const std::string_view kCardMask = "**** **** **** "; // hidden digits
+
+    bool ParseCardDigits(std::string_view digits, uint64_t& number) { // decimal digits only
+        if (digits.empty() || digits.size() > 18) return false; // nothing, or too long to pack with the kind
+        uint64_t v = 0; // accumulated value
+        for (char c : digits) { if (c < '0' || c > '9') return false; v = v * 10 + static_cast<uint64_t>(c - '0'); } // digits only
+        number = v; // result
+        return true; // parsed
+    } // end ParseCardDigits
+
+    CardId CardId::Parse(std::string_view display) { // display text to id
+        CardKind kind = CardKind::None; // unknown until the prefix matches
+        if (display.substr(0, 5) == "Card.") kind = CardKind::Checking; // checking card
+        else if (display.substr(0, 8) == "Savings.") kind = CardKind::Savings; // savings card
+        else return CardId(); // not a card
+        std::size_t space = display.find_last_of(' '); // digits follow the last blank
+        uint64_t number = 0; // card digits
+        if (space == std::string_view::npos || !ParseCardDigits(display.substr(space + 1), number)) return CardId(); // no digits
+        return CardId(kind, number); // packed id
+    } // end Parse
+
+    std::size_t FormatCard(CardId id, char* out) { // masked display text
+        if (id.empty()) return 0; // nothing to show
+        std::string_view prefix = kCardPrefixes[static_cast<int>(id.kind()) % 3]; // kind label
+        std::memcpy(out, prefix.data(), prefix.size()); // label
+        std::memcpy(out + prefix.size(), kCardMask.data(), kCardMask.size()); // hidden digits
+        char* p = out + prefix.size() + kCardMask.size(); // last four digits
+        uint64_t last = id.number() % 10000; // visible part
+        for (int i = 3; i >= 0; --i) { p[i] = static_cast<char>('0' + last % 10); last /= 10; } // zero padded
+        return prefix.size() + kCardMask.size() + 4; // text length
+    } // end FormatCard
+
+    std::string CardText(CardId id) { // format into a new string
+        char buf[kCardTextMax]; // fixed size scratch space
+        return std::string(buf, FormatCard(id, buf)); // copy the text
+    } // end CardText
+
+    CardDirectory::CardDirectory(const std::vector<std::pair<CardId, uint32_t>>& entries) { // build the perfect hash
+        std::vector<std::pair<uint64_t, uint32_t>> keys; // distinct cards with their values
+        keys.reserve(entries.size()); // one per entry at most
+        for (const auto& e : entries) if (!e.first.empty()) keys.emplace_back(e.first.bits(), e.second); // empty ids are never looked up
+        std::stable_sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) { return a.first < b.first; }); // repeats side by side, still in entry order
+        keys.erase(std::unique(keys.begin(), keys.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), keys.end()); // keep the first of each card
+        const std::size_t n = keys.size(); // table size, one slot per card
+        if (n == 0) return; // nothing to index
+        const std::size_t buckets = (n + 1) / 2; // about two keys per bucket
+
+        std::vector<uint64_t> hashes(n); // hash per key
+        std::vector<uint32_t> start(buckets + 1, 0); // first key of each bucket in the grouped order
+        for (std::size_t i = 0; i < n; ++i) { hashes[i] = mixBits(keys[i].first); ++start[fastRange(hashes[i], buckets) + 1]; } // bucket sizes
+        for (std::size_t b = 0; b < buckets; ++b) start[b + 1] += start[b]; // prefix sums
+        std::vector<uint32_t> grouped(n); // key indices grouped by bucket
+        std::vector<uint32_t> fill(start.begin(), start.end() - 1); // next free position per bucket
+        for (std::size_t i = 0; i < n; ++i) grouped[fill[fastRange(hashes[i], buckets)]++] = static_cast<uint32_t>(i); // place each key
+        std::vector<uint32_t> order(buckets); // buckets, largest first
+        for (std::size_t b = 0; b < buckets; ++b) order[b] = static_cast<uint32_t>(b); // identity
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return start[a + 1] - start[a] > start[b + 1] - start[b]; }); // hardest buckets while the table is empty
+
+        m_seeds.assign(buckets, 0); // empty buckets keep seed zero, their probes miss on the key compare
+        m_keys.assign(n, 0); // slot keys
+        m_values.assign(n, 0); // slot values
+        std::vector<uint8_t> used(n, 0); // taken slots
+        std::vector<std::size_t> slots; // slots one seed would use
+        std::size_t nextFree = 0; // scan position for single key buckets
+        for (uint32_t b : order) { // each bucket
+            uint32_t size = start[b + 1] - start[b]; // keys in it
+            if (size == 0) break; // the rest are empty
+            if (size == 1) { // no seed needed, take the next free slot
+                while (used[nextFree]) ++nextFree; // a free slot always remains, every key has one
+                uint32_t k = grouped[start[b]]; // the key
+                used[nextFree] = 1; m_keys[nextFree] = keys[k].first; m_values[nextFree] = keys[k].second; // store
+                m_seeds[b] = ~static_cast<int32_t>(nextFree); // negative seed names the slot
+                continue; // next bucket
+            } // end if
+            for (int32_t seed = 1; seed < INT32_MAX; ++seed) { // search for a seed that spreads the bucket over free slots
+                slots.clear(); // candidate slots
+                bool ok = true; // every key fits so far
+                for (uint32_t j = start[b]; j < start[b + 1] && ok; ++j) { // each key
+                    std::size_t s = fastRange(mixBits(hashes[grouped[j]] + static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull), n); // slot under this seed
+                    ok = !used[s] && std::find(slots.begin(), slots.end(), s) == slots.end(); // free and not shared within the bucket
+                    slots.push_back(s); // remember
+                } // end for
+                if (!ok) continue; // try the next seed
+                for (uint32_t j = 0; j < size; ++j) { uint32_t k = grouped[start[b] + j]; used[slots[j]] = 1; m_keys[slots[j]] = keys[k].first; m_values[slots[j]] = keys[k].second; } // store the bucket
+                m_seeds[b] = seed; // remember the seed
+                break; // next bucket
+            } // end for
+        } // end for
+    } // end constructor
+
+}
@@ -0,0 +1,71 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <cstdint> // include fixed width integer types
+#include <cstddef> // include size_t
+#include <string> // include string for convenience formatting
+#include <string_view> // include string_view for parsing display text
+#include <utility> // include pair for directory entries
+#include <vector> // include vector for the directory tables
+
+namespace atmapp { // begin atmapp namespace
+
+    enum class CardKind : uint8_t { None = 0, Checking = 1, Savings = 2 }; // account a card draws on, None marks an empty id
+
+    class CardId { // card number and kind in one 64-bit word, compared and copied as an integer
+    public: // public interface
+        constexpr CardId() : m_bits(0) {} // empty id, no card
+        constexpr CardId(CardKind kind, uint64_t number) : m_bits(number << 2 | static_cast<uint64_t>(kind)) {} // pack kind into the low bits
+        static constexpr CardId FromBits(uint64_t bits) { CardId id; id.m_bits = bits; return id; } // rebuild from bits()
+        static CardId Parse(std::string_view display); // read "Card. **** **** **** 4242" or "Savings. ..." text, empty id when malformed
+
+        constexpr CardKind kind() const { return static_cast<CardKind>(m_bits & 3); } // checking, savings or none
+        constexpr uint64_t number() const { return m_bits >> 2; } // card digits
+        constexpr uint64_t bits() const { return m_bits; } // whole id, small for short numbers so it varints well
+        constexpr bool empty() const { return m_bits == 0; } // no card
+        constexpr bool operator==(CardId o) const { return m_bits == o.m_bits; } // same card
+        constexpr bool operator!=(CardId o) const { return m_bits != o.m_bits; } // different card
+        constexpr bool operator<(CardId o) const { return m_bits < o.m_bits; } // any strict order, for sorting
+
+    private: // internal data
+        uint64_t m_bits; // number << 2 | kind
+    }; // end of CardId class
+
+    const std::size_t kCardTextMax = 32; // longest text FormatCard writes
+
+    std::size_t FormatCard(CardId id, char* out); // write the masked display text, only the last four digits shown, return its length
+    std::string CardText(CardId id); // format into a new string, empty for an empty id
+    bool ParseCardDigits(std::string_view digits, uint64_t& number); // read one to eighteen decimal digits, false for anything else
+
+    // Static minimal perfect hash from card ids to values, built once when the accounts are loaded.
+    // Keys are hashed into buckets of about two, then each bucket with several keys gets a seed that sends all of them
+    // to free slots of a table exactly as large as the key set. Single key buckets take the leftover slots directly.
+    // A probe is two multiplies, one table read and one compare, with no branch on the path to the slot.
+
+    class CardDirectory { // read only card to index lookup
+    public: // public interface
+        CardDirectory() = default; // empty directory, every probe misses
+        explicit CardDirectory(const std::vector<std::pair<CardId, uint32_t>>& entries); // build over the entries, the first entry wins for a repeated card
+        long long find(CardId id) const { // value stored for the card, or -1
+            if (m_keys.empty()) return -1; // nothing indexed
+            uint64_t h = mixBits(id.bits()); // one hash of the integer key
+            int32_t seed = m_seeds[fastRange(h, m_seeds.size())]; // bucket displacement
+            std::size_t probed = fastRange(mixBits(h + static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull), m_keys.size()); // slot a seeded bucket uses
+            std::size_t slot = seed < 0 ? static_cast<std::size_t>(~seed) : probed; // single key buckets store their slot, a select
+            return m_keys[slot] == id.bits() ? static_cast<long long>(m_values[slot]) : -1; // confirm the key
+        } // end find
+        std::size_t size() const { return m_keys.size(); } // distinct cards indexed
+        std::size_t memoryBytes() const { return m_seeds.capacity() * sizeof(int32_t) + m_keys.capacity() * sizeof(uint64_t) + m_values.capacity() * sizeof(uint32_t); } // table footprint
+
+    private: // internal helpers and data
+        static uint64_t mixBits(uint64_t z) { // SplitMix64 finalizer
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull; // first multiply
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull; // second multiply
+            return z ^ (z >> 31); // final shift
+        } // end mixBits
+        static std::size_t fastRange(uint64_t h, std::size_t n) { return static_cast<std::size_t>(((h >> 32) * static_cast<uint64_t>(n)) >> 32); } // map the high half into [0, n) without division
+
+        std::vector<int32_t> m_seeds; // per bucket seed, or ~slot for a single key bucket
+        std::vector<uint64_t> m_keys; // card bits per slot
+        std::vector<uint32_t> m_values; // value per slot
+    }; // end of CardDirectory class
+
+}
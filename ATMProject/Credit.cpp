@@ -2,11 +2,16 @@
 #include <iostream> // include input and output stream library
 #include <algorithm> // include algorithms like min and max
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> // include SSE2 double lanes
+#define ATMAPP_CREDIT_SSE2 1 // score two balance sets per step
+#endif
+
 namespace atmapp { // begin atmapp namespace
 
     CreditProfile::CreditProfile() : m_score(680) {} // constructor sets starting credit score to 680
 
-    void CreditProfile::compute(double checkingBal, double savingsBal, double monthlyIncome, double monthlySpend) { // compute updated credit score
+    static inline int scoreOf(double checkingBal, double savingsBal, double monthlyIncome, double monthlySpend) { // shared scoring formula
         double creditLimit = 5000.0; // assume a fixed credit limit
         double util = std::min(1.0, std::max(0.0, monthlySpend / creditLimit)); // calculate credit utilization, clamped between 0 and 1
         double savingsFactor = std::min(1.0, savingsBal / 10000.0); // scale savings up to a max effect at 10,000
@@ -17,9 +22,36 @@ namespace atmapp { // begin atmapp namespace
         double bufferImpact = incomeSafety * 20.0; // reward for leftover income
         double checkImpact = std::min(40.0, checkingBal / 2500.0 * 40.0); // small boost from checking balance up to a cap
         int s = static_cast<int>(base + utilImpact + savingsImpact + bufferImpact + checkImpact); // total computed score
-        m_score = std::max(300, std::min(850, s)); // clamp final score between 300 and 850
+        return std::max(300, std::min(850, s)); // clamp final score between 300 and 850
+    } // end scoreOf
+
+    void CreditProfile::compute(double checkingBal, double savingsBal, double monthlyIncome, double monthlySpend) { // compute updated credit score
+        m_score = scoreOf(checkingBal, savingsBal, monthlyIncome, monthlySpend); // one customer through the shared formula
     } // end compute
 
+    void CreditScores(const double* checking, const double* savings, const double* income, const double* spend, int* scores, std::size_t n) { // score many balance sets at once
+        std::size_t i = 0; // next entry
+#if defined(ATMAPP_CREDIT_SSE2)
+        const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0); // shared constants
+        for (; i + 2 <= n; i += 2) { // two entries per step, same operations in the same order as scoreOf
+            __m128d c = _mm_loadu_pd(checking + i), s = _mm_loadu_pd(savings + i); // balances
+            __m128d in = _mm_loadu_pd(income + i), sp = _mm_loadu_pd(spend + i); // monthly figures
+            __m128d util = _mm_min_pd(one, _mm_max_pd(zero, _mm_div_pd(sp, _mm_set1_pd(5000.0)))); // utilization against the fixed limit
+            __m128d savingsFactor = _mm_min_pd(one, _mm_div_pd(s, _mm_set1_pd(10000.0))); // savings effect
+            __m128d leftover = _mm_min_pd(one, _mm_div_pd(_mm_sub_pd(in, sp), _mm_max_pd(one, in))); // share of income left, divisor never zero
+            __m128d incomeSafety = _mm_and_pd(_mm_cmpgt_pd(in, zero), leftover); // zero where there is no income
+            __m128d checkImpact = _mm_min_pd(_mm_set1_pd(40.0), _mm_mul_pd(_mm_div_pd(c, _mm_set1_pd(2500.0)), _mm_set1_pd(40.0))); // checking boost up to the cap
+            __m128d total = _mm_add_pd(_mm_set1_pd(640.0), _mm_mul_pd(_mm_sub_pd(one, util), _mm_set1_pd(150.0))); // base plus utilization
+            total = _mm_add_pd(total, _mm_mul_pd(savingsFactor, _mm_set1_pd(40.0))); // plus savings
+            total = _mm_add_pd(total, _mm_mul_pd(incomeSafety, _mm_set1_pd(20.0))); // plus buffer
+            total = _mm_add_pd(total, checkImpact); // plus checking
+            total = _mm_max_pd(_mm_set1_pd(300.0), _mm_min_pd(_mm_set1_pd(850.0), total)); // clamp before truncating, same result as clamping the integer
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(scores + i), _mm_cvttpd_epi32(total)); // truncate like static_cast and store both
+        } // end for
+#endif
+        for (; i < n; ++i) scores[i] = scoreOf(checking[i], savings[i], income[i], spend[i]); // scalar tail and fallback
+    } // end CreditScores
+
     int CreditProfile::score() const { // return the stored credit score
         return m_score;
     } // end score
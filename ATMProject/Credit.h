@@ -1,5 +1,6 @@
 #pragma once // ensure this header is only included once per build
 #include <iosfwd> // forward declare iostream types for efficiency
+#include <cstddef> // include size_t for batch scoring
 
 namespace atmapp { // begin atmapp namespace
 
@@ -14,4 +15,6 @@ namespace atmapp { // begin atmapp namespace
         int m_score; // integer variable holding the credit score value
     }; // end of CreditProfile class
 
+    void CreditScores(const double* checking, const double* savings, const double* income, const double* spend, int* scores, std::size_t n); // same formula as compute over n parallel arrays, two at a time with SSE2
+
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "CreditProjection.h" // include header for the credit projection
+#include "Credit.h" // include the shared scoring formula
+#include "Finance.h" // include finance log for the customer's history
+#include <iostream> // include stream io for the report
+#include <iomanip> // include formatting manipulators
+#include <algorithm> // include min and max
+#include <atomic> // include the shared chunk counter
+#include <chrono> // include clocks for timing
+#include <cmath> // include floor for fractional event counts
+#include <mutex> // include lock for merging histograms
+#include <thread> // include worker threads
+
+namespace atmapp { // begin atmapp namespace
+
+    static const std::size_t kProjectionChunk = 256; // paths a worker claims at once, small enough to keep every column in cache
+    static const int kMinScore = 300; // lowest score the formula returns
+    static const int kScoreBins = 551; // one histogram bin per score from 300 to 850
+
+    static uint64_t mix64(uint64_t z) { // SplitMix64 finalizer, spreads nearby inputs across the whole range
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull; // first multiply
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull; // second multiply
+        return z ^ (z >> 31); // final shift
+    }
+
+    class PathRng { // xoshiro256** stream, 32 bytes so thousands of paths can each keep one
+    public: // public interface
+        PathRng() = default; // filled by seed before use
+        void seed(uint64_t base, uint64_t path) { // independent stream per path, same for any thread count
+            uint64_t x = mix64(base ^ mix64(path + 1)); // start point unique to this path
+            for (auto& w : m_s) w = mix64(x += 0x9E3779B97F4A7C15ull); // SplitMix64 fills the state, never all zero
+        }
+        uint64_t next() { // next 64 random bits
+            uint64_t result = rotl(m_s[1] * 5, 7) * 9; // scrambled output
+            uint64_t t = m_s[1] << 17; // shifted word
+            m_s[2] ^= m_s[0]; m_s[3] ^= m_s[1]; m_s[1] ^= m_s[2]; m_s[0] ^= m_s[3]; // mix the state
+            m_s[2] ^= t; m_s[3] = rotl(m_s[3], 45); // finish the step
+            return result; // return output
+        }
+        double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); } // uniform draw in [0, 1)
+        std::size_t below(std::size_t n) { return static_cast<std::size_t>(((next() >> 32) * static_cast<uint64_t>(n)) >> 32); } // index in [0, n) without division
+
+    private: // internal state
+        static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); } // rotate left
+        uint64_t m_s[4]; // generator state
+    }; // end of PathRng class
+
+    struct CustomerModel { // what one simulated month draws from
+        std::vector<double> purchases; // every past purchase amount, resampled uniformly
+        double purchasesPerMonth = 0.0; // average purchase count per month
+        double paychecksPerMonth = 0.0; // average paycheck count per month
+        double paycheckBase = 0.0; // usual paycheck amount
+        double income = 0.0; // monthly income estimate today
+        double spend = 0.0; // monthly spending estimate today
+    }; // end of CustomerModel struct
+
+    static CustomerModel modelOf(const FinanceLog& fin) { // read the history once, in any storage form
+        CustomerModel m; // result
+        int64_t paycheckCents = 0; // paycheck total
+        std::size_t paychecks = 0; // paycheck count
+        PackedDate first = 0xFFFFFFFFu, last = 0; // oldest and newest dated event
+        fin.forEach(0, 0xFFFFFFFFu, [&](const FinRow& r) { // every event
+            if (r.kind == FinEvent::Kind::Purchase) m.purchases.push_back(static_cast<double>(r.cents) / 100.0); // keep the amount for resampling
+            else { paycheckCents += r.cents; ++paychecks; } // total income
+            if (r.date != 0) { first = std::min(first, r.date); last = std::max(last, r.date); } // malformed dates are zero and say nothing about the span
+            return true; // keep going
+        }); // end forEach
+        int span = MonthSpan(first, last); // calendar months touched, the same divisor the estimates use
+        m.purchasesPerMonth = static_cast<double>(m.purchases.size()) / span; // imported statements can cover any number of months
+        m.paychecksPerMonth = static_cast<double>(paychecks) / span; // same span
+        m.paycheckBase = paychecks ? static_cast<double>(paycheckCents) / 100.0 / static_cast<double>(paychecks) : 0.0; // average paycheck
+        m.income = fin.monthlyIncomeEstimate(); // same estimate the menu scores with
+        m.spend = fin.monthlySpendEstimate(); // same estimate the menu scores with
+        return m; // return model
+    }
+
+    static int drawCount(PathRng& rng, double perMonth) { // whole events this month, the fraction decides one extra
+        double whole = std::floor(perMonth); // guaranteed events
+        return static_cast<int>(whole) + (rng.unit() < perMonth - whole ? 1 : 0); // maybe one more
+    }
+
+    CreditProjection ProjectCredit(const ProjectionOptions& opts, double checkingBal, double savingsBal, const FinanceLog& fin) { // run every path
+        auto start = std::chrono::steady_clock::now(); // wall clock start
+        const CustomerModel model = modelOf(fin); // shared by every worker, read only
+        const int months = std::max(1, opts.months); // at least one month
+        const std::size_t paths = static_cast<std::size_t>(std::max(1, opts.paths)); // at least one path
+        unsigned hw = std::thread::hardware_concurrency(); // available threads
+        int threads = opts.threads > 0 ? opts.threads : static_cast<int>(hw ? hw : 1); // worker count
+        threads = static_cast<int>(std::min<std::size_t>(static_cast<std::size_t>(threads), (paths + kProjectionChunk - 1) / kProjectionChunk)); // no idle workers
+
+        std::vector<uint64_t> hist(static_cast<std::size_t>(months) * kScoreBins, 0); // merged score counts per month
+        std::vector<int64_t> totals(static_cast<std::size_t>(months), 0); // merged score sums per month
+        std::mutex merge; // guards the merged counts
+        std::atomic<std::size_t> next(0); // next unclaimed path
+        auto worker = [&] { // simulate a chunk of paths at a time, month by month
+            std::vector<uint64_t> myHist(hist.size(), 0); // this worker's counts
+            std::vector<int64_t> myTotals(totals.size(), 0); // this worker's sums
+            PathRng rng[kProjectionChunk]; // one stream per path in the chunk
+            double checking[kProjectionChunk], savings[kProjectionChunk]; // balances per path, one column each
+            double income[kProjectionChunk], spend[kProjectionChunk]; // trailing quarter averages per path
+            double incomeWin[3][kProjectionChunk], spendWin[3][kProjectionChunk]; // last three months per path
+            int scores[kProjectionChunk]; // this month's scores
+            while (true) { // claim chunks until none are left
+                std::size_t begin = next.fetch_add(kProjectionChunk, std::memory_order_relaxed); // claim a chunk
+                if (begin >= paths) break; // all claimed
+                std::size_t n = std::min(paths, begin + kProjectionChunk) - begin; // paths in this chunk
+                for (std::size_t i = 0; i < n; ++i) { // start every path from today
+                    rng[i].seed(opts.seed, begin + i); // stream tied to the path index
+                    checking[i] = checkingBal; savings[i] = savingsBal; // balances today
+                    for (int w = 0; w < 3; ++w) { incomeWin[w][i] = model.income; spendWin[w][i] = model.spend; } // the past quarter as the menu sees it
+                } // end for
+                for (int m = 0; m < months; ++m) { // each future month
+                    double* inWin = incomeWin[m % 3]; // oldest month slot, overwritten
+                    double* outWin = spendWin[m % 3]; // oldest month slot, overwritten
+                    for (std::size_t i = 0; i < n; ++i) { // draw the month for each path, scalar because counts differ
+                        PathRng& r = rng[i]; // this path's stream
+                        double in = 0.0, out = 0.0; // month totals
+                        for (int k = drawCount(r, model.paychecksPerMonth); k > 0; --k) in += model.paycheckBase * (0.97 + 0.06 * r.unit()); // paychecks vary like DataGen's
+                        if (!model.purchases.empty()) for (int k = drawCount(r, model.purchasesPerMonth); k > 0; --k) out += model.purchases[r.below(model.purchases.size())]; // purchases from the customer's own mix
+                        inWin[i] = in; outWin[i] = out; // remember for the trailing quarter
+                        double c = checking[i] + in - out; // checking after the month
+                        double cover = std::min(savings[i], std::max(0.0, -c)); // overdraft pulled from savings while it lasts
+                        checking[i] = c + cover; savings[i] -= cover; // move the cover
+                    } // end for
+                    for (std::size_t i = 0; i < n; ++i) { // trailing quarter, columns so the loop vectorizes
+                        income[i] = (incomeWin[0][i] + incomeWin[1][i] + incomeWin[2][i]) / 3.0; // average income
+                        spend[i] = (spendWin[0][i] + spendWin[1][i] + spendWin[2][i]) / 3.0; // average spending
+                    } // end for
+                    CreditScores(checking, savings, income, spend, scores, n); // whole chunk through the scoring kernel
+                    uint64_t* h = &myHist[static_cast<std::size_t>(m) * kScoreBins]; // this month's bins
+                    int64_t sum = 0; // this month's total
+                    for (std::size_t i = 0; i < n; ++i) { ++h[scores[i] - kMinScore]; sum += scores[i]; } // count each score
+                    myTotals[static_cast<std::size_t>(m)] += sum; // add the chunk
+                } // end for
+            } // end while
+            std::lock_guard<std::mutex> guard(merge); // one merge per worker
+            for (std::size_t i = 0; i < hist.size(); ++i) hist[i] += myHist[i]; // add counts
+            for (std::size_t i = 0; i < totals.size(); ++i) totals[i] += myTotals[i]; // add sums
+        }; // end worker
+        std::vector<std::thread> pool; // worker threads
+        for (int t = 1; t < threads; ++t) pool.emplace_back(worker); // start helpers
+        worker(); // the caller works too
+        for (auto& t : pool) t.join(); // wait for every chunk
+
+        CreditProfile today; // score from today's inputs
+        today.compute(checkingBal, savingsBal, model.income, model.spend); // same inputs as the menu
+        CreditProjection p; // result
+        p.startScore = today.score(); // starting point
+        p.paths = static_cast<int>(paths); // futures simulated
+        p.months.resize(static_cast<std::size_t>(months)); // one row per month
+        for (int m = 0; m < months; ++m) { // read percentiles off each histogram
+            const uint64_t* h = &hist[static_cast<std::size_t>(m) * kScoreBins]; // this month's bins
+            auto at = [&](double q) { // smallest score with at least q of the paths at or below it
+                uint64_t need = static_cast<uint64_t>(std::ceil(q * static_cast<double>(paths))); // rank wanted
+                uint64_t seen = 0; // paths counted so far
+                for (int b = 0; b < kScoreBins; ++b) if ((seen += h[b]) >= need) return b + kMinScore; // found the bin
+                return kMinScore + kScoreBins - 1; // top score
+            }; // end at
+            ProjectionMonth& row = p.months[static_cast<std::size_t>(m)]; // row to fill
+            row.p10 = at(0.10); row.p25 = at(0.25); row.p50 = at(0.50); row.p75 = at(0.75); row.p90 = at(0.90); // percentiles
+            row.mean = static_cast<double>(totals[static_cast<std::size_t>(m)]) / static_cast<double>(paths); // average
+        } // end for
+        p.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // wall time
+        return p; // return result
+    } // end ProjectCredit
+
+    void PrintProjection(std::ostream& out, const CreditProjection& p) { // one line per projected month
+        std::ios::fmtflags flags = out.flags(); // caller's formatting
+        std::streamsize precision = out.precision(); // caller's precision
+        out << "\nAssistant. Credit outlook over " << p.months.size() << " months, " << p.paths << " simulated paths. Today. " << p.startScore << "\n"; // header
+        out << "  month   p10   p25  median   p75   p90    mean\n"; // columns
+        for (std::size_t m = 0; m < p.months.size(); ++m) { // each month
+            const ProjectionMonth& r = p.months[m]; // row
+            out << std::setw(7) << (m + 1) << std::setw(6) << r.p10 << std::setw(6) << r.p25 << std::setw(8) << r.p50 << std::setw(6) << r.p75 << std::setw(6) << r.p90 // percentiles
+                << std::setw(8) << std::fixed << std::setprecision(1) << r.mean << "\n"; // average
+        } // end for
+        out.flags(flags); out.precision(precision); // leave the stream as it was
+    } // end PrintProjection
+
+}
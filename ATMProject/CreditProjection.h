@@ -0,0 +1,41 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <iosfwd> // forward declare iostream types for efficiency
+#include <cstdint> // include fixed width integer types
+#include <vector> // include vector for the monthly rows
+
+namespace atmapp { // begin atmapp namespace
+
+    class FinanceLog; // forward declaration of FinanceLog class
+
+    // Monte Carlo what-if for the credit score. Every path replays future months the way DataGen builds one,
+    // the same count of purchases resampled from the customer's own history plus paychecks a few percent around their usual size.
+    // Balances carry over, an overdraft is covered from savings, and each month is scored on the trailing quarter like the menu.
+    // Each path owns a random stream derived from its index, so the distribution does not depend on the thread count.
+
+    struct ProjectionOptions { // settings for one projection
+        int paths = 4000; // simulated futures
+        int months = 12; // months projected ahead
+        int threads = 0; // workers, zero uses every hardware thread
+        uint64_t seed = 1; // base of every path's stream, the same seed gives the same distribution
+    }; // end of ProjectionOptions struct
+
+    struct ProjectionMonth { // score distribution across paths for one future month
+        int p10; // tenth percentile
+        int p25; // lower quartile
+        int p50; // median
+        int p75; // upper quartile
+        int p90; // ninetieth percentile
+        double mean; // average score
+    }; // end of ProjectionMonth struct
+
+    struct CreditProjection { // result of one projection
+        int startScore; // score today from the same inputs
+        int paths; // futures simulated
+        std::vector<ProjectionMonth> months; // one row per projected month, nearest first
+        double seconds; // wall time for the whole run
+    }; // end of CreditProjection struct
+
+    CreditProjection ProjectCredit(const ProjectionOptions& opts, double checkingBal, double savingsBal, const FinanceLog& fin); // simulate paths across a worker pool
+    void PrintProjection(std::ostream& out, const CreditProjection& p); // percentile table, one line per month
+
+}
@@ -0,0 +1,319 @@
+#include "CsvImport.h" // include header for the statement importer
+#include "MappedFile.h" // include read only file mapping
+#include "Calendar.h" // include packed dates
+#include "Format.h" // include exact cent rounding
+#include "Timeline.h" // include the stable radix sort
+
+#include <algorithm> // include sort and min
+#include <atomic> // include shared chunk counter
+#include <charconv> // include from_chars for amounts
+#include <chrono> // include clocks for timing
+#include <cstring> // include memchr
+#include <deque> // include stable storage for unescaped names
+#include <queue> // include priority queue for the chunk merge
+#include <string_view> // include string_view fields
+#include <thread> // include worker threads
+#include <unordered_map> // include name interning tables
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> // include SSE2 byte compares
+#define ATMAPP_CSV_SSE2 1 // scan sixteen bytes per step
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+    enum CsvColumn { kColDate, kColAmount, kColKind, kColStore, kColCity, kColItem, kColCount }; // fields the importer understands
+
+    struct CsvRow { // compact parsed row, names are interned ids until the final copy
+        PackedDate date; // event day
+        int64_t cents; // amount in whole cents, always positive
+        uint32_t store; // merchant or employer id
+        uint32_t city; // location id
+        uint32_t item; // item or memo id
+        FinEvent::Kind kind; // purchase or paycheck
+    }; // end of CsvRow struct
+
+    struct CsvChunk { // one newline aligned slice of the file and what was parsed from it
+        const char* begin; // first byte
+        const char* end; // one past the last byte
+        std::vector<CsvRow> rows; // parsed rows, newest first after sorting
+        std::vector<std::string_view> names; // chunk local name table
+        std::unordered_map<std::string_view, uint32_t> ids; // name to chunk local id
+        std::deque<std::string> owned; // unescaped quoted names, views into the mapping cover everything else
+        uint64_t skipped = 0; // lines that did not parse
+    }; // end of CsvChunk struct
+
+    static const char* findSpecial(const char* p, const char* end) { // first comma, quote or newline at or after p, or end
+#if defined(ATMAPP_CSV_SSE2)
+        const __m128i comma = _mm_set1_epi8(','); // comma in every lane
+        const __m128i quote = _mm_set1_epi8('"'); // quote in every lane
+        const __m128i newline = _mm_set1_epi8('\n'); // newline in every lane
+        while (end - p >= 16) { // whole blocks
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); // sixteen bytes
+            __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, quote)), _mm_cmpeq_epi8(v, newline)); // any delimiter
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit)); // one bit per byte
+            if (mask) { // found one
+#if defined(_MSC_VER)
+                unsigned long bit; // index of the lowest set bit
+                _BitScanForward(&bit, mask); // find it
+                return p + bit; // delimiter position
+#else
+                return p + __builtin_ctz(mask); // delimiter position
+#endif
+            } // end if
+            p += 16; // next block
+        } // end while
+#endif
+        while (p < end && *p != ',' && *p != '"' && *p != '\n') ++p; // scalar tail and fallback
+        return p; // delimiter or end
+    } // end findSpecial
+
+    static std::string_view trim(std::string_view s) { // drop surrounding blanks and a trailing carriage return
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1); // leading blanks
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1); // trailing blanks
+        return s; // trimmed view
+    } // end trim
+
+    static bool sameWord(std::string_view a, const char* b) { // case insensitive comparison with a lower case word
+        std::size_t n = std::strlen(b); // word length
+        if (a.size() != n) return false; // lengths differ
+        for (std::size_t i = 0; i < n; ++i) { char c = a[i]; if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a'); if (c != b[i]) return false; } // compare folded
+        return true; // same word
+    } // end sameWord
+
+    static const char* scanLine(const char* p, const char* end, std::string_view (&fields)[16], int& count, std::deque<std::string>& owned) { // split one line into fields, return the start of the next line
+        count = 0; // fields found
+        while (true) { // each field
+            std::string_view field; // field text
+            const char* q; // delimiter after the field
+            if (p < end && *p == '"') { // quoted field
+                const char* start = ++p; // first byte inside the quotes
+                std::string* unescaped = nullptr; // copy made only when "" appears
+                while (true) { // find the closing quote
+                    const char* close = static_cast<const char*>(std::memchr(p, '"', static_cast<std::size_t>(end - p))); // next quote
+                    if (!close) { close = end; } // unterminated, take the rest
+                    if (close + 1 < end && close[1] == '"') { // doubled quote is a literal quote
+                        if (!unescaped) { owned.emplace_back(); unescaped = &owned.back(); } // start the copy
+                        unescaped->append(p, close + 1); // text plus one quote
+                        p = close + 2; // skip both quotes
+                        continue; // keep looking
+                    } // end if
+                    if (unescaped) { unescaped->append(p, close); field = *unescaped; } // finish the copy
+                    else field = std::string_view(start, static_cast<std::size_t>(close - start)); // view into the file
+                    p = close < end ? close + 1 : end; // after the closing quote
+                    break; // field done
+                } // end while
+                q = findSpecial(p, end); // skip anything between the quote and the delimiter
+                while (q < end && *q == '"') q = findSpecial(q + 1, end); // stray quotes are ignored
+            }
+            else { // plain field
+                q = findSpecial(p, end); // delimiter
+                while (q < end && *q == '"') q = findSpecial(q + 1, end); // quotes inside a plain field are literal
+                field = std::string_view(p, static_cast<std::size_t>(q - p)); // view into the file
+            }
+            if (count < 16) fields[count++] = trim(field); // keep the field
+            if (q >= end) return end; // last line without a newline
+            if (*q == '\n') return q + 1; // end of line
+            p = q + 1; // next field
+        } // end while
+    } // end scanLine
+
+    static bool parseAnyDate(std::string_view s, PackedDate& out) { // YYYY-MM-DD or M/D/YYYY
+        if (ParseDate(s.data(), s.size(), out)) return true; // ISO dates
+        int parts[3] = { 0, 0, 0 }; // month, day, year
+        int part = 0, digits = 0; // current part and its length
+        for (char c : s) { // each character
+            if (c >= '0' && c <= '9') { parts[part] = parts[part] * 10 + (c - '0'); ++digits; } // digit
+            else if (c == '/' && part < 2 && digits > 0) { ++part; digits = 0; } // next part
+            else return false; // anything else
+        } // end for
+        if (part != 2 || digits != 4 || parts[0] < 1 || parts[0] > 12 || parts[1] < 1 || parts[1] > 31) return false; // wrong shape
+        out = PackDate(parts[2], parts[0], parts[1]); // pack result
+        return true; // parsed
+    } // end parseAnyDate
+
+    static bool parseCents(std::string_view s, int64_t& cents, bool& negative) { // dollars with optional sign, $, parentheses and thousands commas
+        negative = false; // sign of the amount
+        if (!s.empty() && s.front() == '(' && s.back() == ')') { negative = true; s = s.substr(1, s.size() - 2); } // accounting negative
+        if (!s.empty() && s.front() == '-') { negative = !negative; s.remove_prefix(1); } // leading minus
+        if (!s.empty() && s.front() == '$') s.remove_prefix(1); // currency sign
+        if (!s.empty() && s.front() == '-') { negative = !negative; s.remove_prefix(1); } // minus after the currency sign
+        char buf[32]; // copy when commas must go
+        if (s.find(',') != std::string_view::npos) { // thousands separators
+            std::size_t n = 0; // copied bytes
+            for (char c : s) if (c != ',' && n < sizeof(buf)) buf[n++] = c; // drop commas
+            s = std::string_view(buf, n); // parse the copy
+        } // end if
+        double v = 0.0; // parsed dollars
+        auto res = std::from_chars(s.data(), s.data() + s.size(), v); // locale free parse
+        if (s.empty() || res.ec != std::errc() || res.ptr != s.data() + s.size()) return false; // not a number
+        cents = ToCents(v); // whole cents
+        return true; // parsed
+    } // end parseCents
+
+    static uint32_t intern(CsvChunk& chunk, std::string_view name) { // chunk local id for a name
+        auto it = chunk.ids.find(name); // seen before
+        if (it != chunk.ids.end()) return it->second; // reuse the id
+        uint32_t id = static_cast<uint32_t>(chunk.names.size()); // next id
+        chunk.names.push_back(name); // remember the text
+        chunk.ids.emplace(name, id); // remember the id
+        return id; // new id
+    } // end intern
+
+    static void parseChunk(CsvChunk& chunk, const int (&columnOf)[kColCount], bool hasKind) { // parse every line of one chunk
+        std::string_view fields[16]; // fields of the current line
+        int count = 0; // fields on the current line
+        chunk.rows.reserve(static_cast<std::size_t>(chunk.end - chunk.begin) / 48); // rough row estimate
+        const char* p = chunk.begin; // scan position
+        while (p < chunk.end) { // each line
+            p = scanLine(p, chunk.end, fields, count, chunk.owned); // split the line
+            if (count == 1 && fields[0].empty()) continue; // blank line
+            auto field = [&](int col) { int i = columnOf[col]; return i >= 0 && i < count ? fields[i] : std::string_view(); }; // field by column
+            CsvRow row; // parsed row
+            bool negative = false; // amount sign
+            if (!parseAnyDate(field(kColDate), row.date) || !parseCents(field(kColAmount), row.cents, negative)) { ++chunk.skipped; continue; } // required fields
+            if (hasKind) { // explicit type column
+                std::string_view k = field(kColKind); // type text
+                if (sameWord(k, "purchase") || sameWord(k, "debit") || sameWord(k, "sale")) row.kind = FinEvent::Kind::Purchase; // money out
+                else if (sameWord(k, "paycheck") || sameWord(k, "credit") || sameWord(k, "deposit") || sameWord(k, "payroll")) row.kind = FinEvent::Kind::Paycheck; // money in
+                else { ++chunk.skipped; continue; } // payments, fees and the like are not modeled
+            }
+            else row.kind = negative ? FinEvent::Kind::Purchase : FinEvent::Kind::Paycheck; // sign decides
+            row.store = intern(chunk, field(kColStore)); // merchant or employer
+            row.city = intern(chunk, field(kColCity)); // location
+            row.item = intern(chunk, field(kColItem)); // item
+            chunk.rows.push_back(row); // keep it
+        } // end while
+        auto newer = [](const CsvRow& a, const CsvRow& b) { return a.date > b.date; }; // newest first
+        if (!std::is_sorted(chunk.rows.begin(), chunk.rows.end(), newer)) { // exports are usually sorted one way or the other
+            auto older = [](const CsvRow& a, const CsvRow& b) { return a.date < b.date; }; // oldest first
+            if (std::is_sorted(chunk.rows.begin(), chunk.rows.end(), older)) { // oldest first export
+                std::reverse(chunk.rows.begin(), chunk.rows.end()); // flip to newest first
+                auto lo = chunk.rows.begin(); // start of an equal date run
+                while (lo != chunk.rows.end()) { auto hi = std::find_if(lo, chunk.rows.end(), [&](const CsvRow& r) { return r.date != lo->date; }); std::reverse(lo, hi); lo = hi; } // restore file order within a day
+            }
+            else { // unsorted export
+                std::vector<CsvRow> scratch(chunk.rows.size()); // radix scatter target
+                RadixSortByKey(chunk.rows.data(), scratch.data(), chunk.rows.size(), [](const CsvRow& r) { return static_cast<uint64_t>(~r.date); }); // newest first, file order within a day
+            } // end if
+        } // end if
+    } // end parseChunk
+
+    bool ImportStatementCsv(const std::string& path, FinEventList& out, CsvImportStats& stats, std::string& error, int threads) { // map, split, parse, merge
+        auto start = std::chrono::steady_clock::now(); // wall clock start
+        stats = CsvImportStats{ 0, 0, 0, 0, 0.0 }; // reset totals
+        out.clear(); // replace any earlier contents
+        MappedFile file; // whole file view
+        if (!file.open(path, error)) return false; // cannot read
+        stats.bytes = file.size(); // file size
+        const char* begin = file.data(); // first byte
+        const char* end = begin + file.size(); // one past the last byte
+        if (file.size() >= 3 && static_cast<unsigned char>(begin[0]) == 0xEF && static_cast<unsigned char>(begin[1]) == 0xBB && static_cast<unsigned char>(begin[2]) == 0xBF) begin += 3; // skip a UTF-8 byte order mark
+
+        std::string_view header[16]; // column names
+        int headerCount = 0; // columns in the header
+        std::deque<std::string> headerOwned; // unescaped header names
+        const char* body = begin < end ? scanLine(begin, end, header, headerCount, headerOwned) : end; // first data line
+        int columnOf[kColCount] = { -1, -1, -1, -1, -1, -1 }; // header position of each known column
+        for (int i = 0; i < headerCount; ++i) { // match names
+            std::string_view h = header[i]; // column name
+            int col = sameWord(h, "date") ? kColDate : sameWord(h, "amount") ? kColAmount : (sameWord(h, "type") || sameWord(h, "kind")) ? kColKind // required and type columns
+                : (sameWord(h, "merchant") || sameWord(h, "store") || sameWord(h, "description") || sameWord(h, "employer") || sameWord(h, "payee")) ? kColStore // name columns
+                : (sameWord(h, "city") || sameWord(h, "location")) ? kColCity : (sameWord(h, "item") || sameWord(h, "category") || sameWord(h, "memo")) ? kColItem : -1; // place and item columns
+            if (col >= 0 && columnOf[col] < 0) columnOf[col] = i; // first match wins
+        } // end for
+        if (columnOf[kColDate] < 0 || columnOf[kColAmount] < 0) { error = "header needs date and amount columns"; return false; } // unusable file
+
+        unsigned hw = std::thread::hardware_concurrency(); // available threads
+        int workers = threads > 0 ? threads : static_cast<int>(hw ? hw : 1); // worker count
+        std::size_t bodySize = static_cast<std::size_t>(end - body); // bytes of data lines
+        std::size_t pieces = std::max<std::size_t>(1, std::min<std::size_t>(static_cast<std::size_t>(workers) * 4, bodySize / (1 << 20))); // about four chunks per worker, at least a megabyte each
+        std::vector<CsvChunk> chunks(pieces); // chunk table
+        const char* cut = body; // start of the next chunk
+        for (std::size_t i = 0; i < pieces; ++i) { // newline aligned boundaries
+            const char* target = i + 1 == pieces ? end : body + bodySize * (i + 1) / pieces; // even split
+            if (target < cut) target = cut; // an earlier long line ran past this split
+            const char* nl = target < end ? static_cast<const char*>(std::memchr(target, '\n', static_cast<std::size_t>(end - target))) : nullptr; // next line break
+            const char* stop = i + 1 == pieces || !nl ? end : nl + 1; // chunk end after the line break
+            chunks[i].begin = cut; chunks[i].end = stop; // record it
+            cut = stop; // next chunk starts here
+        } // end for
+
+        std::atomic<std::size_t> next(0); // next unclaimed chunk
+        auto work = [&] { for (std::size_t i; (i = next.fetch_add(1)) < pieces;) parseChunk(chunks[i], columnOf, columnOf[kColKind] >= 0); }; // parse until none are left
+        std::vector<std::thread> pool; // worker threads
+        for (int t = 1; t < workers && static_cast<std::size_t>(t) < pieces; ++t) pool.emplace_back(work); // start helpers
+        work(); // the caller parses too
+        for (auto& t : pool) t.join(); // wait for every chunk
+
+        std::unordered_map<std::string_view, uint32_t> global; // name to global id
+        std::vector<std::string_view> names; // global id to name
+        std::vector<std::vector<uint32_t>> remap(pieces); // chunk local id to global id
+        std::size_t total = 0; // rows across chunks
+        for (std::size_t i = 0; i < pieces; ++i) { // merge the name tables
+            remap[i].resize(chunks[i].names.size()); // one slot per local name
+            for (std::size_t n = 0; n < chunks[i].names.size(); ++n) { // each local name
+                auto ins = global.emplace(chunks[i].names[n], static_cast<uint32_t>(names.size())); // add when new
+                if (ins.second) names.push_back(chunks[i].names[n]); // new global name
+                remap[i][n] = ins.first->second; // global id
+            } // end for
+            total += chunks[i].rows.size(); // count rows
+            stats.skipped += chunks[i].skipped; // count failures
+        } // end for
+
+        std::vector<std::size_t> nonEmpty; // chunks that produced rows, in file order
+        for (std::size_t i = 0; i < pieces; ++i) if (!chunks[i].rows.empty()) nonEmpty.push_back(i); // skip empty ones
+        bool forward = true, backward = true; // whether whole chunks are already in output order
+        for (std::size_t k = 1; k < nonEmpty.size(); ++k) { // compare neighbouring chunks
+            const auto& prev = chunks[nonEmpty[k - 1]].rows; // earlier in the file
+            const auto& cur = chunks[nonEmpty[k]].rows; // later in the file
+            if (prev.back().date < cur.front().date) forward = false; // a newest first export would never do this
+            if (cur.back().date <= prev.front().date) backward = false; // an oldest first export needs strictly newer chunks so ties keep file order
+        } // end for
+        std::vector<std::pair<uint32_t, uint32_t>> order; // chunk and row in output order
+        order.reserve(total); // one slot per row
+        if (forward || backward) { // sorted export, chunks only need concatenating
+            if (backward && !forward) std::reverse(nonEmpty.begin(), nonEmpty.end()); // newest chunk first
+            for (std::size_t i : nonEmpty) for (std::size_t r = 0; r < chunks[i].rows.size(); ++r) order.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(r)); // whole chunk
+        }
+        else { // chunks overlap in time, k way merge
+            struct Cursor { PackedDate date; std::size_t chunk; std::size_t row; }; // head of one chunk during the merge
+            auto later = [](const Cursor& a, const Cursor& b) { return a.date != b.date ? a.date < b.date : a.chunk > b.chunk; }; // newest date first, then file order
+            std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heads(later); // merge heap
+            for (std::size_t i : nonEmpty) heads.push(Cursor{ chunks[i].rows[0].date, i, 0 }); // first row of each chunk
+            while (!heads.empty()) { // pop newest
+                Cursor c = heads.top(); heads.pop(); // next row
+                order.emplace_back(static_cast<uint32_t>(c.chunk), static_cast<uint32_t>(c.row)); // record it
+                if (++c.row < chunks[c.chunk].rows.size()) { c.date = chunks[c.chunk].rows[c.row].date; heads.push(c); } // advance the chunk
+            } // end while
+        }
+
+        out.resize(total); // every event, filled in parallel below
+        auto fill = [&](std::size_t from, std::size_t to) { // copy interned names into events
+            for (std::size_t i = from; i < to; ++i) { // each output row
+                const CsvChunk& ch = chunks[order[i].first]; // source chunk
+                const CsvRow& r = ch.rows[order[i].second]; // source row
+                const std::vector<uint32_t>& ids = remap[order[i].first]; // id translation
+                FinEvent& e = out[i]; // destination
+                e.kind = r.kind; // purchase or paycheck
+                e.date = DateString(r.date); // normalized date text
+                e.store.assign(names[ids[r.store]]); // merchant or employer
+                e.location.assign(names[ids[r.city]]); // location
+                e.item.assign(names[ids[r.item]]); // item
+                e.amount = static_cast<double>(r.cents) / 100.0; // dollars
+            } // end for
+        }; // end fill
+        pool.clear(); // reuse the thread list
+        int fillers = out.get_allocator().resource() == std::pmr::get_default_resource() ? workers : 1; // an arena such as FinBatch's is not thread safe, so its strings are copied on one thread
+        std::size_t per = (total + static_cast<std::size_t>(fillers) - 1) / static_cast<std::size_t>(fillers); // rows per filler
+        for (int t = 1; t < fillers && per * static_cast<std::size_t>(t) < total; ++t) pool.emplace_back(fill, per * static_cast<std::size_t>(t), std::min(total, per * static_cast<std::size_t>(t + 1))); // helpers
+        fill(0, std::min(total, per)); // the caller fills the first range
+        for (auto& t : pool) t.join(); // wait for every range
+
+        stats.rows = total; // events produced
+        stats.names = names.size(); // distinct names
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // wall time
+        return true; // imported
+    } // end ImportStatementCsv
+
+}
\ No newline at end of file
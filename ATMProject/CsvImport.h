@@ -0,0 +1,30 @@
+#pragma once // prevent multiple inclusion of this header file
+#include "Finance.h" // include FinEvent for the imported rows
+#include <string> // include string for paths and errors
+#include <vector> // include vector container
+#include <cstdint> // include fixed width integer types
+
+namespace atmapp { // begin atmapp namespace
+
+    // Statement CSV layout. The first line names the columns, matched without regard to case:
+    //   date                              YYYY-MM-DD or MM/DD/YYYY, required
+    //   amount                            dollars, an optional $ and a leading minus are accepted, required
+    //   type | kind                       purchase, debit, paycheck, credit or deposit, optional
+    //   merchant | store | description | employer | payee
+    //   city | location
+    //   item | category | memo
+    // Without a type column negative amounts are purchases and positive amounts paychecks.
+    // Fields may be double quoted with "" for a literal quote. Quoted fields may not contain line breaks.
+    // Names are copied into the events in parallel only when the list allocates from the default resource.
+
+    struct CsvImportStats { // what one import did
+        uint64_t rows; // events produced
+        uint64_t skipped; // data lines that could not be parsed
+        uint64_t bytes; // file size
+        uint64_t names; // distinct merchant, city and item names after interning
+        double seconds; // wall time
+    }; // end of CsvImportStats struct
+
+    bool ImportStatementCsv(const std::string& path, FinEventList& out, CsvImportStats& stats, std::string& error, int threads = 0); // parse a statement export newest first, false with a reason when the file cannot be used
+
+}
\ No newline at end of file
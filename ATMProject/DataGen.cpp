@@ -1,9 +1,7 @@
 #include "DataGen.h" // include header for DataGen class
 #include <array> // include fixed size array container
-#include <sstream> // include string stream utilities
-#include <iomanip> // include formatting for output
-#include <ctime> // include time handling functions
-#include <algorithm> // include algorithms like sort
+#include <algorithm> // include algorithms like reverse, shuffle and max
+#include <cmath> // include rounding and exp helpers
 
 namespace atmapp { // begin atmapp namespace
 
@@ -28,72 +26,164 @@ namespace atmapp { // begin atmapp namespace
         "Canyon Logistics","Prairie Systems","River City Bank","Blue Ridge Media"
     };
 
-    DataGen::DataGen(uint64_t seed) : rng(seed) {} // constructor initializes random generator with seed
-
-    std::string DataGen::randomDateInPastMonths(int monthsBack) { // create random date string in previous months
-        std::uniform_int_distribution<int> dday(0, 27); // random day generator
-        std::time_t t = std::time(nullptr); // current time in seconds
-        std::tm tm{}; // create a tm structure
-#if defined(_WIN32)
-        localtime_s(&tm, &t); // convert time to local on Windows
-#else
-        localtime_r(&t, &tm); // convert time to local on other systems
-#endif
-        int month = tm.tm_mon + 1; // extract current month
-        int year = tm.tm_year + 1900; // extract current year
-        month -= monthsBack; // subtract months to go back in time
-        while (month <= 0) { month += 12; --year; } // adjust year if month goes below January
-        int day = 1 + dday(rng); // pick a random day in the month
-        std::ostringstream os; // string builder for formatted date
-        os << std::setfill('0') << std::setw(4) << year << "-" << std::setw(2) << month << "-" << std::setw(2) << day; // format YYYY-MM-DD
-        return os.str(); // return formatted date
-    }
-
-    FinEvent DataGen::randomPurchase() { // generate random purchase event
-        std::uniform_int_distribution<int> di(0, static_cast<int>(kItems.size() - 1)); // random item index
-        std::uniform_int_distribution<int> ds(0, static_cast<int>(kStores.size() - 1)); // random store index
-        std::uniform_int_distribution<int> dc(0, static_cast<int>(kCities.size() - 1)); // random city index
-        std::uniform_real_distribution<double> damt(6.0, 420.0); // random purchase amount
-        FinEvent e; // create event object
+    struct PriceModel { double median; double sigma; }; // log normal price shape for one item
+
+    static const std::array<PriceModel, 18> kItemPrices = {{ // typical price and spread for each entry of kItems
+        {14.0,0.25},{85.0,0.45},{22.0,0.30},{35.0,0.30},{45.0,0.35},{110.0,0.35},
+        {48.0,0.30},{18.0,0.35},{8.0,0.40},{16.0,0.35},{12.0,0.25},{20.0,0.30},
+        {60.0,0.25},{70.0,0.45},{14.0,0.30},{28.0,0.25},{45.0,0.35},{9.0,0.40}
+    }};
+    static_assert(kItemPrices.size() == kItems.size(), "every item needs a price model"); // keep tables in step
+
+    static const int kPriceSteps = 256; // resolution of the tabulated price quantiles
+
+    static double normalQuantile(double u) { // inverse of the standard normal CDF by bisection, used only while building tables
+        double lo = -8.0, hi = 8.0; // bracket covering every double precision quantile of interest
+        for (int i = 0; i < 64; ++i) { // halve the bracket until it is tight
+            double mid = 0.5 * (lo + hi); // midpoint
+            if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < u) lo = mid; else hi = mid; // keep the half containing u
+        } // end for
+        return 0.5 * (lo + hi); // return the quantile
+    }
+
+    static const std::vector<double>& priceQuantiles() { // per item log normal quantiles so sampling needs no exp or log
+        static const std::vector<double> table = [] { // built once on first use
+            std::vector<double> t(kItemPrices.size() * (kPriceSteps + 1)); // one row of kPriceSteps + 1 points per item
+            for (int k = 0; k <= kPriceSteps; ++k) { // each quantile step
+                double z = normalQuantile((k + 0.5) / (kPriceSteps + 1)); // standard normal quantile at the step midpoint
+                for (std::size_t i = 0; i < kItemPrices.size(); ++i) t[i * (kPriceSteps + 1) + k] = kItemPrices[i].median * std::exp(kItemPrices[i].sigma * z); // scale into a price
+            } // end for
+            return t; // return filled table
+        }(); // end table builder
+        return table; // return shared table
+    }
+
+    static std::vector<double> shuffledZipf(std::size_t n, double exponent, std::mt19937_64& rng) { // Zipf weights over a random ranking
+        std::vector<double> w = ZipfWeights(n, exponent); // weights by rank
+        std::shuffle(w.begin(), w.end(), rng); // each customer ranks the names differently
+        return w; // return per customer weights
+    }
+
+    DataGen::DataGen(uint64_t seed) : rng(seed), m_prices(priceQuantiles().data()), m_unit(0.0, 1.0) { // constructor initializes random generator and profile from seed
+        std::uniform_int_distribution<int> dc(0, static_cast<int>(kCities.size() - 1)); // random home city
+        std::uniform_int_distribution<int> de(0, static_cast<int>(kEmployers.size() - 1)); // random employer
+        std::uniform_real_distribution<double> dpay(950.0, 2450.0); // typical paycheck range
+        m_profile.homeCity = dc(rng); // customer lives in one city
+        m_profile.employer = de(rng); // customer works for one employer
+        m_profile.paycheckBase = dpay(rng); // customer earns a steady amount
+        std::vector<double> cityWeights = shuffledZipf(kCities.size(), 1.5, rng); // occasional travel follows a steep curve
+        double away = 0.0; // weight of every other city combined
+        for (std::size_t i = 0; i < cityWeights.size(); ++i) if (static_cast<int>(i) != m_profile.homeCity) away += cityWeights[i]; // total travel weight
+        cityWeights[m_profile.homeCity] = away * 4.0; // about four in five purchases happen at home
+        m_profile.cities = AliasTable(cityWeights); // precompute city sampling
+        m_profile.stores = AliasTable(shuffledZipf(kStores.size(), 1.1, rng)); // a few favourite stores dominate
+        m_profile.items = AliasTable(shuffledZipf(kItems.size(), 0.9, rng)); // a few staple items dominate
+    }
+
+    const SpendingProfile& DataGen::profile() const { // expose habits for reporting
+        return m_profile; // return profile
+    }
+
+    void DataGen::randomPurchase(FinEvent& e, const std::string& date) { // fill a random purchase event
+        std::size_t item = m_profile.items.sample(rng); // pick an item by preference
+        const double* row = m_prices + item * (kPriceSteps + 1); // quantile row for that item
+        uint64_t r = rng(); // top bits choose the step, the rest interpolate within it
+        std::size_t step = static_cast<std::size_t>(r >> 56); // one of kPriceSteps steps
+        double frac = static_cast<double>(r & 0x00FFFFFFFFFFFFFFull) * (1.0 / 72057594037927936.0); // position inside the step
+        double amount = row[step] + (row[step + 1] - row[step]) * frac; // log normal price by inverse CDF lookup
         e.kind = FinEvent::Kind::Purchase; // mark as purchase
-        e.date = randomDateInPastMonths(std::uniform_int_distribution<int>(0, 2)(rng)); // assign a random recent date
-        e.store = kStores[ds(rng)]; // assign a random store
-        e.location = kCities[dc(rng)]; // assign a random city
-        e.item = kItems[di(rng)]; // assign a random item
-        e.amount = std::round(damt(rng) * 100.0) / 100.0; // round price to two decimals
-        return e; // return purchase event
-    }
-
-    FinEvent DataGen::randomPaycheck() { // generate random paycheck event
-        std::uniform_int_distribution<int> de(0, static_cast<int>(kEmployers.size() - 1)); // random employer index
-        std::uniform_real_distribution<double> damt(950.0, 2450.0); // random paycheck amount
-        FinEvent e; // create event
+        e.date = date; // assign the day chosen by the caller
+        e.store = kStores[m_profile.stores.sample(rng)]; // assign a preferred store
+        e.location = kCities[m_profile.cities.sample(rng)]; // assign a mostly home city
+        e.item = kItems[item]; // assign the chosen item
+        e.amount = std::round(std::min(2500.0, std::max(1.0, amount)) * 100.0) / 100.0; // clamp outliers and round to two decimals
+    }
+
+    void DataGen::randomPaycheck(FinEvent& e, const std::string& date) { // fill a random paycheck event
+        double amount = m_profile.paycheckBase * (0.97 + 0.06 * m_unit(rng)); // small variation around the usual paycheck
         e.kind = FinEvent::Kind::Paycheck; // mark as paycheck
-        e.date = randomDateInPastMonths(std::uniform_int_distribution<int>(0, 2)(rng)); // assign random recent date
-        e.store = kEmployers[de(rng)]; // assign employer name
+        e.date = date; // assign the day chosen by the caller
+        e.store = kEmployers[m_profile.employer]; // assign employer name
         e.location = "Payroll"; // location labeled as payroll
         e.item = "Direct deposit"; // describe transaction type
-        e.amount = std::round(damt(rng) * 100.0) / 100.0; // round amount to two decimals
-        return e; // return paycheck event
-    }
-
-    std::vector<FinEvent> DataGen::generateQuarterHistory(int purchasesPerMonth, int paychecksPerMonth) { // build three months of events
-        std::vector<FinEvent> out; // vector to store events
-        out.reserve(purchasesPerMonth * 3 + paychecksPerMonth * 3); // preallocate memory for performance
-        for (int m = 0; m < 3; ++m) { // loop for each month
-            for (int i = 0; i < purchasesPerMonth; ++i) { // generate purchase events
-                FinEvent e = randomPurchase(); // create purchase
-                e.date = randomDateInPastMonths(m); // assign date for current month offset
-                out.push_back(std::move(e)); // add purchase to vector
+        e.amount = std::round(amount * 100.0) / 100.0; // round amount to two decimals
+    }
+
+    FinEventStream DataGen::stream(int months, int purchasesPerMonth, int paychecksPerMonth) { // build a stream over this generator
+        return FinEventStream(*this, months, purchasesPerMonth, paychecksPerMonth); // stream borrows the generator
+    }
+
+    FinEventStream DataGen::stream(const CalendarContext& cal, int months, int purchasesPerMonth, int paychecksPerMonth) { // build a stream with a shared calendar
+        return FinEventStream(*this, cal, months, purchasesPerMonth, paychecksPerMonth); // stream borrows the generator
+    }
+
+    FinEventList DataGen::generateQuarterHistory(int purchasesPerMonth, int paychecksPerMonth, std::pmr::memory_resource* mem) { // build three months of events
+        return generateQuarterHistory(CalendarContext::Now(), purchasesPerMonth, paychecksPerMonth, mem); // capture the calendar once for the whole run
+    }
+
+    FinEventList DataGen::generateQuarterHistory(const CalendarContext& cal, int purchasesPerMonth, int paychecksPerMonth, std::pmr::memory_resource* mem) { // build three months of events
+        FinEventList out(mem); // vector to store events, on the caller's resource
+        out.reserve(purchasesPerMonth * 3 + paychecksPerMonth * 3 + 1); // preallocate memory for performance, plus the slot the exhausted stream leaves empty
+        FinEventStream events(*this, cal, 3, purchasesPerMonth, paychecksPerMonth); // stream already yields events in date order
+        while (events.next(out.emplace_back())) {} // fill each slot in place, its strings already use mem
+        out.pop_back(); // the slot the exhausted stream left empty
+        std::reverse(out.begin(), out.end()); // newest first like the rest of the finance views expect
+        return out; // return completed history
+    }
+
+    std::unique_ptr<FinBatch> DataGen::generateQuarterBatch(int purchasesPerMonth, int paychecksPerMonth) { // history plus its arena
+        auto batch = std::make_unique<FinBatch>(); // fresh arena
+        batch->events() = generateQuarterHistory(purchasesPerMonth, paychecksPerMonth, batch->resource()); // same resource, so the move keeps the buffer
+        return batch; // ready to publish
+    }
+
+    FinEventStream::FinEventStream(DataGen& gen, int months, int purchasesPerMonth, int paychecksPerMonth) // prepare stream state
+        : FinEventStream(gen, CalendarContext::Now(), months, purchasesPerMonth, paychecksPerMonth) { // read the clock once per stream
+    }
+
+    FinEventStream::FinEventStream(DataGen& gen, const CalendarContext& cal, int months, int purchasesPerMonth, int paychecksPerMonth) // prepare stream state
+        : m_gen(gen), m_monthsLeft(std::max(0, months)), m_purchasesPerMonth(std::max(0, purchasesPerMonth)), m_paychecksPerMonth(std::max(0, paychecksPerMonth)), m_today(0), m_day(0) { // clamp negative sizes to empty
+        m_today = cal.monthStart(m_monthsLeft > 0 ? m_monthsLeft - 1 : 0); // start with the oldest month in range
+        m_date.resize(kDateTextLength); // date text buffer is reused for every day
+        if (m_monthsLeft > 0) beginMonth(); // lay out the first month
+    }
+
+    void FinEventStream::beginMonth() { // distribute a month's events over its days
+        std::uniform_int_distribution<int> dday(0, static_cast<int>(m_purchasesLeft.size() - 1)); // random day index
+        m_purchasesLeft.fill(0); // reset purchase counters
+        m_paychecksLeft.fill(0); // reset paycheck counters
+        for (int i = 0; i < m_purchasesPerMonth; ++i) ++m_purchasesLeft[dday(m_gen.rng)]; // pick a day for each purchase
+        for (int j = 0; j < m_paychecksPerMonth; ++j) ++m_paychecksLeft[dday(m_gen.rng)]; // pick a day for each paycheck
+        m_day = 0; // start at the first day
+        FormatDate(m_today, &m_date[0]); // date of the first day
+    }
+
+    bool FinEventStream::next(FinEvent& out) { // produce the next event in date order
+        while (m_monthsLeft > 0) { // keep going while months remain
+            if (m_purchasesLeft[m_day] > 0) { // purchases left on this day
+                --m_purchasesLeft[m_day]; // consume one
+                m_gen.randomPurchase(out, m_date); // fill the caller's event
+                return true; // event produced
             }
-            for (int j = 0; j < paychecksPerMonth; ++j) { // generate paycheck events
-                FinEvent p = randomPaycheck(); // create paycheck
-                p.date = randomDateInPastMonths(m); // assign date for current month offset
-                out.push_back(std::move(p)); // add paycheck to vector
+            if (m_paychecksLeft[m_day] > 0) { // paychecks left on this day
+                --m_paychecksLeft[m_day]; // consume one
+                m_gen.randomPaycheck(out, m_date); // fill the caller's event
+                return true; // event produced
             }
+            if (++m_day < static_cast<int>(m_purchasesLeft.size())) { // advance to the next day
+                ++m_today; // day lives in the low bits and never passes 28 here
+                FormatDate(m_today, &m_date[0]); // format once per day
+                continue; // emit that day's events
+            }
+            if (--m_monthsLeft == 0) break; // last month finished
+            m_today = DateMonth(m_today) == 12 ? PackDate(DateYear(m_today) + 1, 1, 1) : PackDate(DateYear(m_today), DateMonth(m_today) + 1, 1); // roll over into the next month
+            beginMonth(); // lay out the next month
         }
-        std::stable_sort(out.begin(), out.end(), [](const FinEvent& a, const FinEvent& b) { return a.date > b.date; }); // sort events by descending date
-        return out; // return completed history
+        return false; // stream exhausted
+    }
+
+    bool FinEventStream::done() const { // check for exhaustion
+        return m_monthsLeft == 0; // nothing left to emit
     }
 
 }
\ No newline at end of file
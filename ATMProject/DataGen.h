@@ -1,22 +1,65 @@
 #pragma once // prevent multiple inclusion of this header file
 #include <vector> // include vector for dynamic arrays
 #include <string> // include string class
+#include <array> // include fixed size array for per day counters
 #include <random> // include random number generation utilities
 #include <chrono> // include time utilities for seeding
+#include <memory> // include unique_ptr for generated batches
 #include "Finance.h" // include finance definitions for FinEvent
+#include "AliasTable.h" // include alias tables for weighted sampling
+#include "Calendar.h" // include packed dates and calendar context
 
 namespace atmapp { // begin atmapp namespace
 
+    class DataGen; // forward declaration so the stream can refer to its generator
+
+    class FinEventStream { // pull based generator that yields events oldest first in constant memory
+    public: // public interface
+        FinEventStream(DataGen& gen, int months, int purchasesPerMonth, int paychecksPerMonth); // prepare a stream ending with the current month
+        FinEventStream(DataGen& gen, const CalendarContext& cal, int months, int purchasesPerMonth, int paychecksPerMonth); // prepare a stream ending with the month in cal
+        bool next(FinEvent& out); // write the next event into out, return false once the stream is exhausted
+        bool done() const; // check whether every month has been emitted
+
+    private: // private members
+        void beginMonth(); // spread the current month's events across its days
+        DataGen& m_gen; // generator supplying randomness and event details
+        int m_monthsLeft; // months still to emit including the current one
+        int m_purchasesPerMonth; // purchases generated in each month
+        int m_paychecksPerMonth; // paychecks generated in each month
+        PackedDate m_today; // calendar day being emitted
+        int m_day; // day index being emitted within the month
+        std::array<int, 28> m_purchasesLeft{}; // purchases still to emit for each day of the month
+        std::array<int, 28> m_paychecksLeft{}; // paychecks still to emit for each day of the month
+        std::string m_date; // formatted date shared by every event of the current day
+    }; // end of class
+
+    struct SpendingProfile { // per customer habits drawn once when a generator is seeded
+        int homeCity; // index of the city most purchases happen in
+        int employer; // index of the employer issuing paychecks
+        double paycheckBase; // typical paycheck size before small variation
+        AliasTable stores; // skewed store preference
+        AliasTable cities; // home city heavy location preference
+        AliasTable items; // skewed item preference
+    }; // end of SpendingProfile struct
+
     class DataGen { // define the DataGen class
     public: // public interface
         explicit DataGen(uint64_t seed = std::chrono::high_resolution_clock::now().time_since_epoch().count()); // constructor with optional seed defaulting to current time
-        std::vector<FinEvent> generateQuarterHistory(int purchasesPerMonth, int paychecksPerMonth); // create three months of random purchase and paycheck history
+        FinEventList generateQuarterHistory(int purchasesPerMonth, int paychecksPerMonth, std::pmr::memory_resource* mem = std::pmr::get_default_resource()); // create three months of random purchase and paycheck history, events and strings on mem
+        FinEventList generateQuarterHistory(const CalendarContext& cal, int purchasesPerMonth, int paychecksPerMonth, std::pmr::memory_resource* mem = std::pmr::get_default_resource()); // same, reusing a calendar captured by the caller
+        std::unique_ptr<FinBatch> generateQuarterBatch(int purchasesPerMonth, int paychecksPerMonth); // same history in its own arena, ready for FinanceLog::set
+        FinEventStream stream(int months, int purchasesPerMonth, int paychecksPerMonth); // stream any number of months without buffering them
+        FinEventStream stream(const CalendarContext& cal, int months, int purchasesPerMonth, int paychecksPerMonth); // same, reusing a calendar captured by the caller
+        const SpendingProfile& profile() const; // habits this generator samples from
 
     private: // private members
+        friend class FinEventStream; // stream draws days and events from this generator
         std::mt19937_64 rng; // 64-bit random number generator
-        std::string randomDateInPastMonths(int monthsBack); // helper function to make a random date string
-        FinEvent randomPurchase(); // helper to generate random purchase event
-        FinEvent randomPaycheck(); // helper to generate random paycheck event
+        SpendingProfile m_profile; // customer habits built from the seed
+        const double* m_prices; // shared table of per item log normal price quantiles
+        std::uniform_real_distribution<double> m_unit; // uniform draw in [0, 1) for paycheck variation
+        void randomPurchase(FinEvent& e, const std::string& date); // helper to fill a random purchase event
+        void randomPaycheck(FinEvent& e, const std::string& date); // helper to fill a random paycheck event
     }; // end of class
 
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "Epoch.h" // include header for epoch based reclamation
+#include <atomic> // include epoch counter and reader slots
+#include <functional> // include hash for the starting slot
+#include <thread> // include thread ids and yield
+
+namespace atmapp { // begin atmapp namespace
+
+    struct alignas(64) EpochSlot { // one reader's pinned epoch on its own cache line
+        std::atomic<uint64_t> pinned{ 0 }; // epoch seen when the pin was taken, zero when free
+    }; // end of EpochSlot struct
+
+    static EpochSlot g_epochSlots[kEpochSlots]; // every reader slot
+    static std::atomic<uint64_t> g_epoch{ 1 }; // current epoch, zero is reserved for free slots
+    static thread_local std::size_t t_epochHint = std::hash<std::thread::id>()(std::this_thread::get_id()) % kEpochSlots; // slot this thread tries first
+
+    EpochPin::EpochPin() { // claim a free slot
+        std::size_t i = t_epochHint; // usually free, the last slot this thread used
+        for (;;) { // until a slot is claimed
+            uint64_t idle = 0; // expected value of a free slot
+            uint64_t epoch = g_epoch.load(std::memory_order_seq_cst); // read before the claim, so the pin can only be older than the truth
+            if (g_epochSlots[i].pinned.compare_exchange_strong(idle, epoch, std::memory_order_seq_cst)) break; // claimed, ordered before any pointer load
+            i = (i + 1) % kEpochSlots; // try the next slot
+            if (i == t_epochHint) std::this_thread::yield(); // every slot busy, let a reader finish
+        } // end for
+        m_slot = i; // remember for release
+        t_epochHint = i; // start here next time
+    } // end constructor
+
+    EpochPin::~EpochPin() { // release the slot
+        g_epochSlots[m_slot].pinned.store(0, std::memory_order_release); // every load made under the pin is finished
+    } // end destructor
+
+    uint64_t RetireEpoch() { // new epoch after an unlink
+        return g_epoch.fetch_add(1, std::memory_order_seq_cst) + 1; // pins taken from now on see the new pointer
+    } // end RetireEpoch
+
+    bool EpochReclaimable(uint64_t retired) { // no reader older than the tag is left
+        for (const auto& s : g_epochSlots) { // every reader slot
+            uint64_t pinned = s.pinned.load(std::memory_order_seq_cst); // pinned epoch or zero
+            if (pinned != 0 && pinned < retired) return false; // pinned before the unlink, may still hold the old pointer
+        } // end for
+        return true; // safe to free
+    } // end EpochReclaimable
+
+}
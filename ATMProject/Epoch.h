@@ -0,0 +1,28 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <cstddef> // include size_t
+#include <cstdint> // include fixed width integer types
+
+namespace atmapp { // begin atmapp namespace
+
+    const std::size_t kEpochSlots = 128; // readers that can hold a pin at the same moment, more simply wait for a free slot
+
+    // Epoch based reclamation for structures that publish a new version by swapping one pointer.
+    // A reader pins the current epoch, loads the pointer and uses it until the pin ends.
+    // A writer swaps the pointer, tags the old target with RetireEpoch() and frees it once EpochReclaimable says
+    // every reader that could have loaded it has unpinned. Readers never take a lock or wait on a writer.
+
+    class EpochPin { // while alive, nothing retired after the pin was taken is freed
+    public: // public interface
+        EpochPin(); // claim a reader slot holding the current epoch
+        ~EpochPin(); // release the slot
+        EpochPin(const EpochPin&) = delete; // a pin belongs to one scope
+        EpochPin& operator=(const EpochPin&) = delete; // a pin belongs to one scope
+
+    private: // internal data
+        std::size_t m_slot; // claimed reader slot
+    }; // end of EpochPin class
+
+    uint64_t RetireEpoch(); // start a new epoch after unlinking a pointer, return the tag for the unlinked target
+    bool EpochReclaimable(uint64_t retired); // whether every reader pinned before the tag was issued has unpinned
+
+}
@@ -1,54 +1,280 @@
 #include "Finance.h" // include header for FinanceLog and FinEvent
+#include "Format.h" // include row formatter
+#include "FinanceFile.h" // include columnar history file
+#include "PackedHistory.h" // include compressed in memory history
+#include "Epoch.h" // include reader pins for published versions
 #include <iostream> // include input and output stream library
 #include <algorithm> // include standard algorithms
 #include <numeric> // include numeric operations for sums
+#include <new> // include placement new for the list inside a batch arena
 
 namespace atmapp { // begin atmapp namespace
 
-    void FinanceLog::set(std::vector<FinEvent> events) { // set new list of financial events
-        m_events = std::move(events); // move provided events into internal storage
+    FinBatch::FinBatch(std::size_t firstChunk, std::pmr::memory_resource* upstream) : m_chunks(upstream), m_arena(firstChunk, &m_chunks), m_events(nullptr) { // arena first, then the list inside it
+        m_events = new (m_arena.allocate(sizeof(FinEventList), alignof(FinEventList))) FinEventList(&m_arena); // list header in the arena too
+    } // end constructor
+
+    struct FinanceLog::Version { // never changed after publication except for the one time copy behind all()
+        struct Copy { FinEventList events; MemoryUsage usage; }; // owned rows of a mapped or packed version and their footprint
+        FinEventList events; // in memory list
+        std::unique_ptr<FinBatch> batch; // generated list and its arena, used instead of events when set
+        std::shared_ptr<const FinanceFile> file; // mapped history, null for a list
+        std::shared_ptr<const PackedHistory> packed; // compressed history, null for a list
+        mutable std::atomic<const Copy*> copy{ nullptr }; // made by the first all() of a mapped or packed version
+        MemoryUsage usage; // footprint of the list or packed form, measured before publication
+        int months = 1; // calendar months between the oldest and newest dated event
+        double income = 0.0; // monthly paycheck estimate
+        double spend = 0.0; // monthly purchase estimate
+        ~Version() { delete copy.load(); } // the copy goes with the version
+        bool inPlace() const { return file || packed; } // rows are read from a backend rather than the list
+        const FinEventList& list() const { return batch ? batch->events() : events; } // in memory rows
+    }; // end of Version struct
+
+    static void scanVersion(const FinEventList& events, const FinanceFile* file, const PackedHistory* packed, PackedDate from, PackedDate to, bool (*fn)(const FinRow&, void*), void* ctx) { // walk one version's rows in range
+        if (packed) { packed->scan(from, to, fn, ctx); return; } // skip headers skip whole blocks
+        if (file) { file->scan(from, to, fn, ctx); return; } // block statistics skip whole blocks
+        for (const auto& e : events) { // in memory list
+            PackedDate d = 0; // parsed date
+            ParseDate(e.date.data(), e.date.size(), d); // text date
+            if (d < from || d > to) continue; // outside the range
+            if (!fn(FinRow{ e.kind, d, ToCents(e.amount), e.store, e.location, e.item }, ctx)) return; // caller is done
+        } // end for
+    } // end scanVersion
+
+    template <typename V, typename Fn> static void forEachRow(const V& v, Fn&& fn) { // every row of a pinned version newest first
+        scanVersion(v.list(), v.file.get(), v.packed.get(), 0, 0xFFFFFFFFu, [](const FinRow& r, void* ctx) { return static_cast<bool>((*static_cast<std::remove_reference_t<Fn>*>(ctx))(r)); }, &fn); // type erased call
+    } // end forEachRow
+
+    static MemoryUsage listUsage(const FinEventList& events, const FinBatch* batch) { // FinEvent slots and their strings
+        MemoryUsage u; // result
+        u.items = events.size(); // events
+        AddVector(u, events); // list slots
+        for (const auto& e : events) { AddString(u, e.date); AddString(u, e.store); AddString(u, e.location); AddString(u, e.item); } // text that outgrew the inline buffers
+        if (batch) { // everything sits in the arena
+            uint64_t walked = u.bytes(); // what the walk found
+            if (batch->arenaBytes() > walked) u.slackBytes += batch->arenaBytes() - walked; // chunk tails and list buffers left behind by growth
+            u.allocations = batch->arenaChunks(); // the arena's blocks, not one per string
+        } // end if
+        return u; // total
+    } // end listUsage
+
+    template <typename V> static int monthsOf(const V& v) { // calendar months a version covers, the divisor of both estimates
+        PackedDate first = 0xFFFFFFFFu, last = 0; // oldest and newest dated event
+        bool headers = v.inPlace(); // block statistics answer it without reading rows
+        std::size_t blocks = v.packed ? v.packed->blocks() : v.file ? v.file->blocks() : 0; // blocks to check
+        for (std::size_t b = 0; headers && b < blocks; ++b) { // min and max of every block
+            PackedDate lo = v.packed ? v.packed->block(b).minDate : v.file->block(b).minDate; // oldest in the block
+            PackedDate hi = v.packed ? v.packed->block(b).maxDate : v.file->block(b).maxDate; // newest in the block
+            if (lo == 0) headers = false; // a malformed date hides the real minimum, read the rows instead
+            first = std::min(first, lo); last = std::max(last, hi); // running span
+        } // end for
+        if (!headers) { // list, or a block with a malformed date
+            first = 0xFFFFFFFFu; last = 0; // start over
+            forEachRow(v, [&](const FinRow& r) { if (r.date != 0) { first = std::min(first, r.date); last = std::max(last, r.date); } return true; }); // malformed dates are zero and say nothing about the span
+        } // end if
+        return MonthSpan(first, last); // imported statements can cover any number of months
+    } // end monthsOf
+
+    template <typename V> static double kindTotal(const V& v, FinEvent::Kind kind) { // dollars of one kind in a version
+        if (v.packed) return static_cast<double>(v.packed->totalCents(kind)) / 100.0; // block totals from the skip headers
+        if (v.file) return static_cast<double>(v.file->totalCents(kind)) / 100.0; // column sum over the mapped file
+        double sum = 0.0; // total accumulator
+        for (const auto& e : v.list()) if (e.kind == kind) sum += e.amount; // add up amounts of that kind
+        return sum; // total
+    } // end kindTotal
+
+    template <typename V> static void prepare(V& v) { // fill the read caches of a version before it is published, so readers never wait on them
+        v.usage = listUsage(v.list(), v.batch.get()); // list, or the part of a batch arena it uses
+        if (v.packed) { MemoryUsage p = v.packed->usage(); v.usage += p; } // packed columns and dictionary
+        if (v.file) v.usage.items = v.file->size(); // a mapped file lives in the page cache and is not counted
+        v.months = monthsOf(v); // span of the history, three for a generated quarter
+        v.income = kindTotal(v, FinEvent::Kind::Paycheck) / v.months; // divide by the months covered to estimate monthly income
+        v.spend = kindTotal(v, FinEvent::Kind::Purchase) / v.months; // divide by the months covered to estimate monthly spending
+    } // end prepare
+
+    FinanceLog::FinanceLog() : m_current(new Version()) { // empty list
+    } // end constructor
+
+    FinanceLog::~FinanceLog() { // free every version
+        delete m_current.load(); // current
+        for (const auto& r : m_retired) delete r.second; // and any still waiting
+    } // end destructor
+
+    void FinanceLog::publish(Version* next) { // caller holds m_writeLock
+        const Version* old = m_current.exchange(next, std::memory_order_seq_cst); // readers pinned from now on see the new version
+        m_retired.emplace_back(RetireEpoch(), old); // free once older readers are gone
+        std::size_t kept = 0; // versions still in use
+        for (const auto& r : m_retired) { // free what no reader can hold
+            if (EpochReclaimable(r.first)) delete r.second; // quiescent
+            else m_retired[kept++] = r; // try again on the next publish
+        } // end for
+        m_retired.resize(kept); // drop freed entries
+    } // end publish
+
+    void FinanceLog::set(FinEventList events) { // set new list of financial events
+        auto next = new Version(); // built before the swap, readers never see it half filled
+        next->events = std::move(events); // move provided events into the new version
+        prepare(*next); // caches filled outside the write lock
+        std::lock_guard<std::mutex> guard(m_writeLock); // one writer at a time
+        publish(next); // the list replaces any mapped file or packed form
+    } // end set
+
+    void FinanceLog::set(std::unique_ptr<FinBatch> batch) { // publish a generated batch
+        auto next = new Version(); // built before the swap
+        next->batch = std::move(batch); // rows stay in the batch arena
+        prepare(*next); // caches filled outside the write lock
+        std::lock_guard<std::mutex> guard(m_writeLock); // one writer at a time
+        publish(next); // the batch replaces any list, mapped file or packed form
     } // end set
 
     void FinanceLog::clear() { // remove all stored financial events
-        m_events.clear(); // clear internal vector
+        std::lock_guard<std::mutex> guard(m_writeLock); // one writer at a time
+        publish(new Version()); // empty list
     } // end clear
 
-    const std::vector<FinEvent>& FinanceLog::all() const { // return read-only reference to all events
-        return m_events; // return event list
+    FinanceLog::Snapshot::Snapshot(const FinanceLog& log) // pin first, the member order guarantees it
+        : m_events(&eventsOf(*log.m_current.load(std::memory_order_seq_cst))) {} // current version, held until the pin ends
+
+    FinanceLog::Snapshot FinanceLog::all() const { // pinned read-only view of all events
+        return Snapshot(*this); // the caller keeps the version alive by keeping the snapshot
     } // end all
 
+    const FinEventList& FinanceLog::eventsOf(const Version& v) { // caller holds a pin on v
+        if (!v.inPlace()) return v.list(); // return event list
+        const Version::Copy* done = v.copy.load(std::memory_order_acquire); // copy made by an earlier call
+        if (done) return done->events; // reuse it
+        auto mine = std::make_unique<Version::Copy>(); // readers racing for the first copy each build one instead of waiting
+        mine->events.reserve(v.file ? v.file->size() : v.packed->size()); // one allocation
+        forEachRow(v, [&](const FinRow& r) { // every row in order
+            mine->events.emplace_back(r.kind, DateString(r.date), r.store, r.location, r.item, static_cast<double>(r.cents) / 100.0); // owned copy
+            return true; // keep going
+        }); // end forEachRow
+        mine->usage = listUsage(mine->events, nullptr); mine->usage.items = 0; // same events, counted once
+        if (v.copy.compare_exchange_strong(done, mine.get(), std::memory_order_acq_rel, std::memory_order_acquire)) return mine.release()->events; // first to finish publishes its copy
+        return done->events; // another reader finished first, ours is dropped
+    } // end eventsOf
+
+    bool FinanceLog::open(const std::string& path, std::string& error) { // attach a history file
+        auto file = std::make_shared<FinanceFile>(); // new mapping
+        if (!file->open(path, error)) return false; // keep the current history on failure
+        auto next = new Version(); // rows now live in the file
+        next->file = std::move(file); // attach
+        prepare(*next); // estimates read the file's columns once here
+        std::lock_guard<std::mutex> guard(m_writeLock); // one writer at a time
+        publish(next); // the file replaces the list or any packed form
+        return true; // opened
+    } // end open
+
+    bool FinanceLog::save(const std::string& path, std::string& error) const { // write a history file
+        Snapshot snapshot = all(); // one pinned version for the whole write
+        return WriteFinanceFile(path, snapshot.events(), error); // columnar layout
+    } // end save
+
+    bool FinanceLog::mapped() const { // file backend check
+        EpochPin pin; // hold the version while it is read
+        return m_current.load(std::memory_order_seq_cst)->file != nullptr; // current version
+    } // end mapped
+
+    bool FinanceLog::compressed() const { // packed backend check
+        EpochPin pin; // hold the version while it is read
+        return m_current.load(std::memory_order_seq_cst)->packed != nullptr; // current version
+    } // end compressed
+
+    void FinanceLog::compress() { // switch to the bit packed backend
+        std::lock_guard<std::mutex> guard(m_writeLock); // no other writer can replace the version being encoded
+        auto packed = std::make_shared<PackedHistory>(); // new encoding
+        forEachRow(*m_current.load(std::memory_order_seq_cst), [&](const FinRow& r) { packed->append(r); return true; }); // every row from the current version, only writers free versions
+        packed->seal(); // encode the tail block
+        auto next = new Version(); // no event list
+        next->packed = std::move(packed); // attach
+        prepare(*next); // estimates come from the skip headers
+        publish(next); // the old list and its strings go once readers are done
+    } // end compress
+
+    std::size_t FinanceLog::size() const { // event count without copying a mapped file
+        EpochPin pin; // hold the version while it is read
+        const Version& v = *m_current.load(std::memory_order_seq_cst); // current version
+        if (v.packed) return v.packed->size(); // packed rows
+        return v.file ? v.file->size() : v.list().size(); // file or list
+    } // end size
+
+    std::size_t FinanceLog::memoryBytes() const { // heap footprint of the current version
+        return static_cast<std::size_t>(memoryUsage().bytes()); // sum of the parts
+    } // end memoryBytes
+
+    MemoryUsage FinanceLog::memoryUsage() const { // footprint of the current version
+        EpochPin pin; // hold the version while it is read
+        const Version& v = *m_current.load(std::memory_order_seq_cst); // current version
+        MemoryUsage u = v.usage; // measured before publication
+        if (const Version::Copy* c = v.copy.load(std::memory_order_acquire)) u += c->usage; // a copy made by all(), measured by its builder
+        return u; // footprint
+    } // end memoryUsage
+
+    std::size_t FinanceLog::retiredVersions() const { // versions waiting on readers
+        std::lock_guard<std::mutex> guard(m_writeLock); // guards m_retired
+        return m_retired.size(); // count
+    } // end retiredVersions
+
+    void FinanceLog::scan(PackedDate from, PackedDate to, bool (*fn)(const FinRow&, void*), void* ctx) const { // walk rows in range
+        EpochPin pin; // hold the version for the whole walk
+        const Version& v = *m_current.load(std::memory_order_seq_cst); // current version
+        scanVersion(v.list(), v.file.get(), v.packed.get(), from, to, fn, ctx); // same rows for the whole walk even if a writer publishes meanwhile
+    } // end scan
+
     void FinanceLog::printPurchases(std::ostream& out, int limit) const { // display purchase transactions up to limit
+        EpochPin pin; // one version for the whole listing
+        const Version& v = *m_current.load(std::memory_order_seq_cst); // current version
         int shown = 0; // counter for printed entries
-        out << "\nAssistant. Here are recent card purchases.\n"; // header message
-        for (const auto& e : m_events) { // iterate through stored events
+        RowBuffer rows(out); // rows are built in one buffer and written in large blocks
+        rows.text("\nAssistant. Here are recent card purchases.\n"); // header message
+        if (v.inPlace()) { // mapped or packed history, rows are read in place
+            forEachRow(v, [&](const FinRow& r) { // every date
+                if (r.kind != FinEvent::Kind::Purchase) return true; // skip non-purchase entries
+                rows.ch(' ').date(r.date).text("  $").cents(r.cents).text("  ").text(r.store).text("  ").text(r.location).text("  ").text(r.item).ch('\n'); // print purchase details
+                rows.endRow(); // write once the buffer is large
+                return ++shown < limit; // stop if limit reached
+            }); // end forEachRow
+        } // end if
+        else for (const auto& e : v.list()) { // iterate through stored events
             if (e.kind != FinEvent::Kind::Purchase) continue; // skip non-purchase entries
-            out << " " << e.date << "  $" << e.amount << "  " << e.store << "  " << e.location << "  " << e.item << "\n"; // print purchase details
+            rows.ch(' ').text(e.date).text("  $").money(e.amount).text("  ").text(e.store).text("  ").text(e.location).text("  ").text(e.item).ch('\n'); // print purchase details
+            rows.endRow(); // write once the buffer is large
             if (++shown >= limit) break; // stop if limit reached
         } // end for
-        if (shown == 0) out << " No purchases found.\n"; // message when no purchases exist
+        if (shown == 0) rows.text(" No purchases found.\n"); // message when no purchases exist
     } // end printPurchases
 
     void FinanceLog::printPaychecks(std::ostream& out, int limit) const { // display paycheck transactions up to limit
+        EpochPin pin; // one version for the whole listing
+        const Version& v = *m_current.load(std::memory_order_seq_cst); // current version
         int shown = 0; // counter for printed entries
-        out << "\nAssistant. Here are recent paychecks.\n"; // header message
-        for (const auto& e : m_events) { // iterate through stored events
+        RowBuffer rows(out); // rows are built in one buffer and written in large blocks
+        rows.text("\nAssistant. Here are recent paychecks.\n"); // header message
+        if (v.inPlace()) { // mapped or packed history, rows are read in place
+            forEachRow(v, [&](const FinRow& r) { // every date
+                if (r.kind != FinEvent::Kind::Paycheck) return true; // skip non-paycheck entries
+                rows.ch(' ').date(r.date).text("  $").cents(r.cents).text("  ").text(r.store).text("  ").text(r.location).ch('\n'); // print paycheck details
+                rows.endRow(); // write once the buffer is large
+                return ++shown < limit; // stop if limit reached
+            }); // end forEachRow
+        } // end if
+        else for (const auto& e : v.list()) { // iterate through stored events
             if (e.kind != FinEvent::Kind::Paycheck) continue; // skip non-paycheck entries
-            out << " " << e.date << "  $" << e.amount << "  " << e.store << "  " << e.location << "\n"; // print paycheck details
+            rows.ch(' ').text(e.date).text("  $").money(e.amount).text("  ").text(e.store).text("  ").text(e.location).ch('\n'); // print paycheck details
+            rows.endRow(); // write once the buffer is large
             if (++shown >= limit) break; // stop if limit reached
         } // end for
-        if (shown == 0) out << " No paychecks found.\n"; // message when no paychecks exist
+        if (shown == 0) rows.text(" No paychecks found.\n"); // message when no paychecks exist
     } // end printPaychecks
 
     double FinanceLog::monthlyIncomeEstimate() const { // estimate average monthly income
-        double sum = 0.0; // total income accumulator
-        for (const auto& e : m_events) if (e.kind == FinEvent::Kind::Paycheck) sum += e.amount; // add up paycheck amounts
-        return sum / 3.0; // divide by three months to estimate monthly income
+        EpochPin pin; // hold the version while it is read
+        return m_current.load(std::memory_order_seq_cst)->income; // computed when the version was built
     } // end monthlyIncomeEstimate
 
     double FinanceLog::monthlySpendEstimate() const { // estimate average monthly spending
-        double sum = 0.0; // total spending accumulator
-        for (const auto& e : m_events) if (e.kind == FinEvent::Kind::Purchase) sum += e.amount; // add up purchase amounts
-        return sum / 3.0; // divide by three months to estimate monthly spending
+        EpochPin pin; // hold the version while it is read
+        return m_current.load(std::memory_order_seq_cst)->spend; // computed when the version was built
     } // end monthlySpendEstimate
 
 }
\ No newline at end of file
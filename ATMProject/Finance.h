@@ -1,32 +1,127 @@
 #pragma once // prevent multiple inclusion of this header file
 #include <string> // include string type
 #include <vector> // include vector container
+#include <string_view> // include string_view for rows read in place
+#include <memory> // include shared_ptr for a mapped history file
+#include <memory_resource> // include pmr resources for event lists and arenas
+#include <atomic> // include the published version pointer
+#include <mutex> // include the writer lock
+#include <utility> // include pair for retired versions
+#include <type_traits> // include remove_reference for the row visitor
+#include <cstdint> // include fixed width integer types
 #include <iosfwd> // forward declare iostream types for efficiency
+#include "Calendar.h" // include packed dates for range queries
+#include "MemoryUsage.h" // include footprint reports and the arena counter
+#include "Epoch.h" // include the reader pin held by a snapshot
 
 namespace atmapp { // begin atmapp namespace
 
     struct FinEvent { // define FinEvent struct for storing financial records
         enum class Kind { Purchase, Paycheck }; // define event types: purchase or paycheck
-        Kind kind; // specify whether the event is a purchase or paycheck
-        std::string date; // date of the event
-        std::string store; // store or employer name
-        std::string location; // location of store or source
-        std::string item; // item name or description
-        double amount; // transaction amount
+        using allocator_type = std::pmr::polymorphic_allocator<char>; // strings come from the resource of the list holding the event
+        Kind kind = Kind::Purchase; // specify whether the event is a purchase or paycheck
+        std::pmr::string date; // date of the event
+        std::pmr::string store; // store or employer name
+        std::pmr::string location; // location of store or source
+        std::pmr::string item; // item name or description
+        double amount = 0.0; // transaction amount
+
+        FinEvent() = default; // empty purchase on the default resource
+        explicit FinEvent(const allocator_type& alloc) : date(alloc), store(alloc), location(alloc), item(alloc) {} // empty purchase on a given resource
+        FinEvent(Kind k, std::string_view d, std::string_view s, std::string_view l, std::string_view i, double a, const allocator_type& alloc = {}) // filled event
+            : kind(k), date(d, alloc), store(s, alloc), location(l, alloc), item(i, alloc), amount(a) {} // copy the text into the resource
+        FinEvent(const FinEvent& o) = default; // copy on the default resource
+        FinEvent(FinEvent&& o) = default; // move, keeping the source's resource
+        FinEvent(const FinEvent& o, const allocator_type& alloc) : kind(o.kind), date(o.date, alloc), store(o.store, alloc), location(o.location, alloc), item(o.item, alloc), amount(o.amount) {} // copy into a list's resource
+        FinEvent(FinEvent&& o, const allocator_type& alloc) : kind(o.kind), date(std::move(o.date), alloc), store(std::move(o.store), alloc), location(std::move(o.location), alloc), item(std::move(o.item), alloc), amount(o.amount) {} // move, copying only across resources
+        FinEvent& operator=(const FinEvent&) = default; // assign, keeping this event's resource
+        FinEvent& operator=(FinEvent&&) = default; // assign, keeping this event's resource
     }; // end of FinEvent struct
 
+    using FinEventList = std::pmr::vector<FinEvent>; // events and their strings on one memory resource, the default heap unless a caller passes an arena
+
+    struct FinRow { // one event viewed in place, no owned strings
+        FinEvent::Kind kind; // purchase or paycheck
+        PackedDate date; // event day
+        int64_t cents; // amount in whole cents
+        std::string_view store; // store or employer name
+        std::string_view location; // location of store or source
+        std::string_view item; // item name or description
+    }; // end of FinRow struct
+
+    class FinBatch { // one generated history and the arena holding every event and string, dropped whole
+    public: // public interface
+        explicit FinBatch(std::size_t firstChunk = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()); // empty list, arena chunks from upstream grow geometrically from firstChunk bytes
+        FinBatch(const FinBatch&) = delete; // the list lives inside the arena
+        FinBatch& operator=(const FinBatch&) = delete; // the list lives inside the arena
+        FinEventList& events() { return *m_events; } // fill through this list, growth stays in the arena
+        const FinEventList& events() const { return *m_events; } // read the list
+        std::pmr::memory_resource* resource() { return &m_arena; } // arena for generators that build a list themselves
+        uint64_t arenaBytes() const { return m_chunks.liveBytes(); } // bytes the arena took from upstream
+        uint64_t arenaChunks() const { return m_chunks.allocations(); } // blocks the arena took from upstream
+
+    private: // internal data
+        MemoryCounter m_chunks; // counts the arena's upstream chunks, declared first so it outlives the arena
+        std::pmr::monotonic_buffer_resource m_arena; // every allocation of the batch, freed chunk by chunk when the batch goes
+        FinEventList* m_events; // constructed inside the arena and never destroyed, nothing it owns lives anywhere else
+    }; // end of FinBatch class
+
+    class FinanceFile; // forward declaration of the columnar history file
+    class PackedHistory; // forward declaration of the compressed in memory history
+
+    // Every history is an immutable version published by swapping one pointer. Readers pin an epoch and use
+    // whichever version is current, so set, open, compress and clear never block them and never change rows under them.
+    // A replaced version is freed once every reader that could have loaded it has unpinned, see Epoch.h.
+
     class FinanceLog { // define FinanceLog class to hold and manage FinEvent records
     public: // public functions
-        void set(std::vector<FinEvent> events); // replace internal list with given events
-        void clear(); // remove all stored events
-        const std::vector<FinEvent>& all() const; // access full list of events
+        FinanceLog(); // empty in memory list
+        ~FinanceLog(); // free the current and every retired version, no reader may be active
+        FinanceLog(const FinanceLog&) = delete; // versions are owned by one log
+        FinanceLog& operator=(const FinanceLog&) = delete; // versions are owned by one log
+
+        class Snapshot { // the events of one version, kept alive by a pin for as long as the snapshot exists
+        public: // public interface
+            const FinEventList& events() const { return *m_events; } // full list, valid while this snapshot lives
+            std::size_t size() const { return m_events->size(); } // events in the version
+            const FinEvent& operator[](std::size_t i) const { return (*m_events)[i]; } // one event
+
+        private: // internal data
+            friend class FinanceLog; // only the log takes snapshots
+            explicit Snapshot(const FinanceLog& log); // pin, then load the current version
+            EpochPin m_pin; // taken before the version is loaded, so the version cannot be freed under the snapshot
+            const FinEventList* m_events; // list or one time copy of the pinned version
+        }; // end of Snapshot class
+
+        void set(FinEventList events); // publish the given events as the new history
+        void set(std::unique_ptr<FinBatch> batch); // publish a generated batch, its arena is released in one step once readers are done
+        void clear(); // publish an empty history
+        Snapshot all() const; // pinned access to the full list of events, copied out of a mapped file or the packed form on first use, valid while the snapshot lives
+        bool open(const std::string& path, std::string& error); // publish a history file queried in place instead of an in memory list
+        bool save(const std::string& path, std::string& error) const; // write the events as a history file
+        bool mapped() const; // whether a history file backs the current version
+        void compress(); // publish the current history re encoded bit packed in memory
+        bool compressed() const; // whether the packed form backs the current version
+        std::size_t memoryBytes() const; // heap bytes held by the current version
+        MemoryUsage memoryUsage() const; // the same bytes split into slots, slack, strings and encoded columns, measured when the version is built
+        std::size_t size() const; // events in the current version
+        std::size_t retiredVersions() const; // replaced versions not yet freed because a reader may still hold them
+        template <typename Fn> void forEach(PackedDate from, PackedDate to, Fn&& fn) const { // visit events dated within [from, to] newest first until fn returns false
+            scan(from, to, [](const FinRow& r, void* ctx) { return static_cast<bool>((*static_cast<std::remove_reference_t<Fn>*>(ctx))(r)); }, const_cast<void*>(static_cast<const void*>(&fn))); // type erased call
+        } // end forEach
         void printPurchases(std::ostream& out, int limit = 25) const; // print recent purchases up to limit
         void printPaychecks(std::ostream& out, int limit = 25) const; // print recent paychecks up to limit
-        double monthlyIncomeEstimate() const; // estimate monthly income from paycheck data
-        double monthlySpendEstimate() const; // estimate monthly spending from purchase data
+        double monthlyIncomeEstimate() const; // estimate monthly income from paycheck data, computed when the version is built
+        double monthlySpendEstimate() const; // estimate monthly spending from purchase data, computed when the version is built
 
     private: // private data members
-        std::vector<FinEvent> m_events; // container for all financial events
+        struct Version; // one complete history, list, mapped file or packed form
+        static const FinEventList& eventsOf(const Version& v); // list of a pinned version, copying rows read in place once
+        void scan(PackedDate from, PackedDate to, bool (*fn)(const FinRow&, void*), void* ctx) const; // shared row walk for every backend
+        void publish(Version* next); // swap in a new version, retire the old one and free retired versions no reader can hold
+        std::atomic<const Version*> m_current; // version readers see, never null
+        mutable std::mutex m_writeLock; // one writer at a time, guards m_retired
+        std::vector<std::pair<uint64_t, const Version*>> m_retired; // replaced versions and the epoch they were retired at
     }; // end of FinanceLog class
 
 }
\ No newline at end of file
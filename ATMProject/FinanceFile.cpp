@@ -0,0 +1,182 @@
+#include "FinanceFile.h" // include header for the columnar history file
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN // skip rarely used Windows headers
+#define NOMINMAX // keep std::min and std::max usable
+#include <windows.h> // include MoveFileExA for the replacing rename
+#endif
+#include "Format.h" // include exact cent rounding
+#include <algorithm> // include min
+#include <cstdio> // include fopen and fwrite
+#include <cstring> // include memcpy and memcmp
+#include <string_view> // include name views for the writer
+#include <unordered_map> // include name to id map for the writer
+
+namespace atmapp { // begin atmapp namespace
+
+    static const char kFinMagic[8] = { 'A', 'T', 'M', 'F', 'I', 'N', 0, 0 }; // file signature
+    static const uint32_t kEndianMark = 0x01020304; // reads back differently on a foreign byte order
+
+    static_assert(sizeof(FinFileHeader) == 64, "history header layout changed"); // on disk size is fixed
+    static_assert(sizeof(FinBlockInfo) == 24, "block index layout changed"); // on disk size is fixed
+
+    static uint64_t align8(uint64_t v) { return (v + 7) & ~static_cast<uint64_t>(7); } // round up to eight bytes
+
+    static uint64_t blockBytes(uint32_t n) { // size of one block's columns
+        return align8(align8(4ull * n) + 21ull * n); // dates padded to eight bytes, then cents, three name ids and kinds
+    } // end blockBytes
+
+    bool WriteFinanceFile(const std::string& path, const FinEventList& events, std::string& error) { // build the whole file in memory, then one write
+        std::unordered_map<std::string_view, uint32_t> ids; // name to dictionary id, viewing the events' own text
+        std::vector<std::string_view> names; // dictionary in id order
+        auto idOf = [&](std::string_view s) { auto ins = ids.emplace(s, static_cast<uint32_t>(names.size())); if (ins.second) names.push_back(s); return ins.first->second; }; // intern
+        uint32_t blocks = static_cast<uint32_t>((events.size() + kFinBlockRows - 1) / kFinBlockRows); // block count
+        std::vector<uint32_t> storeIds(events.size()), cityIds(events.size()), itemIds(events.size()); // interned names
+        for (std::size_t i = 0; i < events.size(); ++i) { storeIds[i] = idOf(events[i].store); cityIds[i] = idOf(events[i].location); itemIds[i] = idOf(events[i].item); } // intern every name
+
+        uint64_t dictBytes = 0; // name text size
+        for (std::string_view n : names) dictBytes += n.size(); // sum lengths
+        FinFileHeader h{}; // header
+        std::memcpy(h.magic, kFinMagic, sizeof(h.magic)); // signature
+        h.version = kFinFileVersion; // layout version
+        h.endian = kEndianMark; // byte order check
+        h.rows = events.size(); // row count
+        h.blockRows = kFinBlockRows; // rows per block
+        h.blocks = blocks; // block count
+        h.names = static_cast<uint32_t>(names.size()); // dictionary size
+        h.dictOffset = sizeof(FinFileHeader); // dictionary follows the header
+        h.indexOffset = align8(h.dictOffset + 4ull * (names.size() + 1) + dictBytes); // block index follows the dictionary
+        uint64_t offset = h.indexOffset + sizeof(FinBlockInfo) * blocks; // first block
+        std::vector<FinBlockInfo> index(blocks); // block statistics
+        for (uint32_t b = 0; b < blocks; ++b) { // size each block
+            uint32_t n = static_cast<uint32_t>(std::min<std::size_t>(kFinBlockRows, events.size() - static_cast<std::size_t>(b) * kFinBlockRows)); // rows in this block
+            index[b] = FinBlockInfo{ 0xFFFFFFFFu, 0, n, 0, offset }; // filled below
+            offset += blockBytes(n); // next block
+        } // end for
+        h.fileSize = offset; // total size
+
+        std::vector<char> buf(static_cast<std::size_t>(h.fileSize), 0); // whole file
+        char* base = buf.data(); // write cursor base
+        uint32_t at = 0; // running dictionary offset
+        uint32_t* offs = reinterpret_cast<uint32_t*>(base + h.dictOffset); // dictionary offsets
+        char* text = base + h.dictOffset + 4 * (names.size() + 1); // dictionary text
+        for (std::size_t i = 0; i < names.size(); ++i) { offs[i] = at; std::memcpy(text + at, names[i].data(), names[i].size()); at += static_cast<uint32_t>(names[i].size()); } // each name
+        offs[names.size()] = at; // end of the last name
+        for (uint32_t b = 0; b < blocks; ++b) { // fill each block
+            FinBlockInfo& info = index[b]; // statistics
+            char* blk = base + info.offset; // block start
+            uint32_t n = info.rows; // rows in the block
+            uint32_t* dates = reinterpret_cast<uint32_t*>(blk); // date column
+            int64_t* cents = reinterpret_cast<int64_t*>(blk + align8(4ull * n)); // cents column, aligned
+            uint32_t* stores = reinterpret_cast<uint32_t*>(reinterpret_cast<char*>(cents) + 8ull * n); // store column
+            uint32_t* cities = stores + n; // city column
+            uint32_t* items = cities + n; // item column
+            uint8_t* kinds = reinterpret_cast<uint8_t*>(items + n); // kind column
+            for (uint32_t i = 0; i < n; ++i) { // each row
+                std::size_t r = static_cast<std::size_t>(b) * kFinBlockRows + i; // event index
+                const FinEvent& e = events[r]; // source event
+                PackedDate d = 0; // parsed date
+                ParseDate(e.date.data(), e.date.size(), d); // text to packed, zero when malformed
+                dates[i] = d; cents[i] = ToCents(e.amount); stores[i] = storeIds[r]; cities[i] = cityIds[r]; items[i] = itemIds[r]; // columns
+                kinds[i] = static_cast<uint8_t>(e.kind); // kind
+                if (d < info.minDate) info.minDate = d; // oldest
+                if (d > info.maxDate) info.maxDate = d; // newest
+            } // end for
+        } // end for
+        std::memcpy(base, &h, sizeof(h)); // header
+        std::memcpy(base + h.indexOffset, index.data(), sizeof(FinBlockInfo) * blocks); // block index
+
+        std::string tmp = path + ".tmp"; // write beside the target, then rename so readers never see half a file
+        std::FILE* f = std::fopen(tmp.c_str(), "wb"); // create
+        if (!f) { error = "cannot create " + tmp; return false; } // no file
+        bool ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size(); // one write
+        ok = std::fclose(f) == 0 && ok; // close
+        if (!ok) { std::remove(tmp.c_str()); error = "cannot write " + tmp; return false; } // the old file stays as it was
+#if defined(_WIN32)
+        ok = MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0; // std::rename does not replace on Windows
+#else
+        ok = std::rename(tmp.c_str(), path.c_str()) == 0; // atomic replace
+#endif
+        if (!ok) { std::remove(tmp.c_str()); error = "cannot replace " + path; return false; } // failed, the old file is untouched
+        return true; // saved
+    } // end WriteFinanceFile
+
+    bool FinanceFile::open(const std::string& path, std::string& error) { // map and validate
+        m_header = nullptr; // forget any earlier file
+        if (!m_map.open(path, error)) return false; // cannot map
+        const char* base = m_map.data(); // file bytes
+        uint64_t size = m_map.size(); // file size
+        if (size < sizeof(FinFileHeader) || std::memcmp(base, kFinMagic, sizeof(kFinMagic)) != 0) { error = path + " is not a history file"; m_map.close(); return false; } // wrong file
+        const FinFileHeader* h = reinterpret_cast<const FinFileHeader*>(base); // header in place
+        if (h->endian != kEndianMark) { error = path + " was written with another byte order"; m_map.close(); return false; } // foreign byte order
+        if (h->version != kFinFileVersion) { error = path + " has unsupported version " + std::to_string(h->version); m_map.close(); return false; } // other version
+        bool sane = h->fileSize == size && h->blockRows == kFinBlockRows && h->dictOffset == sizeof(FinFileHeader) // sizes and fixed offsets
+            && h->indexOffset % 8 == 0 && h->indexOffset >= h->dictOffset && h->indexOffset <= size // index starts inside the file, every bound below subtracts so a crafted header cannot wrap
+            && h->blocks <= (size - h->indexOffset) / sizeof(FinBlockInfo) // index inside the file
+            && h->names + 1ull <= (h->indexOffset - h->dictOffset) / 4 // dictionary offsets before the index
+            && static_cast<uint64_t>(h->blocks) * kFinBlockRows >= h->rows; // enough blocks for the rows
+        if (!sane) { error = path + " is truncated or damaged"; m_map.close(); return false; } // inconsistent header
+        const FinBlockInfo* index = reinterpret_cast<const FinBlockInfo*>(base + h->indexOffset); // block index in place
+        uint64_t indexedRows = 0; // rows the blocks claim between them
+        for (uint32_t b = 0; b < h->blocks; ++b) { // every block inside the file
+            const FinBlockInfo& info = index[b]; // statistics
+            if (info.rows > kFinBlockRows || info.offset % 8 != 0 || info.offset > size || blockBytes(info.rows) > size - info.offset) { error = path + " has a damaged block index"; m_map.close(); return false; } // columns inside the file
+            indexedRows += info.rows; // running total
+        } // end for
+        if (indexedRows != h->rows) { error = path + " has a damaged block index"; m_map.close(); return false; } // size() and scan() must agree
+        m_dictOffsets = reinterpret_cast<const uint32_t*>(base + h->dictOffset); // dictionary offsets
+        uint64_t textStart = h->dictOffset + 4ull * (h->names + 1ull); // dictionary text, at most indexOffset by the check above
+        m_dictBytes = base + textStart; // dictionary text
+        if (m_dictOffsets[h->names] > h->indexOffset - textStart) { error = path + " has a damaged dictionary"; m_map.close(); return false; } // text inside its section
+        for (uint32_t i = 0; i < h->names; ++i) if (m_dictOffsets[i] > m_dictOffsets[i + 1]) { error = path + " has a damaged dictionary"; m_map.close(); return false; } // offsets ascend, so no name length underflows
+        m_index = index; // keep the index
+        m_header = h; // file is usable
+        return true; // opened
+    } // end open
+
+    std::string_view FinanceFile::name(uint32_t id) const { // dictionary lookup
+        if (id >= m_header->names) return std::string_view(); // damaged id
+        return std::string_view(m_dictBytes + m_dictOffsets[id], m_dictOffsets[id + 1] - m_dictOffsets[id]); // view into the mapping
+    } // end name
+
+    FinRow FinanceFile::row(std::size_t b, std::size_t i) const { // one row from the columns
+        const FinBlockInfo& info = m_index[b]; // block statistics
+        const char* blk = m_map.data() + info.offset; // block start
+        uint32_t n = info.rows; // rows in the block
+        const uint32_t* dates = reinterpret_cast<const uint32_t*>(blk); // date column
+        const int64_t* cents = reinterpret_cast<const int64_t*>(blk + align8(4ull * n)); // cents column
+        const uint32_t* stores = reinterpret_cast<const uint32_t*>(cents + n); // store column
+        const uint32_t* cities = stores + n; // city column
+        const uint32_t* items = cities + n; // item column
+        const uint8_t* kinds = reinterpret_cast<const uint8_t*>(items + n); // kind column
+        return FinRow{ static_cast<FinEvent::Kind>(kinds[i]), dates[i], cents[i], name(stores[i]), name(cities[i]), name(items[i]) }; // assemble
+    } // end row
+
+    std::size_t FinanceFile::scan(PackedDate from, PackedDate to, bool (*fn)(const FinRow&, void*), void* ctx) const { // visit rows in range
+        std::size_t read = 0; // blocks whose columns were touched
+        for (uint32_t b = 0; m_header && b < m_header->blocks; ++b) { // each block
+            const FinBlockInfo& info = m_index[b]; // statistics
+            if (info.maxDate < from || info.minDate > to) continue; // no row in range, skip without touching its pages
+            ++read; // block is read
+            const uint32_t* dates = reinterpret_cast<const uint32_t*>(m_map.data() + info.offset); // date column
+            for (uint32_t i = 0; i < info.rows; ++i) { // each row
+                if (dates[i] < from || dates[i] > to) continue; // outside the range
+                if (!fn(row(b, i), ctx)) return read; // caller is done
+            } // end for
+        } // end for
+        return read; // blocks read
+    } // end scan
+
+    int64_t FinanceFile::totalCents(FinEvent::Kind kind) const { // column sum
+        int64_t sum = 0; // running total
+        uint8_t want = static_cast<uint8_t>(kind); // kind byte
+        for (uint32_t b = 0; m_header && b < m_header->blocks; ++b) { // each block
+            const FinBlockInfo& info = m_index[b]; // statistics
+            const char* blk = m_map.data() + info.offset; // block start
+            const int64_t* cents = reinterpret_cast<const int64_t*>(blk + align8(4ull * info.rows)); // cents column
+            const uint8_t* kinds = reinterpret_cast<const uint8_t*>(blk + align8(4ull * info.rows) + 20ull * info.rows); // kind column
+            for (uint32_t i = 0; i < info.rows; ++i) sum += kinds[i] == want ? cents[i] : 0; // branch free sum
+        } // end for
+        return sum; // total cents
+    } // end totalCents
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once // prevent multiple inclusion of this header file
+#include "Finance.h" // include FinEvent and FinRow
+#include "MappedFile.h" // include read only file mapping
+#include "Calendar.h" // include packed dates
+#include <string> // include string for paths and errors
+#include <string_view> // include string_view names
+#include <vector> // include vector container
+#include <cstdint> // include fixed width integer types
+
+namespace atmapp { // begin atmapp namespace
+
+    // History file layout, version 1, little endian, every section 8 byte aligned:
+    //   FinFileHeader                       magic, version, counts and section offsets
+    //   dictionary                          uint32 offsets[names + 1], then the name bytes
+    //   FinBlockInfo[blocks]                min and max date, row count and offset of each block
+    //   blocks                              per block columns: uint32 date[n], int64 cents[n], uint32 store[n], uint32 city[n], uint32 item[n], uint8 kind[n]
+    // Rows keep FinanceLog order, newest first. Dates are PackedDate values.
+
+    const uint32_t kFinFileVersion = 1; // bumped on any layout change
+    const uint32_t kFinBlockRows = 4096; // rows per column block
+
+    struct FinFileHeader { // fixed size file header
+        char magic[8]; // "ATMFIN" followed by two zero bytes
+        uint32_t version; // kFinFileVersion
+        uint32_t endian; // 0x01020304 as written, detects byte order mismatches
+        uint64_t rows; // events stored
+        uint32_t blockRows; // rows per full block
+        uint32_t blocks; // block count
+        uint32_t names; // dictionary entries
+        uint32_t reserved; // zero
+        uint64_t dictOffset; // byte offset of the dictionary
+        uint64_t indexOffset; // byte offset of the block index
+        uint64_t fileSize; // total bytes, detects truncation
+    }; // end of FinFileHeader struct
+
+    struct FinBlockInfo { // per block statistics used to skip blocks
+        PackedDate minDate; // oldest date in the block
+        PackedDate maxDate; // newest date in the block
+        uint32_t rows; // rows in the block
+        uint32_t reserved; // zero
+        uint64_t offset; // byte offset of the block's first column
+    }; // end of FinBlockInfo struct
+
+    bool WriteFinanceFile(const std::string& path, const FinEventList& events, std::string& error); // save events in the columnar layout
+
+    class FinanceFile { // history file queried in place through a read only mapping
+    public: // public interface
+        bool open(const std::string& path, std::string& error); // map and validate, false with a reason on failure
+        std::size_t size() const { return m_header ? static_cast<std::size_t>(m_header->rows) : 0; } // events stored
+        std::size_t blocks() const { return m_header ? m_header->blocks : 0; } // block count
+        const FinBlockInfo& block(std::size_t b) const { return m_index[b]; } // statistics for one block
+        FinRow row(std::size_t b, std::size_t i) const; // row i of block b, names point into the mapping
+        std::string_view name(uint32_t id) const; // dictionary entry
+        std::size_t scan(PackedDate from, PackedDate to, bool (*fn)(const FinRow&, void*), void* ctx) const; // visit rows dated within [from, to] in file order until fn returns false, return blocks read
+        int64_t totalCents(FinEvent::Kind kind) const; // sum of one kind over every row, reads only two columns
+
+    private: // internal data
+        MappedFile m_map; // file bytes
+        const FinFileHeader* m_header = nullptr; // validated header
+        const FinBlockInfo* m_index = nullptr; // block index
+        const uint32_t* m_dictOffsets = nullptr; // dictionary offsets
+        const char* m_dictBytes = nullptr; // dictionary text
+    }; // end of FinanceFile class
+
+}
\ No newline at end of file
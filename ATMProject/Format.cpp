@@ -0,0 +1,92 @@
+#include "Format.h" // include header for the row formatter
+#include "Calendar.h" // include packed date formatting
+#include "CardId.h" // include masked card formatting
+#include <iostream> // include input and output stream library
+#include <cmath> // include fma and floor for exact cent rounding
+
+namespace atmapp { // begin atmapp namespace
+
+    static const char kDigitPairs[201] = // "00" to "99", two digits per table lookup
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    static thread_local std::string t_scratch; // per thread buffer whose capacity survives between reports
+    static thread_local bool t_scratchBusy = false; // set while a RowBuffer holds the scratch buffer
+
+    static char* writeUnsigned(char* end, uint64_t v) { // write digits right to left ending at end, return the first digit
+        while (v >= 100) { // two digits at a time
+            std::size_t i = static_cast<std::size_t>(v % 100) * 2; // pair index
+            v /= 100; // drop them
+            *--end = kDigitPairs[i + 1]; // low digit
+            *--end = kDigitPairs[i]; // high digit
+        } // end while
+        if (v >= 10) { std::size_t i = static_cast<std::size_t>(v) * 2; *--end = kDigitPairs[i + 1]; *--end = kDigitPairs[i]; } // last pair
+        else *--end = static_cast<char>('0' + v); // last single digit
+        return end; // first digit
+    } // end writeUnsigned
+
+    int64_t ToCents(double amount) { // round on the exact product so half cents match stream output
+        double hi = amount * 100.0; // rounded product
+        double lo = std::fma(amount, 100.0, -hi); // rounding error, hi plus lo is the exact product
+        double whole = std::floor(hi); // cents below
+        double frac = hi - whole; // exact for any realistic balance
+        bool up = frac > 0.5 || (frac == 0.5 && (lo > 0.0 || (lo == 0.0 && std::fmod(whole, 2.0) != 0.0))); // nearest, exact ties go to even like printf
+        return static_cast<int64_t>(whole) + (up ? 1 : 0); // whole cents
+    } // end ToCents
+
+    RowBuffer::RowBuffer(std::ostream& out) : m_out(&out), m_buf(&m_own), m_borrowed(false) { // stream sink
+        if (!t_scratchBusy) { t_scratchBusy = true; m_borrowed = true; m_buf = &t_scratch; m_buf->clear(); } // reuse this thread's buffer
+        if (m_buf->capacity() < kRowFlushBytes + 256) m_buf->reserve(kRowFlushBytes + 256); // one allocation for the life of the thread
+    } // end constructor
+
+    RowBuffer::RowBuffer(std::string& storage) : m_out(nullptr), m_buf(&storage), m_borrowed(false) { // memory sink
+    } // end constructor
+
+    RowBuffer::~RowBuffer() { // final write
+        flush(); // write the tail
+        if (m_borrowed) t_scratchBusy = false; // return the scratch buffer
+    } // end destructor
+
+    RowBuffer& RowBuffer::cents(int64_t c) { // dollars and cents without floating point formatting
+        char buf[24]; // enough for any 64-bit value plus sign and point
+        char* end = buf + sizeof(buf); // digits are written backwards
+        uint64_t mag = c < 0 ? 0 - static_cast<uint64_t>(c) : static_cast<uint64_t>(c); // magnitude
+        std::size_t pair = static_cast<std::size_t>(mag % 100) * 2; // cents digits
+        *--end = kDigitPairs[pair + 1]; // second cents digit
+        *--end = kDigitPairs[pair]; // first cents digit
+        *--end = '.'; // decimal point
+        char* p = writeUnsigned(end, mag / 100); // whole dollars
+        if (c < 0) *--p = '-'; // sign
+        return text(std::string_view(p, static_cast<std::size_t>(buf + sizeof(buf) - p))); // append
+    } // end cents
+
+    RowBuffer& RowBuffer::integer(int64_t v) { // whole number
+        char buf[24]; // enough for any 64-bit value plus sign
+        uint64_t mag = v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v); // magnitude
+        char* p = writeUnsigned(buf + sizeof(buf), mag); // digits
+        if (v < 0) *--p = '-'; // sign
+        return text(std::string_view(p, static_cast<std::size_t>(buf + sizeof(buf) - p))); // append
+    } // end integer
+
+    RowBuffer& RowBuffer::date(uint32_t packed) { // YYYY-MM-DD
+        std::size_t n = m_buf->size(); // current end
+        m_buf->resize(n + kDateTextLength); // room for the date
+        FormatDate(packed, &(*m_buf)[n]); // write in place
+        return *this; // allow chaining
+    } // end date
+
+    RowBuffer& RowBuffer::card(CardId id) { // masked card text
+        std::size_t n = m_buf->size(); // current end
+        m_buf->resize(n + kCardTextMax); // room for the longest card text
+        m_buf->resize(n + FormatCard(id, &(*m_buf)[n])); // write in place, keep what was written
+        return *this; // allow chaining
+    } // end card
+
+    void RowBuffer::flush() { // one large write
+        if (!m_out || m_buf->empty()) return; // memory sink or nothing buffered
+        m_out->write(m_buf->data(), static_cast<std::streamsize>(m_buf->size())); // write everything
+        m_buf->clear(); // keep the capacity
+    } // end flush
+
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <string> // include string for the byte buffer
+#include <string_view> // include string_view for literal fields
+#include <cstdint> // include fixed width integer types
+#include <iosfwd> // forward declare iostream types for efficiency
+
+namespace atmapp { // begin atmapp namespace
+
+    const std::size_t kRowFlushBytes = 1 << 16; // buffered bytes that trigger one large write
+
+    class CardId; // forward declaration of CardId class
+
+    int64_t ToCents(double amount); // round dollars to whole cents exactly as printf with two decimals would
+
+    class RowBuffer { // appends report rows into one reusable byte buffer instead of many stream calls
+    public: // public interface
+        explicit RowBuffer(std::ostream& out); // write full buffers to a stream, storage borrowed from this thread's scratch buffer
+        explicit RowBuffer(std::string& storage); // keep every byte in caller owned storage, nothing is written
+        ~RowBuffer(); // write what is left and give the scratch buffer back
+        RowBuffer(const RowBuffer&) = delete; // buffers are not copyable
+        RowBuffer& operator=(const RowBuffer&) = delete; // buffers are not assignable
+
+        RowBuffer& text(std::string_view s) { m_buf->append(s.data(), s.size()); return *this; } // append literal text, capacity is kept between rows
+        RowBuffer& ch(char c) { m_buf->push_back(c); return *this; } // append one character
+        RowBuffer& cents(int64_t c); // append cents as dollars with two decimals
+        RowBuffer& money(double amount) { return cents(ToCents(amount)); } // append a dollar amount with two decimals
+        RowBuffer& integer(int64_t v); // append a whole number
+        RowBuffer& date(uint32_t packed); // append a packed date as YYYY-MM-DD
+        RowBuffer& card(CardId id); // append a card as its masked display text
+        void endRow() { if (m_out && m_buf->size() >= kRowFlushBytes) flush(); } // call after each row, writes once the buffer is large
+        void flush(); // write everything buffered to the stream
+        std::size_t size() const { return m_buf->size(); } // bytes buffered
+
+    private: // internal data
+        std::ostream* m_out; // destination, null for memory only buffers
+        std::string* m_buf; // bytes not yet written
+        bool m_borrowed; // whether m_buf is this thread's scratch buffer
+        std::string m_own; // fallback storage when the scratch buffer is already in use
+    }; // end of RowBuffer class
+
+}
\ No newline at end of file
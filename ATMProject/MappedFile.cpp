@@ -0,0 +1,76 @@
+#include "MappedFile.h" // include header for file mappings
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN // skip rarely used Windows headers
+#define NOMINMAX // keep std::min and std::max usable
+#include <windows.h> // include CreateFileMapping and MapViewOfFile
+#else
+#include <sys/mman.h> // include mmap and madvise
+#include <sys/stat.h> // include fstat for the file size
+#include <fcntl.h> // include open
+#include <unistd.h> // include close
+#include <cerrno> // include errno codes
+#include <cstring> // include strerror
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+#if defined(_WIN32)
+
+    MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr) {} // nothing mapped
+
+    bool MappedFile::open(const std::string& path, std::string& error) { // map with the Win32 API
+        close(); // drop any earlier mapping
+        HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr); // open for reading
+        if (f == INVALID_HANDLE_VALUE) { error = "cannot open " + path; return false; } // missing file
+        LARGE_INTEGER size; // file size
+        if (!GetFileSizeEx(f, &size)) { CloseHandle(f); error = "cannot size " + path; return false; } // size query failed
+        m_file = f; // keep the handle
+        m_size = static_cast<std::size_t>(size.QuadPart); // bytes to map
+        if (m_size == 0) return true; // empty files have no mapping
+        HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr); // mapping object
+        if (!m) { close(); error = "cannot map " + path; return false; } // mapping failed
+        m_mapping = m; // keep the handle
+        m_data = static_cast<const char*>(MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0)); // view of the whole file
+        if (!m_data) { close(); error = "cannot map " + path; return false; } // view failed
+        return true; // mapped
+    } // end open
+
+    void MappedFile::close() { // release handles
+        if (m_data) UnmapViewOfFile(m_data); // drop the view
+        if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping)); // drop the mapping
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(static_cast<HANDLE>(m_file)); // close the file
+        m_data = nullptr; m_size = 0; m_mapping = nullptr; m_file = INVALID_HANDLE_VALUE; // reset
+    } // end close
+
+#else
+
+    MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_fd(-1) {} // nothing mapped
+
+    bool MappedFile::open(const std::string& path, std::string& error) { // map with mmap
+        close(); // drop any earlier mapping
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); // open for reading
+        if (fd < 0) { error = "cannot open " + path + ". " + std::strerror(errno); return false; } // missing file
+        struct stat st; // file status
+        if (::fstat(fd, &st) != 0) { error = "cannot size " + path + ". " + std::strerror(errno); ::close(fd); return false; } // size query failed
+        m_fd = fd; // keep the descriptor
+        m_size = static_cast<std::size_t>(st.st_size); // bytes to map
+        if (m_size == 0) return true; // empty files have no mapping
+        void* p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0); // map the whole file
+        if (p == MAP_FAILED) { error = "cannot map " + path + ". " + std::strerror(errno); close(); return false; } // mapping failed
+        ::madvise(p, m_size, MADV_SEQUENTIAL); // read ahead aggressively, every byte is scanned once
+        m_data = static_cast<const char*>(p); // keep the view
+        return true; // mapped
+    } // end open
+
+    void MappedFile::close() { // release the mapping
+        if (m_data) ::munmap(const_cast<char*>(m_data), m_size); // drop the view
+        if (m_fd >= 0) ::close(m_fd); // close the file
+        m_data = nullptr; m_size = 0; m_fd = -1; // reset
+    } // end close
+
+#endif
+
+    MappedFile::~MappedFile() { close(); } // release on destruction
+
+}
\ No newline at end of file
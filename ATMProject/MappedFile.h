@@ -0,0 +1,29 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <string> // include string for paths and errors
+#include <cstddef> // include size_t
+
+namespace atmapp { // begin atmapp namespace
+
+    class MappedFile { // read only view of a whole file through the page cache, no copy into the heap
+    public: // public interface
+        MappedFile(); // nothing mapped
+        ~MappedFile(); // unmap and close
+        MappedFile(const MappedFile&) = delete; // mappings are not copyable
+        MappedFile& operator=(const MappedFile&) = delete; // mappings are not assignable
+        bool open(const std::string& path, std::string& error); // map the file, false with a reason on failure
+        void close(); // release the mapping
+        const char* data() const { return m_data; } // first byte, null when empty or closed
+        std::size_t size() const { return m_size; } // bytes mapped
+
+    private: // internal data
+        const char* m_data; // mapped bytes
+        std::size_t m_size; // mapped length
+#if defined(_WIN32)
+        void* m_file; // file handle
+        void* m_mapping; // file mapping handle
+#else
+        int m_fd; // file descriptor
+#endif
+    }; // end of MappedFile class
+
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "MemoryUsage.h" // include header for memory accounting
+#include "Transaction.h" // include TransactionLog footprint
+#include "ShardedLog.h" // include ShardedTxLog footprint
+#include "Finance.h" // include FinanceLog footprint
+#include <iostream> // include input and output stream library
+#include <iomanip> // include formatting manipulators
+#include <chrono> // include clocks for the walk time
+
+namespace atmapp { // begin atmapp namespace
+
+    void* MemoryCounter::do_allocate(std::size_t bytes, std::size_t align) { // count and forward
+        void* p = m_upstream->allocate(bytes, align); // may throw, nothing counted then
+        m_allocs.fetch_add(1, std::memory_order_relaxed); // one more block
+        uint64_t live = m_live.fetch_add(bytes, std::memory_order_relaxed) + bytes; // new total
+        uint64_t peak = m_peak.load(std::memory_order_relaxed); // current high water mark
+        while (live > peak && !m_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {} // raise it, rarely more than once
+        return p; // block
+    } // end do_allocate
+
+    void MemoryCounter::do_deallocate(void* p, std::size_t bytes, std::size_t align) { // count and forward
+        m_frees.fetch_add(1, std::memory_order_relaxed); // one block back
+        m_live.fetch_sub(bytes, std::memory_order_relaxed); // smaller total
+        m_upstream->deallocate(p, bytes, align); // release
+    } // end do_deallocate
+
+    static MemoryCounter* g_counter = nullptr; // installed counter, lives for the rest of the process
+
+    void InstallMemoryCounter() { // count every default resource allocation from now on
+        if (g_counter) return; // once
+        static MemoryCounter counter(std::pmr::new_delete_resource()); // never destroyed before the containers using it
+        g_counter = &counter; // remember it
+        std::pmr::set_default_resource(&counter); // pmr containers built after this count their blocks
+    } // end InstallMemoryCounter
+
+    HeapCounts CountedHeap() { // totals of the installed counter
+        if (!g_counter) return HeapCounts{ false, 0, 0, 0, 0 }; // nothing installed
+        return HeapCounts{ true, g_counter->liveBytes(), g_counter->peakBytes(), g_counter->allocations(), g_counter->frees() }; // relaxed reads, each value on its own
+    } // end CountedHeap
+
+    template <typename Walk> static MemoryReport snapshot(const MemoryUsage& accounts, Walk transactions, const FinanceLog* fin) { // shared by both log kinds
+        auto start = std::chrono::steady_clock::now(); // start timing
+        MemoryReport r{}; // result
+        r.accounts = accounts; // computed by the owner of the customer list
+        r.transactions = transactions(); // ring walk plus running segment totals
+        if (fin) r.finance = fin->memoryUsage(); // cached per published version
+        r.heap = CountedHeap(); // exact pmr totals
+        r.walkNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count(); // cost of this call
+        return r; // report
+    } // end snapshot
+
+    MemoryReport SnapshotMemory(const MemoryUsage& accounts, const TransactionLog* log, const FinanceLog* fin) { // one report
+        return snapshot(accounts, [log] { return log ? log->memoryUsage() : MemoryUsage(); }, fin); // plain log
+    } // end SnapshotMemory
+
+    MemoryReport SnapshotMemory(const MemoryUsage& accounts, const ShardedTxLog& log, const FinanceLog* fin) { // one report for a server
+        return snapshot(accounts, [&log] { return log.memoryUsage(); }, fin); // history and shard rings
+    } // end SnapshotMemory
+
+    static const char* const kMemoryParts[] = { "accounts", "transactions", "finance" }; // report row names
+
+    static const MemoryUsage& part(const MemoryReport& r, int i) { return i == 0 ? r.accounts : i == 1 ? r.transactions : r.finance; } // row data by index
+
+    void PrintMemory(std::ostream& out, const MemoryReport& report) { // human readable table
+        std::ios::fmtflags flags = out.flags(); // keep caller formatting
+        std::streamsize precision = out.precision(); // keep caller precision
+        out << "\n=== Memory (KiB) ===\n"; // header
+        out << std::left << std::setw(14) << " structure" << std::right << std::setw(10) << "items" << std::setw(10) << "entries" << std::setw(9) << "slack" << std::setw(9) << "strings" << std::setw(9) << "encoded" << std::setw(10) << "total" << std::setw(9) << "allocs" << std::setw(8) << "B/item" << "\n"; // column names
+        out << std::fixed << std::setprecision(1); // one decimal
+        MemoryUsage sum; // every structure
+        for (int i = 0; i < 4; ++i) { // three structures and their sum
+            const MemoryUsage& u = i < 3 ? part(report, i) : sum; // row data
+            const double k = 1024.0; // bytes per KiB
+            out << std::left << std::setw(14) << (std::string(" ") + (i < 3 ? kMemoryParts[i] : "all")) << std::right << std::setw(10) << u.items // name and count
+                << std::setw(10) << u.entryBytes / k << std::setw(9) << u.slackBytes / k << std::setw(9) << u.stringBytes / k << std::setw(9) << u.encodedBytes / k << std::setw(10) << u.bytes() / k // breakdown
+                << std::setw(9) << u.allocations << std::setw(8) << u.perItem() << "\n"; // blocks and overhead
+            if (i < 3) sum += u; // accumulate
+        } // end for
+        if (report.heap.counting) out << " pmr heap. " << report.heap.liveBytes / 1024.0 << " KiB live, " << report.heap.peakBytes / 1024.0 << " KiB peak, " << report.heap.allocations << " allocations, " << report.heap.frees << " frees\n"; // exact counts
+        out << " snapshot. " << report.walkNs / 1000.0 << " us\n"; // cost
+        out.flags(flags); // restore formatting
+        out.precision(precision); // restore precision
+    } // end PrintMemory
+
+    void PrintMemoryJson(std::ostream& out, const MemoryReport& report) { // one JSON object keyed by structure
+        std::ios::fmtflags flags = out.flags(); // keep caller formatting
+        std::streamsize precision = out.precision(); // keep caller precision
+        out << std::fixed << std::setprecision(1) << "{"; // open object
+        for (int i = 0; i < 3; ++i) { // one member per structure
+            const MemoryUsage& u = part(report, i); // member data
+            out << (i ? "," : "") << "\"" << kMemoryParts[i] << "\":{\"items\":" << u.items << ",\"entry_bytes\":" << u.entryBytes << ",\"slack_bytes\":" << u.slackBytes << ",\"string_bytes\":" << u.stringBytes // sizes
+                << ",\"encoded_bytes\":" << u.encodedBytes << ",\"bytes\":" << u.bytes() << ",\"allocations\":" << u.allocations << ",\"bytes_per_item\":" << u.perItem() << "}"; // totals
+        } // end for
+        if (report.heap.counting) out << ",\"heap\":{\"live_bytes\":" << report.heap.liveBytes << ",\"peak_bytes\":" << report.heap.peakBytes << ",\"allocations\":" << report.heap.allocations << ",\"frees\":" << report.heap.frees << "}"; // exact counts
+        out << ",\"snapshot_ns\":" << report.walkNs << "}\n"; // cost, close object
+        out.flags(flags); // restore formatting
+        out.precision(precision); // restore precision
+    } // end PrintMemoryJson
+
+}
@@ -0,0 +1,88 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <atomic> // include relaxed counters for the counting resource
+#include <cstdint> // include fixed width integer types
+#include <cstddef> // include size_t
+#include <memory_resource> // include memory_resource for the counting heap
+#include <string> // include basic_string for the inline buffer check
+#include <vector> // include vector for container footprints
+#include <iosfwd> // forward declare iostream types for efficiency
+
+namespace atmapp { // begin atmapp namespace
+
+    struct MemoryUsage { // footprint of one structure, split by where the bytes go
+        uint64_t items = 0; // entries held, events, transactions or accounts
+        uint64_t entryBytes = 0; // the entries themselves, sizeof times count
+        uint64_t slackBytes = 0; // reserved capacity no entry uses yet
+        uint64_t stringBytes = 0; // text that outgrew the inline string buffer
+        uint64_t encodedBytes = 0; // compressed columns, dictionaries and lookup tables
+        uint64_t allocations = 0; // heap blocks behind the bytes above, an arena counts its chunks instead
+        uint64_t bytes() const { return entryBytes + slackBytes + stringBytes + encodedBytes; } // total footprint
+        double perItem() const { return items ? static_cast<double>(bytes()) / static_cast<double>(items) : 0.0; } // overhead per entry
+        MemoryUsage& operator+=(const MemoryUsage& o) { items += o.items; entryBytes += o.entryBytes; slackBytes += o.slackBytes; stringBytes += o.stringBytes; encodedBytes += o.encodedBytes; allocations += o.allocations; return *this; } // combine parts
+    }; // end of MemoryUsage struct
+
+    template <typename T, typename A> void AddVector(MemoryUsage& u, const std::vector<T, A>& v) { // slots in use and slots reserved, the elements' own heap data is not followed
+        u.entryBytes += v.size() * sizeof(T); // used slots
+        u.slackBytes += (v.capacity() - v.size()) * sizeof(T); // reserved slots
+        if (v.capacity()) ++u.allocations; // one block
+    } // end AddVector
+
+    template <typename C, typename Tr, typename A> void AddString(MemoryUsage& u, const std::basic_string<C, Tr, A>& s) { // separate block behind a string, nothing for short strings
+        if (s.capacity() <= std::basic_string<C, Tr, A>().capacity()) return; // still in the inline buffer
+        u.stringBytes += (s.capacity() + 1) * sizeof(C); // capacity plus the terminator
+        ++u.allocations; // one block
+    } // end AddString
+
+    // Every pmr allocation through the default resource, counted with relaxed atomics. The walks above estimate
+    // from capacities; this is the exact figure for whatever uses the default resource, std::string included only
+    // when it is a pmr string. One add per allocation and per free, cheap enough to leave on in production.
+
+    class MemoryCounter : public std::pmr::memory_resource { // forwards to an upstream resource and keeps totals
+    public: // public interface
+        explicit MemoryCounter(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) : m_upstream(upstream) {} // count on top of upstream
+        uint64_t liveBytes() const { return m_live.load(std::memory_order_relaxed); } // bytes allocated and not yet freed
+        uint64_t peakBytes() const { return m_peak.load(std::memory_order_relaxed); } // highest liveBytes seen
+        uint64_t allocations() const { return m_allocs.load(std::memory_order_relaxed); } // allocate calls so far
+        uint64_t frees() const { return m_frees.load(std::memory_order_relaxed); } // deallocate calls so far
+
+    protected: // memory_resource overrides
+        void* do_allocate(std::size_t bytes, std::size_t align) override; // count and forward
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override; // count and forward
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; } // only itself
+
+    private: // internal data
+        std::pmr::memory_resource* m_upstream; // where the bytes come from
+        std::atomic<uint64_t> m_live{ 0 }; // current bytes
+        std::atomic<uint64_t> m_peak{ 0 }; // high water mark
+        std::atomic<uint64_t> m_allocs{ 0 }; // allocate calls
+        std::atomic<uint64_t> m_frees{ 0 }; // deallocate calls
+    }; // end of MemoryCounter class
+
+    struct HeapCounts { // MemoryCounter totals at one moment
+        bool counting; // whether InstallMemoryCounter ran
+        uint64_t liveBytes; // bytes allocated and not yet freed
+        uint64_t peakBytes; // high water mark
+        uint64_t allocations; // allocate calls
+        uint64_t frees; // deallocate calls
+    }; // end of HeapCounts struct
+
+    struct MemoryReport { // footprint of the application's data, one snapshot
+        MemoryUsage accounts; // customer records and their indices
+        MemoryUsage transactions; // transaction log, ring and segments
+        MemoryUsage finance; // current finance history version
+        HeapCounts heap; // counted pmr allocations
+        double walkNs; // time spent producing the snapshot
+    }; // end of MemoryReport struct
+
+    class TransactionLog; // forward declaration of TransactionLog class
+    class ShardedTxLog; // forward declaration of ShardedTxLog class
+    class FinanceLog; // forward declaration of FinanceLog class
+
+    void InstallMemoryCounter(); // route the default pmr resource through a process wide MemoryCounter, call before building any log
+    HeapCounts CountedHeap(); // totals of the installed counter, all zero when none is installed
+    MemoryReport SnapshotMemory(const MemoryUsage& accounts, const TransactionLog* log, const FinanceLog* fin); // walk each structure, null logs report zero
+    MemoryReport SnapshotMemory(const MemoryUsage& accounts, const ShardedTxLog& log, const FinanceLog* fin); // the same with a server's sharded log
+    void PrintMemory(std::ostream& out, const MemoryReport& report); // human readable table
+    void PrintMemoryJson(std::ostream& out, const MemoryReport& report); // one JSON object
+
+}
@@ -0,0 +1,180 @@
+#include "Metrics.h" // include header for latency instrumentation
+#include <iostream> // include input and output stream library
+#include <iomanip> // include formatting manipulators
+#include <mutex> // include mutex for the thread registry
+#include <vector> // include vector for registered threads
+#include <algorithm> // include remove for unregistering
+#include <chrono> // include clocks for tick calibration
+#include <thread> // include sleep for tick calibration
+#include <csignal> // include signal handling for dump requests
+#include <string> // include string for row labels
+
+namespace atmapp { // begin atmapp namespace
+
+    struct MetricsRegistry { // every live thread plus totals from threads that already exited
+        std::mutex lock; // guards the lists, never taken on the recording path
+        std::vector<ThreadMetrics*> live; // threads currently recording
+        ThreadMetrics* retired = new ThreadMetrics(); // merged counters of exited threads
+    }; // end of MetricsRegistry struct
+
+    static MetricsRegistry& registry() { // shared registry that outlives every thread
+        static MetricsRegistry* r = new MetricsRegistry(); // intentionally never freed so exiting threads can always merge
+        return *r; // return registry
+    } // end registry
+
+    static void mergeInto(ThreadMetrics& to, const ThreadMetrics& from) { // add one set of counters to another
+        for (int i = 0; i < kMetricOps; ++i) { // each operation
+            auto add = [](std::atomic<uint64_t>& a, const std::atomic<uint64_t>& b) { a.fetch_add(b.load(std::memory_order_relaxed), std::memory_order_relaxed); }; // relaxed merge
+            add(to.failures[i], from.failures[i]); // failures
+            add(to.ticks[i], from.ticks[i]); // time
+            for (int b = 0; b < kLatencyBuckets; ++b) add(to.buckets[i][b], from.buckets[i][b]); // histogram
+        } // end for
+    } // end mergeInto
+
+    struct ThreadMetricsHolder { // owns one thread's counters and hands them back when the thread ends
+        ThreadMetrics* metrics = nullptr; // counters, created on first use
+        ~ThreadMetricsHolder() { // thread is exiting
+            if (!metrics) return; // never recorded anything
+            MetricsRegistry& r = registry(); // shared registry
+            std::lock_guard<std::mutex> guard(r.lock); // rare path
+            mergeInto(*r.retired, *metrics); // keep the totals
+            r.live.erase(std::remove(r.live.begin(), r.live.end(), metrics), r.live.end()); // unregister
+            delete metrics; // release counters
+            t_localMetrics = nullptr; // a late record registers afresh
+        } // end destructor
+    }; // end of ThreadMetricsHolder struct
+
+    ThreadMetrics& RegisterLocalMetrics() { // this thread's first record
+        thread_local ThreadMetricsHolder holder; // one holder per thread, hands the counters back at thread exit
+        if (!holder.metrics) { // not registered yet
+            holder.metrics = new ThreadMetrics(); // zero initialized counters
+            MetricsRegistry& r = registry(); // shared registry
+            std::lock_guard<std::mutex> guard(r.lock); // registration happens once per thread
+            r.live.push_back(holder.metrics); // make it visible to snapshots
+        } // end if
+        t_localMetrics = holder.metrics; // later records skip this call
+        return *holder.metrics; // return counters
+    } // end RegisterLocalMetrics
+
+    static double nanosPerTick() { // conversion from MetricsTicks units to nanoseconds, measured once
+        static const double ratio = [] { // computed on first snapshot
+#if defined(ATMAPP_METRICS_TSC)
+            auto wall0 = std::chrono::steady_clock::now(); // wall clock start
+            uint64_t tick0 = MetricsTicks(); // cycle counter start
+            std::this_thread::sleep_for(std::chrono::milliseconds(20)); // short calibration window
+            uint64_t tick1 = MetricsTicks(); // cycle counter end
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wall0).count()); // wall time elapsed
+            return tick1 > tick0 ? ns / static_cast<double>(tick1 - tick0) : 1.0; // nanoseconds per cycle
+#else
+            return 1e9 * static_cast<double>(std::chrono::steady_clock::period::num) / static_cast<double>(std::chrono::steady_clock::period::den); // steady clock period in nanoseconds
+#endif
+        }(); // end calibration
+        return ratio; // return cached ratio
+    } // end nanosPerTick
+
+    static double bucketUpperTicks(int b) { // largest tick count that lands in bucket b
+        if (b < (1 << kLatencySubBits)) return static_cast<double>(b); // exact buckets
+        int shift = (b >> kLatencySubBits) - 1; // magnitude of the bucket
+        int sub = b & ((1 << kLatencySubBits) - 1); // sub bucket
+        return static_cast<double>((static_cast<uint64_t>((1 << kLatencySubBits) + sub + 1) << shift) - 1); // end of the sub bucket range
+    } // end bucketUpperTicks
+
+    static double percentileTicks(const std::atomic<uint64_t>* buckets, uint64_t total, double p) { // bucket bound at a percentile
+        if (total == 0) return 0.0; // nothing recorded
+        uint64_t target = static_cast<uint64_t>(p * static_cast<double>(total - 1)) + 1; // rank of the sample
+        uint64_t seen = 0; // samples passed so far
+        for (int b = 0; b < kLatencyBuckets; ++b) { // walk buckets in order
+            seen += buckets[b].load(std::memory_order_relaxed); // accumulate
+            if (seen >= target) return bucketUpperTicks(b); // bucket containing the rank
+        } // end for
+        return bucketUpperTicks(kLatencyBuckets - 1); // counters moved during the walk
+    } // end percentileTicks
+
+    const char* MetricName(MetricOp op) { // short label for reports
+        switch (op) { // choose label
+        case MetricOp::Balance: return "balance"; // DoBalance
+        case MetricOp::Deposit: return "deposit"; // DoDeposit
+        case MetricOp::Withdraw: return "withdraw"; // DoWithdraw
+        case MetricOp::Transfer: return "transfer"; // DoTransfer
+        case MetricOp::Credit: return "credit"; // credit computation
+        case MetricOp::Regenerate: return "regenerate"; // history regeneration
+        case MetricOp::Count: break; // not an operation
+        } // end switch
+        return "?"; // fallback
+    } // end MetricName
+
+    MetricsSnapshot SnapshotMetrics() { // merge every thread on demand
+        ThreadMetrics* merged = new ThreadMetrics(); // scratch totals, heap allocated because the histograms are large
+        {
+            MetricsRegistry& r = registry(); // shared registry
+            std::lock_guard<std::mutex> guard(r.lock); // keep threads from exiting mid merge
+            mergeInto(*merged, *r.retired); // exited threads
+            for (ThreadMetrics* t : r.live) mergeInto(*merged, *t); // running threads, read with relaxed loads
+        }
+        double scale = nanosPerTick(); // tick conversion
+        MetricsSnapshot snap{}; // result
+        for (int i = 0; i < kMetricOps; ++i) { // summarize each operation
+            OpStats& s = snap.ops[i]; // output slot
+            uint64_t total = 0; // samples in the histogram
+            for (int b = 0; b < kLatencyBuckets; ++b) total += merged->buckets[i][b].load(std::memory_order_relaxed); // histogram total
+            s.calls = total; // every call lands in one bucket
+            s.failures = merged->failures[i].load(std::memory_order_relaxed); // failures
+            s.meanNs = s.calls ? static_cast<double>(merged->ticks[i].load(std::memory_order_relaxed)) / static_cast<double>(s.calls) * scale : 0.0; // mean
+            s.p50Ns = percentileTicks(merged->buckets[i], total, 0.50) * scale; // median
+            s.p90Ns = percentileTicks(merged->buckets[i], total, 0.90) * scale; // 90th
+            s.p99Ns = percentileTicks(merged->buckets[i], total, 0.99) * scale; // 99th
+            s.p999Ns = percentileTicks(merged->buckets[i], total, 0.999) * scale; // 99.9th
+            s.maxNs = percentileTicks(merged->buckets[i], total, 1.0) * scale; // slowest bucket
+        } // end for
+        delete merged; // release scratch totals
+        return snap; // return summary
+    } // end SnapshotMetrics
+
+    void PrintMetrics(std::ostream& out, const MetricsSnapshot& snap) { // human readable table
+        std::ios::fmtflags flags = out.flags(); // keep caller formatting
+        std::streamsize precision = out.precision(); // keep caller precision
+        out << "\n=== Operation Metrics (ns) ===\n"; // header
+        out << std::left << std::setw(12) << " op" << std::right << std::setw(8) << "calls" << std::setw(8) << "fails" << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p999" << std::setw(10) << "max" << "\n"; // column names
+        out << std::fixed << std::setprecision(0); // whole nanoseconds
+        for (int i = 0; i < kMetricOps; ++i) { // one row per operation
+            const OpStats& s = snap.ops[i]; // row data
+            out << std::left << std::setw(12) << (std::string(" ") + MetricName(static_cast<MetricOp>(i))) << std::right << std::setw(8) << s.calls << std::setw(8) << s.failures // name and counters
+                << std::setw(10) << s.meanNs << std::setw(10) << s.p50Ns << std::setw(10) << s.p99Ns << std::setw(10) << s.p999Ns << std::setw(10) << s.maxNs << "\n"; // latencies
+        } // end for
+        out.flags(flags); // restore formatting
+        out.precision(precision); // restore precision
+    } // end PrintMetrics
+
+    void PrintMetricsJson(std::ostream& out, const MetricsSnapshot& snap) { // one JSON object keyed by operation
+        std::ios::fmtflags flags = out.flags(); // keep caller formatting
+        std::streamsize precision = out.precision(); // keep caller precision
+        out << std::fixed << std::setprecision(1) << "{"; // open object
+        for (int i = 0; i < kMetricOps; ++i) { // one member per operation
+            const OpStats& s = snap.ops[i]; // member data
+            out << (i ? "," : "") << "\"" << MetricName(static_cast<MetricOp>(i)) << "\":{\"calls\":" << s.calls << ",\"failures\":" << s.failures // counters
+                << ",\"mean_ns\":" << s.meanNs << ",\"p50_ns\":" << s.p50Ns << ",\"p90_ns\":" << s.p90Ns << ",\"p99_ns\":" << s.p99Ns << ",\"p999_ns\":" << s.p999Ns << ",\"max_ns\":" << s.maxNs << "}"; // latencies
+        } // end for
+        out << "}\n"; // close object
+        out.flags(flags); // restore formatting
+        out.precision(precision); // restore precision
+    } // end PrintMetricsJson
+
+    static volatile std::sig_atomic_t g_dumpRequested = 0; // set by the signal handler, consumed by the session loop
+
+    extern "C" void atmappMetricsSignal(int) { // async signal safe handler, only sets a flag
+        g_dumpRequested = 1; // request a dump
+    } // end atmappMetricsSignal
+
+    void InstallMetricsSignal() { // route SIGUSR1 to a dump request
+#if defined(SIGUSR1)
+        std::signal(SIGUSR1, atmappMetricsSignal); // POSIX only, Windows has no user signals
+#endif
+    } // end InstallMetricsSignal
+
+    bool MetricsDumpRequested() { // consume a pending request
+        if (!g_dumpRequested) return false; // nothing pending
+        g_dumpRequested = 0; // consume it
+        return true; // dump now
+    } // end MetricsDumpRequested
+
+}
\ No newline at end of file
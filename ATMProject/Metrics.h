@@ -0,0 +1,111 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <atomic> // include relaxed atomics so snapshots can read while threads record
+#include <cstdint> // include fixed width integer types
+#include <iosfwd> // forward declare iostream types for efficiency
+
+#if defined(_MSC_VER)
+#include <intrin.h> // include __rdtsc and the bit scan intrinsics on MSVC
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define ATMAPP_METRICS_TSC 1 // time with the cycle counter
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // include __rdtsc on GCC and Clang
+#define ATMAPP_METRICS_TSC 1 // time with the cycle counter
+#else
+#include <chrono> // include steady clock fallback
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+    enum class MetricOp { Balance, Deposit, Withdraw, Transfer, Credit, Regenerate, Count }; // instrumented operations, Count is the number of them
+
+    const int kMetricOps = static_cast<int>(MetricOp::Count); // number of instrumented operations
+    const int kLatencySubBits = 4; // sixteen linear sub buckets per power of two, about six percent precision
+    const int kLatencyBuckets = 64 << kLatencySubBits; // enough buckets for any 64-bit tick count
+
+    inline uint64_t MetricsTicks() { // cheapest monotonic timestamp available
+#if defined(ATMAPP_METRICS_TSC)
+        return __rdtsc(); // invariant cycle counter on modern x86
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()); // steady clock elsewhere
+#endif
+    } // end MetricsTicks
+
+    inline int LatencyBucket(uint64_t ticks) { // log linear bucket index, HDR histogram style
+        if (ticks < (1u << kLatencySubBits)) return static_cast<int>(ticks); // small values are exact
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long top; // index of the highest set bit
+        _BitScanReverse64(&top, ticks); // find it
+#elif defined(_MSC_VER)
+        unsigned long top; // index of the highest set bit, 32-bit targets scan one half at a time
+        unsigned long high = static_cast<unsigned long>(ticks >> 32); // upper half
+        if (high != 0) { _BitScanReverse(&top, high); top += 32; } // bit in the upper half
+        else _BitScanReverse(&top, static_cast<unsigned long>(ticks)); // otherwise the lower half
+#else
+        int top = 63 - __builtin_clzll(ticks); // index of the highest set bit
+#endif
+        int shift = static_cast<int>(top) - kLatencySubBits; // bits below the sub bucket field
+        return ((shift + 1) << kLatencySubBits) + static_cast<int>((ticks >> shift) & ((1u << kLatencySubBits) - 1)); // magnitude then sub bucket
+    } // end LatencyBucket
+
+    struct ThreadMetrics { // one thread's counters, written only by that thread, calls are the histogram total
+        std::atomic<uint64_t> failures[kMetricOps]; // operations that were declined
+        std::atomic<uint64_t> ticks[kMetricOps]; // total time spent
+        std::atomic<uint64_t> buckets[kMetricOps][kLatencyBuckets]; // latency histogram
+    }; // end of ThreadMetrics struct
+
+    inline thread_local ThreadMetrics* t_localMetrics = nullptr; // this thread's counters once registered, constant initialized so reading it is a plain TLS load
+    ThreadMetrics& RegisterLocalMetrics(); // create and register this thread's counters
+
+    inline ThreadMetrics& LocalMetrics() { // this thread's counters, registered on first use
+        ThreadMetrics* m = t_localMetrics; // fast path, no call
+        return m ? *m : RegisterLocalMetrics(); // first record on this thread
+    } // end LocalMetrics
+
+    inline void RecordLatency(MetricOp op, uint64_t ticks, bool failed) { // add one sample, single writer so plain load and store suffice
+        ThreadMetrics& m = LocalMetrics(); // this thread's counters
+        int i = static_cast<int>(op); // operation index
+        auto bump = [](std::atomic<uint64_t>& a, uint64_t by) { a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed); }; // no locked instruction needed
+        if (failed) bump(m.failures[i], 1); // count a decline
+        bump(m.ticks[i], ticks); // add the time
+        bump(m.buckets[i][LatencyBucket(ticks)], 1); // add to the histogram
+    } // end RecordLatency
+
+    class ScopedLatency { // times a scope and records it when the scope ends
+    public: // public interface
+        explicit ScopedLatency(MetricOp op) : m_op(op), m_failed(false), m_start(MetricsTicks()) {} // start timing
+        ~ScopedLatency() { RecordLatency(m_op, MetricsTicks() - m_start, m_failed); } // stop timing and record
+        void markFailed() { m_failed = true; } // count this call as declined
+        ScopedLatency(const ScopedLatency&) = delete; // timers are not copyable
+        ScopedLatency& operator=(const ScopedLatency&) = delete; // timers are not assignable
+
+    private: // internal data
+        MetricOp m_op; // operation being timed
+        bool m_failed; // whether the operation was declined
+        uint64_t m_start; // start timestamp
+    }; // end of ScopedLatency class
+
+    struct OpStats { // merged view of one operation
+        uint64_t calls; // completed operations
+        uint64_t failures; // declined operations
+        double meanNs; // average latency
+        double p50Ns; // median latency
+        double p90Ns; // 90th percentile latency
+        double p99Ns; // 99th percentile latency
+        double p999Ns; // 99.9th percentile latency
+        double maxNs; // upper bound of the slowest bucket
+    }; // end of OpStats struct
+
+    struct MetricsSnapshot { // merged view of every thread
+        OpStats ops[kMetricOps]; // one entry per operation
+    }; // end of MetricsSnapshot struct
+
+    const char* MetricName(MetricOp op); // short label for reports
+    MetricsSnapshot SnapshotMetrics(); // merge every thread's counters on demand
+    void PrintMetrics(std::ostream& out, const MetricsSnapshot& snap); // human readable table
+    void PrintMetricsJson(std::ostream& out, const MetricsSnapshot& snap); // one JSON object
+    void InstallMetricsSignal(); // request a dump on SIGUSR1 where the platform has it
+    bool MetricsDumpRequested(); // true once per received signal
+
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "PackedHistory.h" // include header for the compressed history
+#include <algorithm> // include min and max
+
+namespace atmapp { // begin atmapp namespace
+
+    static unsigned bitWidth(uint64_t v) { // bits needed to hold v, zero for zero
+        unsigned n = 0; // width so far
+        while (v) { ++n; v >>= 1; } // count significant bits
+        return n; // width
+    } // end bitWidth
+
+    static uint64_t widthMask(unsigned width) { // low width bits set
+        return width == 0 ? 0 : ~0ull >> (64 - width); // avoid the undefined 64 bit shift
+    } // end widthMask
+
+    static inline uint64_t getBits(const uint64_t* words, uint64_t bit, uint64_t mask) { // read one field, may touch the word after it
+        uint64_t w = bit >> 6; // word index
+        unsigned s = static_cast<unsigned>(bit & 63); // shift inside the word
+        return ((words[w] >> s) | ((words[w + 1] << 1) << (63 - s))) & mask; // two shifts keep s == 0 defined and branch free
+    } // end getBits
+
+    template <typename T> static void unpack(const uint64_t* words, uint64_t bit, unsigned width, std::size_t n, T base, T* out) { // one column
+        uint64_t mask = widthMask(width); // field mask
+        for (std::size_t i = 0; i < n; ++i, bit += width) out[i] = static_cast<T>(base + static_cast<T>(getBits(words, bit, mask))); // base plus packed offset
+    } // end unpack
+
+    uint32_t PackedHistory::intern(std::string_view s) { // dictionary id for a name
+        if (m_ids.empty()) for (uint32_t id = 0; id + 1 < m_nameOffsets.size(); ++id) m_ids.emplace(std::string(name(id)), id); // rebuild after seal released it
+        auto ins = m_ids.emplace(std::string(s), static_cast<uint32_t>(m_nameOffsets.size() - 1)); // insert when new
+        if (ins.second) { m_names.append(s.data(), s.size()); m_nameOffsets.push_back(static_cast<uint32_t>(m_names.size())); } // new name
+        return ins.first->second; // id
+    } // end intern
+
+    void PackedHistory::append(const FinRow& r) { // add one row
+        m_pending.push_back(Pending{ r.date, r.cents, static_cast<uint8_t>(r.kind), intern(r.store), intern(r.location), intern(r.item) }); // buffer it
+        if (m_pending.size() == kPackedBlockRows) encodeBlock(); // full block
+    } // end append
+
+    void PackedHistory::seal() { // finish appending
+        if (!m_pending.empty()) encodeBlock(); // partial last block
+        m_pending.shrink_to_fit(); // drop the staging buffer
+        std::unordered_map<std::string, uint32_t>().swap(m_ids); // the lookup table is only needed while appending
+        m_words.shrink_to_fit(); // trim growth slack
+        m_blocks.shrink_to_fit(); // trim growth slack
+    } // end seal
+
+    void PackedHistory::putBits(uint64_t value, unsigned width) { // append bits
+        if (width == 0) return; // nothing stored
+        uint64_t w = m_bits >> 6; // word index
+        unsigned s = static_cast<unsigned>(m_bits & 63); // shift inside the word
+        if (m_words.size() < w + 3) m_words.resize(w + 3, 0); // keep a spare word after the last field for getBits
+        m_words[w] |= value << s; // low part
+        if (s + width > 64) m_words[w + 1] |= value >> (64 - s); // high part spills into the next word
+        m_bits += width; // advance
+    } // end putBits
+
+    void PackedHistory::encodeBlock() { // pack the pending rows
+        PackedBlock h{}; // skip header
+        h.rows = static_cast<uint32_t>(m_pending.size()); // row count
+        h.minDate = 0xFFFFFFFFu; // widen below
+        h.minCents = m_pending.front().cents; // widen below
+        int64_t maxCents = h.minCents; // widest amount
+        uint32_t maxStore = 0, maxCity = 0, maxItem = 0; // largest ids
+        for (const Pending& p : m_pending) { // gather ranges and totals
+            h.minDate = std::min(h.minDate, p.date); h.maxDate = std::max(h.maxDate, p.date); // date range
+            h.minCents = std::min(h.minCents, p.cents); maxCents = std::max(maxCents, p.cents); // amount range
+            maxStore = std::max(maxStore, p.store); maxCity = std::max(maxCity, p.city); maxItem = std::max(maxItem, p.item); // id ranges
+            (p.kind == static_cast<uint8_t>(FinEvent::Kind::Paycheck) ? h.paycheckCents : h.purchaseCents) += p.cents; // totals for the estimates
+        } // end for
+        h.dateBits = static_cast<uint8_t>(bitWidth(h.maxDate - h.minDate)); // date offsets
+        h.centsBits = static_cast<uint8_t>(bitWidth(static_cast<uint64_t>(maxCents) - static_cast<uint64_t>(h.minCents))); // amount offsets
+        h.storeBits = static_cast<uint8_t>(bitWidth(maxStore)); // store ids
+        h.cityBits = static_cast<uint8_t>(bitWidth(maxCity)); // city ids
+        h.itemBits = static_cast<uint8_t>(bitWidth(maxItem)); // item ids
+        h.bitOffset = m_bits; // columns start here
+        for (const Pending& p : m_pending) putBits(p.date - h.minDate, h.dateBits); // date column
+        for (const Pending& p : m_pending) putBits(static_cast<uint64_t>(p.cents) - static_cast<uint64_t>(h.minCents), h.centsBits); // cents column
+        for (const Pending& p : m_pending) putBits(p.kind, 1); // kind column
+        for (const Pending& p : m_pending) putBits(p.store, h.storeBits); // store column
+        for (const Pending& p : m_pending) putBits(p.city, h.cityBits); // city column
+        for (const Pending& p : m_pending) putBits(p.item, h.itemBits); // item column
+        if (m_words.size() < (m_bits >> 6) + 2) m_words.resize((m_bits >> 6) + 2, 0); // spare word even for an all zero width block
+        if (!m_blocks.empty() && m_blocks.back().rows != kPackedBlockRows) m_uniform = false; // appends resumed after a seal
+        m_blocks.push_back(h); // publish the block
+        m_rows += m_pending.size(); // count rows
+        m_pending.clear(); // start the next block
+    } // end encodeBlock
+
+    std::size_t PackedHistory::decode(std::size_t b, PackedRows& out) const { // unpack one block
+        const PackedBlock& h = m_blocks[b]; // skip header
+        const uint64_t* words = m_words.data(); // column stream
+        std::size_t n = h.rows; // rows
+        uint64_t bit = h.bitOffset; // column start
+        unpack<PackedDate>(words, bit, h.dateBits, n, h.minDate, out.dates); bit += n * h.dateBits; // dates
+        unpack<int64_t>(words, bit, h.centsBits, n, h.minCents, out.cents); bit += n * h.centsBits; // amounts
+        unpack<uint8_t>(words, bit, 1, n, 0, out.kinds); bit += n; // kinds
+        unpack<uint32_t>(words, bit, h.storeBits, n, 0, out.stores); bit += n * h.storeBits; // stores
+        unpack<uint32_t>(words, bit, h.cityBits, n, 0, out.cities); bit += n * h.cityBits; // cities
+        unpack<uint32_t>(words, bit, h.itemBits, n, 0, out.items); // items
+        return n; // rows decoded
+    } // end decode
+
+    FinRow PackedHistory::row(std::size_t i) const { // random access
+        std::size_t b = i / kPackedBlockRows, first = b * kPackedBlockRows; // every block but the last is full
+        if (!m_uniform) for (b = 0, first = 0; first + m_blocks[b].rows <= i; ++b) first += m_blocks[b].rows; // a short block was sealed mid history, walk the row counts
+        const PackedBlock& h = m_blocks[b]; // skip header
+        const uint64_t* words = m_words.data(); // column stream
+        uint64_t j = i - first, n = h.rows, bit = h.bitOffset; // row in block, rows, column start
+        PackedDate date = h.minDate + static_cast<PackedDate>(getBits(words, bit + j * h.dateBits, widthMask(h.dateBits))); bit += n * h.dateBits; // date
+        int64_t cents = h.minCents + static_cast<int64_t>(getBits(words, bit + j * h.centsBits, widthMask(h.centsBits))); bit += n * h.centsBits; // amount
+        uint8_t kind = static_cast<uint8_t>(getBits(words, bit + j, 1)); bit += n; // kind
+        uint32_t store = static_cast<uint32_t>(getBits(words, bit + j * h.storeBits, widthMask(h.storeBits))); bit += n * h.storeBits; // store
+        uint32_t city = static_cast<uint32_t>(getBits(words, bit + j * h.cityBits, widthMask(h.cityBits))); bit += n * h.cityBits; // city
+        uint32_t item = static_cast<uint32_t>(getBits(words, bit + j * h.itemBits, widthMask(h.itemBits))); // item
+        return FinRow{ static_cast<FinEvent::Kind>(kind), date, cents, name(store), name(city), name(item) }; // assemble
+    } // end row
+
+    std::size_t PackedHistory::scan(PackedDate from, PackedDate to, bool (*fn)(const FinRow&, void*), void* ctx) const { // visit rows in range
+        PackedRows rows; // decoded block, reused
+        std::size_t decoded = 0; // blocks unpacked
+        for (std::size_t b = 0; b < m_blocks.size(); ++b) { // each block
+            const PackedBlock& h = m_blocks[b]; // skip header
+            if (h.maxDate < from || h.minDate > to) continue; // nothing in range, skip without decoding
+            std::size_t n = decode(b, rows); ++decoded; // unpack the block
+            for (std::size_t i = 0; i < n; ++i) { // each row
+                if (rows.dates[i] < from || rows.dates[i] > to) continue; // outside the range
+                if (!fn(FinRow{ static_cast<FinEvent::Kind>(rows.kinds[i]), rows.dates[i], rows.cents[i], name(rows.stores[i]), name(rows.cities[i]), name(rows.items[i]) }, ctx)) return decoded; // caller is done
+            } // end for
+        } // end for
+        return decoded; // blocks unpacked
+    } // end scan
+
+    int64_t PackedHistory::totalCents(FinEvent::Kind kind) const { // sum from the skip headers
+        int64_t sum = 0; // running total
+        for (const PackedBlock& h : m_blocks) sum += kind == FinEvent::Kind::Paycheck ? h.paycheckCents : h.purchaseCents; // one add per block
+        return sum; // total cents
+    } // end totalCents
+
+    std::size_t PackedHistory::bytes() const { // heap footprint
+        return m_blocks.capacity() * sizeof(PackedBlock) + m_words.capacity() * sizeof(uint64_t) + m_pending.capacity() * sizeof(Pending) // headers, columns and staging
+            + m_names.capacity() + m_nameOffsets.capacity() * sizeof(uint32_t); // dictionary, the append time lookup table is released by seal
+    } // end bytes
+
+    MemoryUsage PackedHistory::usage() const { // footprint split for reports
+        MemoryUsage u; // result
+        AddVector(u, m_blocks); AddVector(u, m_words); AddVector(u, m_pending); AddVector(u, m_nameOffsets); // headers, columns, staging and offsets
+        AddString(u, m_names); // dictionary text
+        u.encodedBytes = u.entryBytes + u.stringBytes; // all of it is encoded history rather than event slots
+        u.entryBytes = 0; u.stringBytes = 0; // moved above
+        u.items = m_rows; // rows encoded
+        return u; // footprint
+    } // end usage
+
+}
@@ -0,0 +1,79 @@
+#pragma once // prevent multiple inclusion of this header file
+#include "Finance.h" // include FinEvent and FinRow
+#include "Calendar.h" // include packed dates
+#include "MemoryUsage.h" // include footprint reports
+#include <string> // include string for the name dictionary
+#include <string_view> // include string_view names
+#include <unordered_map> // include name to id map while appending
+#include <vector> // include vector container
+#include <cstdint> // include fixed width integer types
+
+namespace atmapp { // begin atmapp namespace
+
+    // Compressed history layout. Rows are grouped in blocks of kPackedBlockRows, each with a PackedBlock skip header.
+    // A block's columns are bit packed one after another at the widths the header records:
+    //   date                                PackedDate minus the block's minDate
+    //   cents                               amount minus the block's minCents
+    //   kind                                one bit, paycheck set
+    //   store, city, item                   dictionary ids
+    // Every field of every row sits at a computable bit position, so single rows decode without their neighbours.
+
+    const uint32_t kPackedBlockRows = 1024; // rows per block
+
+    struct PackedBlock { // skip header, enough to answer range and total queries without decoding
+        PackedDate minDate; // oldest date in the block
+        PackedDate maxDate; // newest date in the block
+        uint32_t rows; // rows in the block
+        uint8_t dateBits; // width of the date column
+        uint8_t centsBits; // width of the cents column
+        uint8_t storeBits; // width of the store column
+        uint8_t cityBits; // width of the city column
+        uint8_t itemBits; // width of the item column
+        int64_t minCents; // cents column base
+        int64_t purchaseCents; // sum of purchases in the block
+        int64_t paycheckCents; // sum of paychecks in the block
+        uint64_t bitOffset; // first bit of the block's columns
+    }; // end of PackedBlock struct
+
+    struct PackedRows { // one decoded block, column by column
+        PackedDate dates[kPackedBlockRows]; // event days
+        int64_t cents[kPackedBlockRows]; // amounts
+        uint8_t kinds[kPackedBlockRows]; // FinEvent::Kind values
+        uint32_t stores[kPackedBlockRows]; // store ids
+        uint32_t cities[kPackedBlockRows]; // city ids
+        uint32_t items[kPackedBlockRows]; // item ids
+    }; // end of PackedRows struct
+
+    class PackedHistory { // bit packed event history held in memory
+    public: // public interface
+        void append(const FinRow& r); // add one row, names are copied into the dictionary
+        void seal(); // encode the rows still pending, call after the last append
+        std::size_t size() const { return m_rows; } // rows encoded
+        std::size_t blocks() const { return m_blocks.size(); } // block count
+        const PackedBlock& block(std::size_t b) const { return m_blocks[b]; } // skip header for one block
+        std::size_t decode(std::size_t b, PackedRows& out) const; // unpack every column of block b, return its row count
+        FinRow row(std::size_t i) const; // random access to row i without decoding its block
+        std::string_view name(uint32_t id) const { return std::string_view(m_names.data() + m_nameOffsets[id], m_nameOffsets[id + 1] - m_nameOffsets[id]); } // dictionary entry
+        std::size_t scan(PackedDate from, PackedDate to, bool (*fn)(const FinRow&, void*), void* ctx) const; // visit rows dated within [from, to] in order until fn returns false, return blocks decoded
+        int64_t totalCents(FinEvent::Kind kind) const; // sum of one kind, read from the skip headers
+        std::size_t bytes() const; // heap bytes held, headers, columns and dictionary
+        MemoryUsage usage() const; // the same bytes as encoded data and slack, with rows as items
+
+    private: // internal helpers and data
+        uint32_t intern(std::string_view s); // dictionary id for a name
+        void encodeBlock(); // pack the pending rows into a new block
+        void putBits(uint64_t value, unsigned width); // append bits to the column stream
+
+        struct Pending { PackedDate date; int64_t cents; uint8_t kind; uint32_t store, city, item; }; // row waiting for a full block
+        std::vector<PackedBlock> m_blocks; // skip headers
+        std::vector<uint64_t> m_words; // bit packed columns, padded so reads may run one word past the end
+        uint64_t m_bits = 0; // bits written
+        std::size_t m_rows = 0; // rows encoded
+        bool m_uniform = true; // every block but the last holds kPackedBlockRows rows, so row() can divide
+        std::vector<Pending> m_pending; // rows of the block being filled
+        std::string m_names; // dictionary text
+        std::vector<uint32_t> m_nameOffsets{ 0 }; // start of each name, plus the end of the last
+        std::unordered_map<std::string, uint32_t> m_ids; // name to id while appending
+    }; // end of PackedHistory class
+
+}
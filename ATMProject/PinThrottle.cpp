@@ -0,0 +1,104 @@
+#include "PinThrottle.h" // include header for the attempt table
+#include <chrono> // include the steady clock
+
+namespace atmapp { // begin atmapp namespace
+
+    static std::size_t homeSlot(uint64_t key, std::size_t mask) { // SplitMix64 finalizer of the card bits
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull; // first multiply
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBull; // second multiply
+        return static_cast<std::size_t>(key ^ (key >> 31)) & mask; // power of two table
+    } // end homeSlot
+
+    PinThrottle::PinThrottle(std::size_t slots, uint32_t maxFailures, uint32_t bucketSeconds) // allocate the table
+        : m_mask(0), m_max(maxFailures ? maxFailures : 1), m_bucketSeconds(bucketSeconds ? bucketSeconds : 1) { // at least one failure and one second
+        std::size_t n = kThrottleProbe; // at least one probe window
+        while (n < slots) n <<= 1; // round up
+        m_slots.reset(new Slot[n]); // every slot free
+        m_mask = n - 1; // index mask
+    } // end constructor
+
+    uint32_t PinThrottle::Now() { // coarse seconds
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); // wraps after a century of uptime
+    } // end Now
+
+    PinThrottle::Slot* PinThrottle::find(uint64_t key) const { // lookup only
+        std::size_t home = homeSlot(key, m_mask); // first slot
+        for (std::size_t i = 0; i < kThrottleProbe; ++i) { // probe window
+            Slot& s = m_slots[(home + i) & m_mask]; // candidate
+            if (s.key.load(std::memory_order_acquire) == key) return &s; // found
+        } // end for
+        return nullptr; // never failed, or evicted
+    } // end find
+
+    PinThrottle::Slot* PinThrottle::claim(uint64_t key, uint32_t now) { // lookup or insert
+        std::size_t home = homeSlot(key, m_mask); // first slot
+        for (int pass = 0; pass < 4; ++pass) { // retry when another session takes the slot we picked
+            Slot* victim = nullptr; // least failed slot in the window
+            uint32_t victimCount = UINT32_MAX; // its failures
+            for (std::size_t i = 0; i < kThrottleProbe; ++i) { // probe window
+                Slot& s = m_slots[(home + i) & m_mask]; // candidate
+                uint64_t k = s.key.load(std::memory_order_acquire); // its card
+                if (k == key) return &s; // already tracked
+                if (k == 0) { // free slot
+                    if (s.key.compare_exchange_strong(k, key, std::memory_order_acq_rel)) return &s; // ours, state is zero from construction
+                    if (k == key) return &s; // another session inserted the same card
+                    continue; // taken by another card, keep looking
+                } // end if
+                uint32_t c = decayed(s.state.load(std::memory_order_acquire), now); // how much the slot still matters
+                if (c < victimCount) { victim = &s; victimCount = c; } // best candidate so far
+            } // end for
+            if (!victim) continue; // the window filled while scanning
+            uint64_t seen = victim->state.load(std::memory_order_acquire); // old card's count, read before the key changes
+            uint64_t old = victim->key.load(std::memory_order_acquire); // card being replaced
+            if (old == key) return victim; // raced with our own insert
+            if (victim->key.compare_exchange_strong(old, key, std::memory_order_acq_rel)) { // take it over
+                victim->state.compare_exchange_strong(seen, static_cast<uint64_t>(now) << 32, std::memory_order_acq_rel); // fresh count unless a session changed it meanwhile, then the new card keeps that count, which only errs toward locking
+                return victim; // ours
+            } // end if
+        } // end for
+        return nullptr; // the window never settled, the caller fails closed
+    } // end claim
+
+    bool PinThrottle::beginAttempt(CardId card, uint32_t now) { // reserve an attempt
+        Slot* s = claim(keyOf(card), now); // card's slot
+        if (!s) return false; // refuse rather than run untracked
+        uint64_t state = s->state.load(std::memory_order_acquire); // current word
+        while (true) { // compare exchange loop
+            uint32_t count = decayed(state, now); // failures still counted
+            if (count >= m_max) return false; // locked out
+            uint64_t next = static_cast<uint64_t>(now) << 32 | (count + 1); // one more, decay restarts from now
+            if (s->state.compare_exchange_weak(state, next, std::memory_order_acq_rel)) return true; // reserved
+        } // end while
+    } // end beginAttempt
+
+    void PinThrottle::succeeded(CardId card, uint32_t now) { // clear the card
+        Slot* s = find(keyOf(card)); // its slot
+        if (!s) return; // nothing to clear
+        s->state.store(static_cast<uint64_t>(now) << 32, std::memory_order_release); // no failures, attempts reserved by other sessions are dropped with them
+    } // end succeeded
+
+    void PinThrottle::cancelAttempt(CardId card, uint32_t now) { // undo one reservation
+        Slot* s = find(keyOf(card)); // its slot
+        if (!s) return; // evicted meanwhile, nothing to undo
+        uint64_t state = s->state.load(std::memory_order_acquire); // current word
+        while (true) { // compare exchange loop
+            uint32_t passed = quietBuckets(state, now); // buckets already applied to count
+            uint32_t count = decayed(state, now); // failures still counted
+            if (count == 0) return; // already decayed away
+            uint32_t since = static_cast<uint32_t>(state >> 32) + passed * m_bucketSeconds; // keep the decay clock of the failures that remain
+            uint64_t next = static_cast<uint64_t>(since) << 32 | (count - 1); // one fewer
+            if (s->state.compare_exchange_weak(state, next, std::memory_order_acq_rel)) return; // returned
+        } // end while
+    } // end cancelAttempt
+
+    uint32_t PinThrottle::failures(CardId card, uint32_t now) const { // read only check
+        const Slot* s = find(keyOf(card)); // its slot
+        return s ? decayed(s->state.load(std::memory_order_acquire), now) : 0; // decayed count
+    } // end failures
+
+    PinThrottle& SharedPinThrottle() { // process wide table
+        static PinThrottle table; // built on first sign in
+        return table; // shared
+    } // end SharedPinThrottle
+
+}
@@ -0,0 +1,59 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <atomic> // include per slot atomics
+#include <cstdint> // include fixed width integer types
+#include <cstddef> // include size_t
+#include <memory> // include unique_ptr for the slot array
+#include "CardId.h" // include card ids as keys
+
+namespace atmapp { // begin atmapp namespace
+
+    const std::size_t kThrottleSlots = 1 << 16; // cards tracked at once, one MiB of slots
+    const std::size_t kThrottleProbe = 16; // slots searched from a card's home slot
+
+    // PIN attempt counts shared by every session in the process, so a lockout holds across reconnects and terminals.
+    // Each slot is a card key and one state word, failures in the low half and the second they were last
+    // counted in the high half. Every change is a compare exchange on that word, with no lock anywhere.
+    // An attempt is counted before the PIN is checked and cleared again when it matches, so concurrent sessions
+    // on one card can never get more than maxFailures wrong guesses between them. Failures halve for every
+    // full bucket since the last one, so a lockout lifts one quiet bucket after the failure that caused it.
+    // When every slot near a card's home is taken, the one with the fewest failures is reused for the new card.
+    // Its state is reset only if nothing changed it during the takeover, so a count can be inherited but never lost.
+
+    class PinThrottle { // lock free attempt table keyed by card
+    public: // public interface
+        explicit PinThrottle(std::size_t slots = kThrottleSlots, uint32_t maxFailures = 3, uint32_t bucketSeconds = 300); // slots rounded up to a power of two
+        bool beginAttempt(CardId card, uint32_t now); // count one attempt before the PIN is checked, false when the card is locked out
+        void succeeded(CardId card, uint32_t now); // the PIN matched, forget the card's failures
+        void cancelAttempt(CardId card, uint32_t now); // no PIN was checked after beginAttempt, give the attempt back
+        uint32_t failures(CardId card, uint32_t now) const; // attempts counted against the card after decay
+        uint32_t attemptsLeft(CardId card, uint32_t now) const { uint32_t f = failures(card, now); return f >= m_max ? 0 : m_max - f; } // before the lockout
+        uint32_t maxFailures() const { return m_max; } // lockout threshold
+        std::size_t memoryBytes() const { return (m_mask + 1) * sizeof(Slot); } // fixed footprint
+        static uint32_t Now(); // seconds on the steady clock, the time base for now
+
+    private: // internal helpers and data
+        struct alignas(16) Slot { // one tracked card
+            std::atomic<uint64_t> key{ 0 }; // CardId bits, zero for a free slot
+            std::atomic<uint64_t> state{ 0 }; // second of the last count << 32 | failures
+        }; // end of Slot struct
+        uint32_t quietBuckets(uint64_t state, uint32_t now) const { // whole buckets since the last count
+            int32_t quiet = static_cast<int32_t>(now - static_cast<uint32_t>(state >> 32)); // seconds since, negative when another session read the clock later
+            return quiet <= 0 ? 0 : static_cast<uint32_t>(quiet) / m_bucketSeconds; // full buckets only
+        } // end quietBuckets
+        uint32_t decayed(uint64_t state, uint32_t now) const { // failures left after the quiet buckets
+            uint32_t passed = quietBuckets(state, now); // buckets since the last count
+            return passed >= 32 ? 0 : static_cast<uint32_t>(state) >> passed; // halve per bucket
+        } // end decayed
+        static uint64_t keyOf(CardId card) { return card.empty() ? ~0ull : card.bits(); } // zero marks a free slot, so an empty id gets a key of its own
+        Slot* find(uint64_t key) const; // slot holding the card, or null
+        Slot* claim(uint64_t key, uint32_t now); // slot holding the card, taking a free or the least failed one when absent
+
+        std::unique_ptr<Slot[]> m_slots; // open addressed table
+        std::size_t m_mask; // slot count minus one
+        uint32_t m_max; // failures that lock a card
+        uint32_t m_bucketSeconds; // quiet seconds that halve the failures
+    }; // end of PinThrottle class
+
+    PinThrottle& SharedPinThrottle(); // the table every SignIn and SIGNIN uses
+
+}
@@ -0,0 +1,197 @@
+#include "Server.h" // include header for the terminal server
+#include "Batch.h" // include protocol sessions, one per connection
+#include "Bank.h" // include customer records and locks
+
+#include <iostream> // include input and output stream library
+
+#if defined(__linux__)
+#include <sys/epoll.h> // include epoll event loop
+#include <sys/socket.h> // include socket calls
+#include <sys/un.h> // include Unix domain addresses
+#include <unistd.h> // include close, read and write
+#include <fcntl.h> // include non blocking flags
+#include <csignal> // include signal handling for shutdown
+#include <cerrno> // include errno codes
+#include <cstring> // include strerror and memcpy
+#include <memory> // include unique_ptr for connections
+#include <string_view> // include string_view for line scanning
+#include <thread> // include worker threads
+#include <unordered_map> // include connection table per thread
+#include <vector> // include thread list and event arrays
+#endif
+
+namespace atmapp { // begin atmapp namespace
+
+#if defined(__linux__)
+
+    static volatile std::sig_atomic_t g_serverSignal = 0; // set by SIGINT or SIGTERM when no stop flag is given
+
+    extern "C" void atmappServerSignal(int) { // async signal safe handler, only sets a flag
+        g_serverSignal = 1; // request shutdown
+    } // end atmappServerSignal
+
+    const std::size_t kOutboxHighWater = 65536; // unsent reply bytes at which a terminal's input stops being read
+
+    struct Connection { // one terminal, driven by events instead of a blocked thread
+        enum class State { Reading, Flushing, Closing }; // Reading waits for commands, Flushing waits for the socket to drain, Closing drops the terminal
+        int fd; // socket
+        State state; // where the terminal is in its life cycle
+        BatchSession session; // signed in card and protocol state
+        std::string pending; // partial command line
+        std::string outbox; // replies not yet written
+        std::size_t sent; // bytes of outbox already written
+        bool watchingOut; // whether EPOLLOUT is in the interest set
+        bool readPaused; // input left unread until the outbox drains, the socket buffer pushes back on the terminal
+        bool inputDone; // the peer half closed or sent an absurd line, close once the outbox drains
+        Connection(int f, Bank& bank, ShardedTxLog* log, FinanceLog* fin) : fd(f), state(State::Reading), session(bank, log, fin), sent(0), watchingOut(false), readPaused(false), inputDone(false) {} // new terminal
+    }; // end of Connection struct
+
+    static bool setNonBlocking(int fd) { // switch a descriptor to non blocking mode
+        int flags = fcntl(fd, F_GETFL, 0); // current flags
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0; // add O_NONBLOCK
+    } // end setNonBlocking
+
+    static void flushOutbox(Connection& c) { // write as much of the outbox as the socket takes
+        while (c.sent < c.outbox.size()) { // bytes remain
+            ssize_t n = ::send(c.fd, c.outbox.data() + c.sent, c.outbox.size() - c.sent, MSG_NOSIGNAL); // write without SIGPIPE
+            if (n > 0) { c.sent += static_cast<std::size_t>(n); continue; } // progress
+            if (n < 0 && errno == EINTR) continue; // retry
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { c.state = Connection::State::Flushing; return; } // wait for EPOLLOUT
+            c.state = Connection::State::Closing; // peer went away
+            return; // stop writing
+        } // end while
+        c.outbox.clear(); // everything written
+        c.sent = 0; // reset cursor
+        if (c.state == Connection::State::Flushing) c.state = Connection::State::Reading; // back to reading commands
+    } // end flushOutbox
+
+    static uint64_t readCommands(Connection& c) { // drain the socket and execute complete lines, pausing when replies back up
+        uint64_t executed = 0; // commands run
+        char buf[16384]; // read buffer
+        c.readPaused = false; // reading again
+        while (true) { // edge triggered, read until EAGAIN or the high-water mark
+            if (c.outbox.size() - c.sent >= kOutboxHighWater) { c.readPaused = true; break; } // the terminal is not reading its replies
+            ssize_t n = ::read(c.fd, buf, sizeof(buf)); // read bytes
+            if (n > 0) { // got data
+                std::string_view chunk(buf, static_cast<std::size_t>(n)); // new bytes
+                std::size_t pos = 0; // scan position
+                while (true) { // each complete line
+                    std::size_t nl = chunk.find('\n', pos); // end of line
+                    if (nl == std::string_view::npos) break; // partial line
+                    if (!c.pending.empty()) { // line started earlier
+                        c.pending.append(chunk.data() + pos, nl - pos); // finish it
+                        if (c.session.execute(c.pending, c.outbox)) ++executed; // run it
+                        c.pending.clear(); // reset
+                    }
+                    else if (c.session.execute(chunk.substr(pos, nl - pos), c.outbox)) ++executed; // run in place
+                    pos = nl + 1; // next line
+                } // end while
+                c.pending.append(chunk.data() + pos, chunk.size() - pos); // keep the partial line
+                if (c.pending.size() > 4096) { c.inputDone = true; break; } // refuse absurd lines, answer what came before
+                continue; // keep reading
+            } // end if
+            if (n == 0) { c.inputDone = true; break; } // peer closed its end, replies can still go out
+            if (errno == EINTR) continue; // retry
+            if (errno != EAGAIN && errno != EWOULDBLOCK) c.state = Connection::State::Closing; // read error
+            break; // drained
+        } // end while
+        return executed; // commands run
+    } // end readCommands
+
+    struct WorkerTotals { // per thread counters, summed after the threads stop
+        uint64_t connections = 0; // accepted terminals
+        uint64_t commands = 0; // executed commands
+    }; // end of WorkerTotals struct
+
+    static void eventLoop(int listenFd, Bank& bank, ShardedTxLog* log, FinanceLog* fin, const std::atomic<bool>* stop, WorkerTotals& totals) { // one thread serving many terminals
+        int ep = epoll_create1(EPOLL_CLOEXEC); // this thread's epoll set
+        if (ep < 0) return; // cannot serve
+        epoll_event lev{}; // listening socket registration
+        lev.events = EPOLLIN | EPOLLEXCLUSIVE; // wake only one thread per new connection
+        lev.data.ptr = nullptr; // null marks the listener
+        epoll_ctl(ep, EPOLL_CTL_ADD, listenFd, &lev); // watch for new terminals
+        std::unordered_map<int, std::unique_ptr<Connection>> conns; // terminals owned by this thread
+        std::vector<epoll_event> events(256); // ready list
+        auto closeConn = [&](Connection* c) { epoll_ctl(ep, EPOLL_CTL_DEL, c->fd, nullptr); ::close(c->fd); conns.erase(c->fd); }; // drop a terminal
+        while (!(stop ? stop->load(std::memory_order_relaxed) : g_serverSignal != 0)) { // until asked to stop
+            int n = epoll_wait(ep, events.data(), static_cast<int>(events.size()), 100); // short timeout so the stop flag is noticed
+            for (int i = 0; i < n; ++i) { // each ready descriptor
+                if (events[i].data.ptr == nullptr) { // listener
+                    while (true) { // accept everything queued
+                        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC); // new terminal
+                        if (fd < 0) break; // queue empty or another thread took it
+                        auto conn = std::make_unique<Connection>(fd, bank, log, fin); // session state
+                        epoll_event cev{}; // connection registration
+                        cev.events = EPOLLIN | EPOLLRDHUP | EPOLLET; // edge triggered reads
+                        cev.data.ptr = conn.get(); // find the state from the event
+                        if (epoll_ctl(ep, EPOLL_CTL_ADD, fd, &cev) != 0) { ::close(fd); continue; } // could not watch it
+                        conns.emplace(fd, std::move(conn)); // keep it
+                        ++totals.connections; // count it
+                    } // end while
+                    continue; // next event
+                } // end if
+                Connection* c = static_cast<Connection*>(events[i].data.ptr); // terminal with activity
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) c->state = Connection::State::Closing; // broken socket
+                if (c->state != Connection::State::Closing && (events[i].events & EPOLLOUT)) flushOutbox(*c); // socket drained
+                bool readable = (events[i].events & (EPOLLIN | EPOLLRDHUP)) != 0; // commands arrived, ignored while paused
+                while (c->state != Connection::State::Closing && !c->inputDone && (c->readPaused ? c->outbox.empty() : readable)) { // no new edge comes for input left unread, so resume once the replies are out
+                    readable = false; // one pass per edge
+                    totals.commands += readCommands(*c); // execute them
+                    if (!c->outbox.empty()) flushOutbox(*c); // write replies, also those to a peer that already half closed
+                } // end while
+                if (c->inputDone && c->outbox.empty()) c->state = Connection::State::Closing; // every reply delivered, otherwise EPOLLOUT finishes the job
+                if (c->state == Connection::State::Closing) { closeConn(c); continue; } // drop it
+                bool wantOut = c->state == Connection::State::Flushing; // EPOLLOUT only while replies are stuck
+                if (wantOut == c->watchingOut) continue; // interest unchanged, no system call
+                epoll_event mod{}; // update interest
+                mod.events = EPOLLIN | EPOLLRDHUP | EPOLLET | (wantOut ? static_cast<uint32_t>(EPOLLOUT) : 0u); // read always, write while flushing
+                mod.data.ptr = c; // same state pointer
+                epoll_ctl(ep, EPOLL_CTL_MOD, c->fd, &mod); // apply
+                c->watchingOut = wantOut; // remember it
+            } // end for
+        } // end while
+        for (auto& kv : conns) ::close(kv.first); // close every remaining terminal
+        ::close(ep); // release the epoll set
+    } // end eventLoop
+
+    bool ServerSupported() { return true; } // epoll is available
+
+    bool RunServer(const ServerOptions& opts, Bank& bank, FinanceLog* fin, ServerStats& stats, std::ostream& err) { // listen and run the event loops
+        stats = ServerStats{ 0, 0 }; // reset totals
+        sockaddr_un addr{}; // socket address
+        if (opts.socketPath.empty() || opts.socketPath.size() >= sizeof(addr.sun_path)) { err << "Socket path is empty or too long.\n"; return false; } // path must fit
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0); // listening socket
+        if (fd < 0) { err << "socket failed. " << std::strerror(errno) << "\n"; return false; } // no socket
+        addr.sun_family = AF_UNIX; // Unix domain
+        std::memcpy(addr.sun_path, opts.socketPath.c_str(), opts.socketPath.size() + 1); // copy path with terminator
+        ::unlink(opts.socketPath.c_str()); // replace a stale socket file
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, opts.backlog) != 0 || !setNonBlocking(fd)) { // bind and listen
+            err << "Cannot listen on " << opts.socketPath << ". " << std::strerror(errno) << "\n"; // report
+            ::close(fd); // release
+            return false; // setup failed
+        } // end if
+        if (!opts.stop) { g_serverSignal = 0; std::signal(SIGINT, atmappServerSignal); std::signal(SIGTERM, atmappServerSignal); } // Ctrl C stops the server
+        int threads = opts.threads > 0 ? opts.threads : 1; // at least one loop
+        std::vector<WorkerTotals> totals(static_cast<std::size_t>(threads)); // per thread counters
+        std::vector<std::thread> pool; // event loop threads
+        for (int t = 0; t < threads; ++t) pool.emplace_back(eventLoop, fd, std::ref(bank), opts.log, fin, opts.stop, std::ref(totals[static_cast<std::size_t>(t)])); // start loops
+        for (auto& t : pool) t.join(); // run until stopped
+        ::close(fd); // stop listening
+        ::unlink(opts.socketPath.c_str()); // remove the socket file
+        for (const auto& t : totals) { stats.connections += t.connections; stats.commands += t.commands; } // sum totals
+        return true; // clean shutdown
+    } // end RunServer
+
+#else
+
+    bool ServerSupported() { return false; } // epoll and Unix sockets are Linux only here
+
+    bool RunServer(const ServerOptions&, Bank&, FinanceLog*, ServerStats& stats, std::ostream& err) { // stub for other platforms
+        stats = ServerStats{ 0, 0 }; // nothing served
+        err << "Server mode needs Linux epoll and Unix domain sockets.\n"; // explain
+        return false; // not available
+    } // end RunServer
+
+#endif
+
+}
\ No newline at end of file
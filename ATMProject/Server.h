@@ -0,0 +1,29 @@
+#pragma once // prevent multiple inclusion of this header file
+#include <string> // include string for the socket path
+#include <atomic> // include atomic stop flag
+#include <cstdint> // include fixed width integer types
+#include <iosfwd> // forward declare iostream types for efficiency
+
+namespace atmapp { // begin atmapp namespace
+
+    class Bank; // forward declaration of Bank class
+    class FinanceLog; // forward declaration of FinanceLog class
+    class ShardedTxLog; // forward declaration of ShardedTxLog class
+
+    struct ServerOptions { // settings for the terminal server
+        std::string socketPath; // Unix domain socket to listen on, replaced if it already exists
+        int threads = 2; // event loop threads, each with its own epoll set
+        int backlog = 1024; // pending connection queue length
+        const std::atomic<bool>* stop = nullptr; // caller owned stop flag, SIGINT and SIGTERM are used when null
+        ShardedTxLog* log = nullptr; // caller owned transaction log, each event loop appends to its own shard, null to skip logging
+    }; // end of ServerOptions struct
+
+    struct ServerStats { // totals reported when the server stops
+        uint64_t connections; // terminals accepted
+        uint64_t commands; // protocol commands executed
+    }; // end of ServerStats struct
+
+    bool ServerSupported(); // whether this platform has the epoll server
+    bool RunServer(const ServerOptions& opts, Bank& bank, FinanceLog* fin, ServerStats& stats, std::ostream& err); // serve the batch protocol until stopped, false on setup failure
+
+}
\ No newline at end of file
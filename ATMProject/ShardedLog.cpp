@@ -0,0 +1,207 @@
+#include "ShardedLog.h" // include header for sharded transaction logging
+#include "Timeline.h" // include the loser tree merge
+#include <algorithm> // include min and swap
+#include <limits> // include numeric limits for the frontier
+#include <ctime> // include localtime and strftime for stamps
+
+namespace atmapp { // begin atmapp namespace
+
+    static std::atomic<uint64_t> g_nextShardedLogId{ 1 }; // ids are never reused, so a stale cache entry can never match
+
+    struct ShardCacheEntry { uint64_t owner; void* shard; }; // one log's shard for the current thread
+    static thread_local ShardCacheEntry t_shardCache[4] = {}; // a thread rarely appends to more than a few logs
+    static thread_local unsigned t_shardCacheNext = 0; // round robin replacement
+
+    static uint64_t steadyNs() { // sequence clock, monotonic across threads
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()) | 1; // never zero, zero means idle
+    } // end steadyNs
+
+    static int64_t wallOffsetNs() { // system clock minus the sequence clock
+        int64_t wall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(); // wall time
+        return wall - static_cast<int64_t>(steadyNs()); // fixed for the life of the log, so stamps follow the sequence
+    } // end wallOffsetNs
+
+    ShardedTxLog::ShardedTxLog() : m_id(g_nextShardedLogId.fetch_add(1)), m_wallOffset(wallOffsetNs()) { // unique id and clock offset
+    } // end constructor
+
+    ShardedTxLog::~ShardedTxLog() { stop(); } // merge everything before the shards go away
+
+    void ShardedTxLog::start(std::chrono::milliseconds period) { // launch the merger
+        if (m_merger.joinable()) return; // already running
+        { std::lock_guard<std::mutex> guard(m_wakeLock); m_stopping = false; } // allow it to run
+        m_merger = std::thread(&ShardedTxLog::mergerLoop, this, period); // background thread
+    } // end start
+
+    void ShardedTxLog::stop() { // join and merge the rest
+        if (m_merger.joinable()) { // running
+            { std::lock_guard<std::mutex> guard(m_wakeLock); m_stopping = true; } // ask it to exit
+            m_wake.notify_all(); // cut its sleep short
+            m_merger.join(); // wait
+        } // end if
+        mergePass(true); // appends are over, everything can be emitted
+    } // end stop
+
+    void ShardedTxLog::flush() { // merge everything appended before now
+        uint64_t until = steadyNs(); // entries numbered up to here must reach the history
+        while (mergePass(false) <= until) std::this_thread::yield(); // an older append is still being written, let it finish
+    } // end flush
+
+    ShardedTxLog::Shard& ShardedTxLog::local() { // this thread's shard
+        for (const auto& e : t_shardCache) if (e.owner == m_id) return *static_cast<Shard*>(e.shard); // fast path, no shared state
+        std::lock_guard<std::mutex> guard(m_registryLock); // first append from this thread, or a cache miss
+        Shard*& slot = m_byThread[std::this_thread::get_id()]; // find or create
+        if (!slot) { // new thread
+            auto shard = std::make_unique<Shard>(); // ring
+            shard->slots.resize(kTxShardSlots); // fixed capacity
+            shard->index = static_cast<uint32_t>(m_shards.size()); // tie break order
+            slot = shard.get(); // remember
+            m_shards.push_back(std::move(shard)); // own it
+        } // end if
+        t_shardCache[t_shardCacheNext++ % 4] = ShardCacheEntry{ m_id, slot }; // cache it
+        return *slot; // shard
+    } // end local
+
+    ShardedTxLog::Record& ShardedTxLog::beginAppend(Shard*& shard, TxType type) { // claim a slot
+        Shard& s = local(); // this thread's ring
+        shard = &s; // for endAppend
+        s.busy.store(s.lastSeq, std::memory_order_seq_cst); // the previous number is a lower bound of the next one, published before the clock is read
+        uint64_t seq = steadyNs(); // sequence number, at least busy
+        s.lastSeq = seq; // lower bound for the next append
+        int64_t second = (static_cast<int64_t>(seq) + m_wallOffset) / 1000000000; // wall clock second of this append, never behind an earlier sequence number
+        if (second != s.stampSecond) { // new second
+            std::time_t t = static_cast<std::time_t>(second); // seconds since the epoch
+            std::tm localTime{}; // structure for local time data
+#if defined(_WIN32)
+            localtime_s(&localTime, &t); // convert to local time on Windows
+#else
+            localtime_r(&t, &localTime); // convert to local time on other systems
+#endif
+            char buf[32]; // buffer to hold formatted date
+            s.stamp.assign(buf, std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &localTime)); // same format as interactive sessions
+            s.stampSecond = second; // remember its second
+        } // end if
+        std::size_t tail = s.tail.load(std::memory_order_relaxed); // only this thread writes tail
+        while (tail - s.head.load(std::memory_order_acquire) >= kTxShardSlots) mergePass(false); // ring full, drain it ourselves rather than wait on the merger
+        Record& r = s.slots[tail % kTxShardSlots]; // slot, strings keep their capacity
+        r.seq = seq; // order key
+        r.tx.type = type; // kind
+        r.tx.timestamp.assign(s.stamp); // stamp covered by the watermark, a stamp taken before busy could sort behind an emitted entry
+        return r; // caller fills the rest
+    } // end beginAppend
+
+    void ShardedTxLog::endAppend(Shard* shard) { // publish
+        shard->tail.store(shard->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); // entry visible to the merger
+        shard->busy.store(0, std::memory_order_release); // no append in flight
+    } // end endAppend
+
+    void ShardedTxLog::logDeposit(CardId card, double amount, double balanceAfter) { // deposit into this thread's shard
+        Shard* s; Record& r = beginAppend(s, TxType::Deposit); // slot
+        r.tx.fromCard = card; r.tx.toCard = CardId(); r.tx.amount = amount; r.tx.balanceAfter = balanceAfter; // fill in place
+        endAppend(s); // publish
+    } // end logDeposit
+
+    void ShardedTxLog::logWithdraw(CardId card, double amount, double balanceAfter) { // withdrawal into this thread's shard
+        Shard* s; Record& r = beginAppend(s, TxType::Withdraw); // slot
+        r.tx.fromCard = card; r.tx.toCard = CardId(); r.tx.amount = amount; r.tx.balanceAfter = balanceAfter; // fill in place
+        endAppend(s); // publish
+    } // end logWithdraw
+
+    void ShardedTxLog::logTransfer(CardId fromCard, CardId toCard, double amount, double fromBalanceAfter) { // transfer into this thread's shard
+        Shard* s; Record& r = beginAppend(s, TxType::Transfer); // slot
+        r.tx.fromCard = fromCard; r.tx.toCard = toCard; r.tx.amount = amount; r.tx.balanceAfter = fromBalanceAfter; // fill in place
+        endAppend(s); // publish
+    } // end logTransfer
+
+    uint64_t ShardedTxLog::mergePass(bool all) { // drain every ring, then k way merge up to the watermark
+        std::lock_guard<std::mutex> pass(m_mergeLock); // one pass at a time
+        std::vector<Shard*> shards; // snapshot of the registry
+        {
+            std::lock_guard<std::mutex> guard(m_registryLock); // new threads may be registering
+            for (const auto& s : m_shards) shards.push_back(s.get()); // raw pointers, shards live as long as the log
+        }
+        uint64_t watermark = all ? std::numeric_limits<uint64_t>::max() : steadyNs(); // later appends take larger numbers
+        for (Shard* s : shards) { // in flight appends hold the watermark at their lower bound
+            uint64_t busy = all ? 0 : s->busy.load(std::memory_order_seq_cst); // read before the tail so a published entry is never missed
+            if (busy != 0 && busy < watermark) watermark = busy; // cannot emit past an unfinished append
+        } // end for
+        for (Shard* s : shards) { // drain
+            std::size_t tail = s->tail.load(std::memory_order_acquire); // published entries
+            std::size_t head = s->head.load(std::memory_order_relaxed); // only the merger writes head
+            for (; head < tail; ++head) { // copy out so the owner can reuse the slot
+                if (s->runEnd == s->run.size()) s->run.emplace_back(); // grow once, then recycle
+                Record& d = s->run[s->runEnd++]; const Record& r = s->slots[head % kTxShardSlots]; // destination and source
+                d.seq = r.seq; d.tx.type = r.tx.type; d.tx.fromCard = r.tx.fromCard; d.tx.toCard = r.tx.toCard; d.tx.amount = r.tx.amount; d.tx.balanceAfter = r.tx.balanceAfter; // plain fields
+                d.tx.timestamp.assign(r.tx.timestamp); // text into recycled capacity
+            } // end for
+            s->head.store(head, std::memory_order_release); // slots free again
+        } // end for
+
+        std::vector<HistorySpan> spans; // per shard entries below the watermark, in append order
+        spans.reserve(shards.size()); // one per shard, the span index is the shard index
+        for (Shard* s : shards) { // each run is already in sequence order
+            s->keys.clear(); // reuse the key buffer
+            for (std::size_t i = 0; i < s->runEnd && s->run[i].seq < watermark; ++i) s->keys.push_back(TimedRow{ s->run[i].seq, static_cast<uint32_t>(i) }); // an unfinished append could still sort before the rest
+            spans.push_back(HistorySpan{ s->keys.data(), s->keys.data() + s->keys.size() }); // emittable prefix
+            s->runPos = s->keys.size(); // all of it is emitted below
+        } // end for
+        {
+            std::lock_guard<std::mutex> guard(m_historyLock); // readers wait for the pass
+            TimelineMerge merge(std::move(spans)); // loser tree over the shards, equal sequence numbers come out in shard order
+            merge.forEach([&](const TimelineEntry& e) { m_history.append(shards[e.customer]->run[e.row].tx); return true; }); // ordered history
+        }
+        uint64_t frontier = watermark; // entries numbered below this are all in the history
+        for (Shard* s : shards) { // drop emitted entries
+            for (std::size_t i = s->runPos; i < s->runEnd; ++i) frontier = std::min(frontier, s->run[i].seq); // held back entries
+            for (std::size_t i = s->runPos; i < s->runEnd && s->runPos > 0; ++i) std::swap(s->run[i - s->runPos], s->run[i]); // slide the rest to the front, swapping keeps every string buffer
+            s->runEnd -= s->runPos; // entries still waiting
+            s->runPos = 0; // restart
+        } // end for
+        return frontier; // progress for flush
+    } // end mergePass
+
+    void ShardedTxLog::mergerLoop(std::chrono::milliseconds period) { // background merging
+        std::unique_lock<std::mutex> lock(m_wakeLock); // sleep lock
+        while (!m_stopping) { // until stop
+            lock.unlock(); // never hold the sleep lock while merging
+            mergePass(false); // drain and emit
+            lock.lock(); // back to sleep
+            m_wake.wait_for(lock, period, [this] { return m_stopping; }); // next pass or stop
+        } // end while
+    } // end mergerLoop
+
+    void ShardedTxLog::print(std::ostream& out) { // ordered history
+        flush(); // everything appended so far
+        std::lock_guard<std::mutex> guard(m_historyLock); // the merger may be appending
+        m_history.print(out); // same format as a session log
+    } // end print
+
+    uint64_t ShardedTxLog::appended() const { // published entries across shards
+        std::lock_guard<std::mutex> guard(m_registryLock); // shard list
+        uint64_t n = 0; // sum
+        for (const auto& s : m_shards) n += s->tail.load(std::memory_order_acquire); // cumulative counts
+        return n; // total
+    } // end appended
+
+    uint64_t ShardedTxLog::merged() const { // ordered entries
+        std::lock_guard<std::mutex> guard(m_historyLock); // the merger may be appending
+        return m_history.size(); // both tiers
+    } // end merged
+
+    std::size_t ShardedTxLog::shards() const { // registered threads
+        std::lock_guard<std::mutex> guard(m_registryLock); // shard list
+        return m_shards.size(); // count
+    } // end shards
+
+    MemoryUsage ShardedTxLog::memoryUsage() const { // history and rings
+        std::lock_guard<std::mutex> pass(m_mergeLock); // the merger resizes runs during a pass
+        MemoryUsage u; // result
+        { std::lock_guard<std::mutex> guard(m_historyLock); u = m_history.memoryUsage(); } // ordered entries
+        std::lock_guard<std::mutex> guard(m_registryLock); // shard list
+        for (const auto& sh : m_shards) { // each thread's ring
+            u.entryBytes += sizeof(Shard); ++u.allocations; // the shard itself
+            AddVector(u, sh->slots); AddVector(u, sh->run); AddVector(u, sh->keys); // ring, drain slots and merge keys, their strings belong to the appending threads and are not read
+        } // end for
+        return u; // footprint
+    } // end memoryUsage
+
+}
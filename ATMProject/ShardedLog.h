@@ -0,0 +1,89 @@
+#pragma once // prevent multiple inclusion of this header file
+#include "Transaction.h" // include Transaction and the tiered history
+#include "Timeline.h" // include TimedRow merge keys
+#include <atomic> // include shard cursors and flags
+#include <condition_variable> // include merger wake ups
+#include <chrono> // include merge period
+#include <memory> // include unique_ptr shards
+#include <mutex> // include registry and history locks
+#include <string> // include string for stamp text
+#include <thread> // include merger thread and thread ids
+#include <unordered_map> // include thread to shard map
+#include <vector> // include vector container
+#include <cstdint> // include fixed width integer types
+#include <iosfwd> // forward declare iostream types for efficiency
+
+namespace atmapp { // begin atmapp namespace
+
+    const std::size_t kTxShardSlots = 1 << 14; // entries each thread can have waiting for the merger
+
+    // Every appending thread owns one shard, a single producer ring read only by the merger.
+    // Entries carry a steady clock sequence number taken at append time, and their timestamp text is derived from that number,
+    // so stamps rise with the sequence. The merger drains every ring, then emits entries in (sequence, shard) order up to a
+    // watermark that no append still in flight can fall below, so the history never has to be reordered once written.
+    // The merge is the TimelineMerge loser tree, with sequence numbers as the times and shards as the customers.
+
+    class ShardedTxLog { // concurrent transaction logging without a shared lock on the append path
+    public: // public interface
+        ShardedTxLog(); // no shards, merger not running
+        ~ShardedTxLog(); // stop the merger and merge what is left
+        ShardedTxLog(const ShardedTxLog&) = delete; // shards are tied to this instance
+        ShardedTxLog& operator=(const ShardedTxLog&) = delete; // shards are tied to this instance
+
+        void start(std::chrono::milliseconds period = std::chrono::milliseconds(2)); // run the background merger
+        void stop(); // join the merger and merge every entry, appends must have finished
+        void flush(); // merge every entry appended before the call, from any thread
+
+        void logDeposit(CardId card, double amount, double balanceAfter); // record a deposit in this thread's shard, stamped at append time
+        void logWithdraw(CardId card, double amount, double balanceAfter); // record a withdrawal in this thread's shard, stamped at append time
+        void logTransfer(CardId fromCard, CardId toCard, double amount, double fromBalanceAfter); // record a transfer in this thread's shard, stamped at append time
+
+        void print(std::ostream& out); // flush, then print the ordered history
+        template <typename Fn> void forEach(Fn&& fn) { // flush, then visit the ordered history oldest first until fn returns false
+            flush(); // everything appended so far
+            std::lock_guard<std::mutex> guard(m_historyLock); // the merger may be appending
+            m_history.forEach(std::forward<Fn>(fn)); // ordered entries
+        } // end forEach
+        uint64_t appended() const; // entries accepted by every shard
+        uint64_t merged() const; // entries in the ordered history
+        std::size_t shards() const; // threads that have appended
+        MemoryUsage memoryUsage() const; // ordered history plus every shard ring, waits for a merge pass in progress
+
+    private: // internal helpers and data
+        struct Record { Transaction tx; uint64_t seq; }; // one ring entry
+        struct Shard { // one thread's ring, cursors on separate cache lines
+            alignas(64) std::atomic<uint64_t> busy{ 0 }; // while an append is in flight, a lower bound of its sequence number, otherwise zero
+            uint64_t lastSeq = 1; // owner side: sequence number of the previous append, one before the first
+            int64_t stampSecond = -1; // owner side: wall clock second of the cached stamp
+            std::string stamp; // owner side: cached stamp text for stampSecond
+            alignas(64) std::atomic<std::size_t> tail{ 0 }; // entries published, written by the owner
+            alignas(64) std::atomic<std::size_t> head{ 0 }; // entries drained, written by the merger
+            std::vector<Record> slots; // ring storage
+            uint32_t index; // registration order, the final tie break
+            std::vector<Record> run; // merger side: drained entries in append order, slots past runEnd are kept for their string capacity
+            std::size_t runPos = 0; // merger side: first entry of run not yet emitted
+            std::size_t runEnd = 0; // merger side: entries of run in use
+            std::vector<TimedRow> keys; // merger side: sequence number and run position of each entry the pass can emit
+        }; // end of Shard struct
+
+        Record& beginAppend(Shard*& shard, TxType type); // claim a ring slot for this thread, mark the shard busy
+        void endAppend(Shard* shard); // publish the slot and clear busy
+        Shard& local(); // this thread's shard, registered on first use
+        uint64_t mergePass(bool all); // drain and emit up to the watermark, or everything when all is set, return the number below which every entry is merged
+        void mergerLoop(std::chrono::milliseconds period); // background thread body
+
+        const uint64_t m_id; // process unique id for the thread local shard cache
+        const int64_t m_wallOffset; // system clock minus steady clock in nanoseconds, turns a sequence number into wall time
+        mutable std::mutex m_registryLock; // guards m_shards and m_byThread
+        std::vector<std::unique_ptr<Shard>> m_shards; // every shard
+        std::unordered_map<std::thread::id, Shard*> m_byThread; // thread to shard
+        mutable std::mutex m_mergeLock; // one merge pass at a time
+        mutable std::mutex m_historyLock; // guards m_history
+        TransactionLog m_history; // ordered, tiered history
+        std::thread m_merger; // background merger
+        std::mutex m_wakeLock; // guards m_stopping for the condition variable
+        std::condition_variable m_wake; // ends the merger's sleep early on stop
+        bool m_stopping = false; // merger should exit
+    }; // end of ShardedTxLog class
+
+}
@@ -0,0 +1,155 @@
+#include "Statement.h" // include header for the statement job
+#include "Bank.h" // include customer records and locks
+#include "Transaction.h" // include transaction log
+#include "Finance.h" // include finance history
+#include "Format.h" // include row formatter
+
+#include <algorithm> // include sort and unique
+#include <atomic> // include shared work counter
+#include <chrono> // include clocks for timing
+#include <cstdio> // include fopen and fwrite
+#include <filesystem> // include create_directories
+#include <memory_resource> // include the arena for the month's entries
+#include <mutex> // include lock_guard for per customer locks
+#include <string_view> // include string_view keys
+#include <thread> // include worker threads
+#include <unordered_map> // include card to transaction index
+#include <vector> // include vector container
+
+namespace atmapp { // begin atmapp namespace
+
+    static const std::size_t kStatementChunk = 256; // customers claimed per trip to the shared counter
+
+    static const char* const kTxLabels[] = { "Deposit $", "Withdraw $", "Transfer $" }; // indexed by TxType
+
+    static bool inMonth(std::string_view text, const char* prefix) { // whether a YYYY-MM-DD... string falls in the month
+        return text.size() >= 7 && text.compare(0, 7, prefix, 7) == 0; // compare the YYYY-MM part
+    } // end inMonth
+
+    static std::string sharedHistory(const FinanceLog* fin, PackedDate month) { // purchases and paychecks, the same block for every customer
+        std::string text; // rendered block
+        RowBuffer rows(text); // memory sink
+        PackedDate first = PackDate(DateYear(month), DateMonth(month), 1); // first day of the month
+        PackedDate last = PackDate(DateYear(month), DateMonth(month), 31); // no month has a later day
+        int64_t spent = 0, earned = 0; // month totals in cents
+        bool any = false; // rows seen
+        rows.text("\n Purchases.\n"); // section header
+        if (fin) fin->forEach(first, last, [&](const FinRow& e) { // purchases in the month only, mapped files skip other months' blocks
+            if (e.kind != FinEvent::Kind::Purchase) return true; // paychecks come next
+            rows.text("  ").date(e.date).text("  $").cents(e.cents).text("  ").text(e.store).text("  ").text(e.location).text("  ").text(e.item).ch('\n'); // one purchase
+            spent += e.cents; any = true; // totals
+            return true; // keep going
+        }); // end forEach
+        if (!any) rows.text("  None.\n"); // empty section
+        rows.text("\n Paychecks.\n"); // section header
+        any = false; // reset
+        if (fin) fin->forEach(first, last, [&](const FinRow& e) { // paychecks in the month only
+            if (e.kind != FinEvent::Kind::Paycheck) return true; // purchases are done
+            rows.text("  ").date(e.date).text("  $").cents(e.cents).text("  ").text(e.store).text("  ").text(e.location).ch('\n'); // one paycheck
+            earned += e.cents; any = true; // totals
+            return true; // keep going
+        }); // end forEach
+        if (!any) rows.text("  None.\n"); // empty section
+        rows.text("\n Total purchases. $").cents(spent).ch('\n'); // spending total
+        rows.text(" Total paychecks. $").cents(earned).ch('\n'); // income total
+        return text; // return block
+    } // end sharedHistory
+
+    StatementStats WriteStatements(const StatementOptions& opts, Bank& bank, const TransactionLog* log, const FinanceLog* fin) { // partition customers across workers
+        StatementStats stats{ 0, 0, 0, 0.0, 0.0, 0.0 }; // totals
+        auto start = std::chrono::steady_clock::now(); // wall clock start
+        PackedDate month = opts.month ? opts.month : CalendarContext::Now().monthStart(0); // statement month
+        char prefix[kDateTextLength]; // YYYY-MM-DD of the month, first seven characters are compared
+        FormatDate(month, prefix); // format once
+
+        const std::string history = sharedHistory(fin, month); // one history per app, rendered once instead of per customer
+        std::pmr::monotonic_buffer_resource monthArena; // every copied entry and its strings, released together when the job ends
+        std::pmr::vector<Transaction> monthTx(&monthArena); // the month's transactions in log order, copied out of both log tiers
+        if (log) log->forEach([&](const Transaction& tx) { if (inMonth(tx.timestamp, prefix)) monthTx.push_back(tx); return true; }); // one pass over the log
+        std::unordered_map<uint64_t, std::vector<uint32_t>> byCard; // card bits to transactions in the month, in log order
+        for (uint32_t i = 0; i < monthTx.size(); ++i) { // index once, monthTx no longer grows
+            byCard[monthTx[i].fromCard.bits()].push_back(i); // originating card
+            if (!monthTx[i].toCard.empty() && monthTx[i].toCard != monthTx[i].fromCard) byCard[monthTx[i].toCard.bits()].push_back(i); // destination card
+        } // end for
+        if (!opts.dir.empty()) { std::error_code ec; std::filesystem::create_directories(opts.dir, ec); } // make the output directory
+
+        unsigned hw = std::thread::hardware_concurrency(); // available threads
+        int threads = opts.threads > 0 ? opts.threads : static_cast<int>(hw ? hw : 1); // worker count
+        std::atomic<std::size_t> next(0); // next unclaimed customer
+        std::atomic<uint64_t> failed(0), bytes(0); // shared totals, updated once per worker
+        std::atomic<uint64_t> renderNs(0), writeNs(0); // time split, updated once per worker
+        auto worker = [&] { // render and write a chunk of customers at a time
+            std::string text; // this worker's output buffer, reused for every statement
+            std::string path; // this worker's file name buffer
+            std::vector<uint32_t> txs; // this customer's transactions
+            uint64_t myFailed = 0, myBytes = 0, myRender = 0, myWrite = 0; // local totals
+            char monthText[8] = { prefix[0], prefix[1], prefix[2], prefix[3], prefix[4], prefix[5], prefix[6], 0 }; // YYYY-MM
+            while (true) { // claim chunks until none are left
+                std::size_t begin = next.fetch_add(kStatementChunk, std::memory_order_relaxed); // claim a chunk
+                if (begin >= bank.size()) break; // all claimed
+                std::size_t end = std::min(bank.size(), begin + kStatementChunk); // chunk end
+                for (std::size_t i = begin; i < end; ++i) { // each customer in the chunk
+                    auto t0 = std::chrono::steady_clock::now(); // render start
+                    text.clear(); // keep the capacity
+                    RowBuffer rows(text); // memory sink over the worker buffer
+                    double checking, savings; // balances read under the customer lock
+                    {
+                        std::lock_guard<std::mutex> guard(bank.lockFor(i)); // sessions may be running
+                        checking = bank.at(i).checking.getBalance(); // checking balance
+                        savings = bank.at(i).savings.getBalance(); // savings balance
+                    }
+                    const Customer& c = bank.at(i); // owner and card text never change
+                    rows.text("=== Monthly Statement ").text(std::string_view(monthText, 7)).text(" ===\n"); // title
+                    rows.text(" Customer. ").text(c.checking.owner()).ch('\n'); // owner
+                    rows.text(" Checking. ").text(c.checking.card()).text("  Balance. $").money(checking).ch('\n'); // checking line
+                    rows.text(" Savings.  ").text(c.savings.card()).text("  Balance. $").money(savings).ch('\n'); // savings line
+                    rows.text("\n Transactions.\n"); // section header
+                    txs.clear(); // reuse
+                    auto a = byCard.find(c.checking.id().bits()); // checking activity
+                    if (a != byCard.end()) txs.insert(txs.end(), a->second.begin(), a->second.end()); // add it
+                    auto b = byCard.find(c.savings.id().bits()); // savings activity
+                    if (b != byCard.end()) txs.insert(txs.end(), b->second.begin(), b->second.end()); // add it
+                    if (a != byCard.end() && b != byCard.end()) { std::sort(txs.begin(), txs.end()); txs.erase(std::unique(txs.begin(), txs.end()), txs.end()); } // log order, no duplicates
+                    for (uint32_t t : txs) { // each transaction
+                        const Transaction& tx = monthTx[t]; // entry
+                        rows.text("  [").text(tx.timestamp).text("] ").text(kTxLabels[static_cast<int>(tx.type)]).money(tx.amount); // kind and amount
+                        if (tx.type == TxType::Transfer) rows.text(" from ").card(tx.fromCard).text(" to ").card(tx.toCard); // both cards
+                        else rows.text(" on ").card(tx.fromCard); // one card
+                        rows.text("  Balance after. $").money(tx.balanceAfter).ch('\n'); // running balance
+                    } // end for
+                    if (txs.empty()) rows.text("  None.\n"); // empty section
+                    rows.text(history); // shared purchases and paychecks
+                    auto t1 = std::chrono::steady_clock::now(); // render end
+                    myRender += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()); // render time
+                    myBytes += text.size(); // output size
+                    if (opts.dir.empty()) continue; // render only
+                    path.assign(opts.dir); // directory
+                    path += "/statement-"; // file prefix
+                    char num[24]; // zero padded index
+                    std::snprintf(num, sizeof(num), "%07zu", i); // sorts in customer order
+                    path += num; path += ".txt"; // file name
+                    std::FILE* f = std::fopen(path.c_str(), "wb"); // create the file
+                    if (!f) { ++myFailed; continue; } // cannot create
+                    std::setvbuf(f, nullptr, _IONBF, 0); // the statement is already one block, skip the stdio copy
+                    if (std::fwrite(text.data(), 1, text.size(), f) != text.size()) ++myFailed; // one write per statement
+                    if (std::fclose(f) != 0) ++myFailed; // close
+                    myWrite += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t1).count()); // file time
+                } // end for
+            } // end while
+            failed += myFailed; bytes += myBytes; renderNs += myRender; writeNs += myWrite; // publish totals
+        }; // end worker
+        std::vector<std::thread> pool; // worker threads
+        for (int t = 1; t < threads; ++t) pool.emplace_back(worker); // start helpers
+        worker(); // the caller works too
+        for (auto& t : pool) t.join(); // wait for every chunk
+
+        stats.customers = bank.size(); // every customer gets a statement
+        stats.failed = failed.load(); // write failures
+        stats.bytes = bytes.load(); // output size
+        stats.renderSeconds = static_cast<double>(renderNs.load()) / 1e9; // render time
+        stats.writeSeconds = static_cast<double>(writeNs.load()) / 1e9; // file time
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // wall time
+        return stats; // return totals
+    } // end WriteStatements
+
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once // prevent multiple inclusion of this header file
+#include "Calendar.h" // include packed dates for the statement month
+#include <string> // include string for the output directory
+#include <cstdint> // include fixed width integer types
+
+namespace atmapp { // begin atmapp namespace
+
+    class Bank; // forward declaration of Bank class
+    class TransactionLog; // forward declaration of TransactionLog class
+    class FinanceLog; // forward declaration of FinanceLog class
+
+    struct StatementOptions { // settings for one statement run
+        std::string dir; // output directory, created when missing, empty renders without writing files
+        int threads = 0; // workers, zero uses every hardware thread
+        PackedDate month = 0; // any day in the statement month, zero for the current month
+    }; // end of StatementOptions struct
+
+    struct StatementStats { // totals for one statement run
+        uint64_t customers; // statements rendered
+        uint64_t failed; // files that could not be written
+        uint64_t bytes; // statement text produced
+        double seconds; // wall time for the whole run
+        double renderSeconds; // time workers spent building text, summed over workers
+        double writeSeconds; // time workers spent in file calls, summed over workers
+    }; // end of StatementStats struct
+
+    StatementStats WriteStatements(const StatementOptions& opts, Bank& bank, const TransactionLog* log, const FinanceLog* fin); // render one file per customer across a worker pool
+
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "Timeline.h" // include header for history sorting and the timeline merge
+
+namespace atmapp { // begin atmapp namespace
+
+    void SortHistory(std::vector<TimedRow>& rows, std::vector<TimedRow>& scratch) { // oldest first
+        if (scratch.size() < rows.size()) scratch.resize(rows.size()); // grow once, reused by later customers
+        RadixSortByKey(rows.data(), scratch.data(), rows.size(), [](const TimedRow& r) { return r.time; }); // packed time is the whole key
+    } // end SortHistory
+
+    TimelineMerge::TimelineMerge(std::vector<HistorySpan> histories) : m_runs(std::move(histories)) { // build the tree
+        while (m_leaves < m_runs.size()) m_leaves <<= 1; // round up to a full tree
+        std::vector<Node> winners(m_leaves * 2); // match winners while building, bottom level is the leaves
+        for (std::size_t i = 0; i < m_leaves; ++i) { // each leaf plays for itself
+            bool live = i < m_runs.size() && m_runs[i].begin != m_runs[i].end; // padding and empty histories never win
+            winners[m_leaves + i] = Node{ live ? m_runs[i].begin->time : kDrained, static_cast<uint32_t>(i) }; // first row per customer
+        } // end for
+        m_tree.assign(m_leaves, Node{ kDrained, 0 }); // internal nodes one to m_leaves - 1, winner at zero
+        for (std::size_t node = m_leaves - 1; node > 0; --node) { // play every match bottom up
+            const Node& a = winners[node * 2]; // left side
+            const Node& b = winners[node * 2 + 1]; // right side
+            bool aWins = beats(a, b); // match result
+            winners[node] = aWins ? a : b; // goes up
+            m_tree[node] = aWins ? b : a; // stays here
+        } // end for
+        m_tree[0] = winners[1]; // champion, leaf zero when there is only one
+    } // end constructor
+
+    bool TimelineMerge::next(TimelineEntry& out) { // pop the champion and replay its path
+        Node w = m_tree[0]; // earliest customer
+        if (w.time == kDrained) return false; // every history is empty
+        HistorySpan& run = m_runs[w.leaf]; // its history
+        out.time = w.time; // result
+        out.customer = w.leaf; // source
+        out.row = run.begin->row; // row in that history
+        ++run.begin; // consume
+        w.time = run.begin != run.end ? run.begin->time : kDrained; // its next time
+        for (std::size_t node = (m_leaves + w.leaf) >> 1; node > 0; node >>= 1) { // path to the root
+            Node& stored = m_tree[node]; // loser kept at this level
+            if (beats(stored, w)) std::swap(stored, w); // the stored loser wins now, the old candidate stays behind
+        } // end for
+        m_tree[0] = w; // new champion
+        return true; // one row produced
+    } // end next
+
+}
@@ -0,0 +1,93 @@
+#pragma once // prevent multiple inclusion of this header file
+#include "Calendar.h" // include packed timestamps
+#include <cstdint> // include fixed width integer types
+#include <cstddef> // include size_t
+#include <utility> // include move for the scatter passes
+#include <vector> // include vector for histories and the tree
+
+namespace atmapp { // begin atmapp namespace
+
+    const std::size_t kRadixCutoff = 64; // below this many rows insertion sort beats clearing the digit counters
+
+    // Stable ascending sort on a 64-bit key, least significant byte first. One pass counts every byte position,
+    // then only the positions where the keys actually differ are scattered, so packed timestamps from a single
+    // quarter cost three or four passes rather than eight. scratch must hold n rows; the result ends up in rows.
+    template <typename T, typename KeyOf> void RadixSortByKey(T* rows, T* scratch, std::size_t n, KeyOf keyOf) {
+        if (n < kRadixCutoff) { // short histories
+            for (std::size_t i = 1; i < n; ++i) { // insertion sort, stable because equal keys never pass each other
+                uint64_t k = keyOf(rows[i]); // key being placed
+                if (keyOf(rows[i - 1]) <= k) continue; // already in place
+                T moving = std::move(rows[i]); // lift it out
+                std::size_t j = i; // hole position
+                for (; j > 0 && keyOf(rows[j - 1]) > k; --j) rows[j] = std::move(rows[j - 1]); // shift larger keys up
+                rows[j] = std::move(moving); // drop it in
+            } // end for
+            return; // sorted
+        } // end if
+        std::size_t counts[8][256] = {}; // digit histogram per byte position
+        for (std::size_t i = 0; i < n; ++i) { uint64_t k = keyOf(rows[i]); for (int b = 0; b < 8; ++b) ++counts[b][(k >> (b * 8)) & 0xFF]; } // one counting pass for all positions
+        T* src = rows; // current order
+        T* dst = scratch; // next order
+        for (int b = 0; b < 8; ++b) { // each byte, low to high
+            std::size_t* c = counts[b]; // this position's counts
+            if (c[(keyOf(src[0]) >> (b * 8)) & 0xFF] == n) continue; // every key shares this byte, the pass would not move anything
+            std::size_t offset = 0; // running prefix sum
+            for (int d = 0; d < 256; ++d) { std::size_t count = c[d]; c[d] = offset; offset += count; } // first output slot per digit
+            for (std::size_t i = 0; i < n; ++i) dst[c[(keyOf(src[i]) >> (b * 8)) & 0xFF]++] = std::move(src[i]); // scatter in input order, which keeps the sort stable
+            std::swap(src, dst); // scattered rows are the new input
+        } // end for
+        if (src != rows) for (std::size_t i = 0; i < n; ++i) rows[i] = std::move(src[i]); // odd pass count, copy back
+    } // end RadixSortByKey
+
+    struct TimedRow { // one entry of a customer history
+        PackedTime time; // when it happened
+        uint32_t row; // index into the customer's own storage
+    }; // end of TimedRow struct
+
+    void SortHistory(std::vector<TimedRow>& rows, std::vector<TimedRow>& scratch); // oldest first, ties keep their order, scratch is grown as needed and can be reused across customers
+
+    struct HistorySpan { // one sorted customer history, not owned
+        const TimedRow* begin; // oldest row
+        const TimedRow* end; // one past the newest row
+    }; // end of HistorySpan struct
+
+    struct TimelineEntry { // one row of the bank wide timeline
+        PackedTime time; // when it happened
+        uint32_t customer; // index of the history it came from
+        uint32_t row; // TimedRow::row of that history
+    }; // end of TimelineEntry struct
+
+    // Bank wide chronological stream over many sorted customer histories, produced one row at a time so the
+    // merged timeline is never held in memory. A loser tree keeps the losing customer of every match in its
+    // internal node, next to that customer's head time; replacing the winner replays only its path to the root,
+    // one comparison per level against data already in the node, where a binary heap compares both children on
+    // every level of a sift down.
+    // Rows with the same time come out in customer order.
+
+    class TimelineMerge { // k way merge of customer histories
+    public: // public interface
+        explicit TimelineMerge(std::vector<HistorySpan> histories); // each span sorted oldest first, spans must outlive the merge
+        bool next(TimelineEntry& out); // earliest remaining row, false when every history is drained
+        template <typename Fn> uint64_t forEach(Fn&& fn) { // call fn(const TimelineEntry&) until it returns false or the stream ends, return rows visited
+            TimelineEntry e{}; // current row
+            uint64_t visited = 0; // rows handed out
+            while (next(e)) { ++visited; if (!fn(e)) break; } // stream
+            return visited; // count
+        } // end forEach
+        std::size_t customers() const { return m_runs.size(); } // histories being merged
+        std::size_t memoryBytes() const { return m_runs.capacity() * sizeof(HistorySpan) + m_tree.capacity() * sizeof(Node); } // merge state, independent of the row count
+
+    private: // internal helpers and data
+        struct Node { // a customer and the time of its next row
+            PackedTime time; // head time, kDrained once the history is empty
+            uint32_t leaf; // customer index
+        }; // end of Node struct
+        static bool beats(const Node& a, const Node& b) { return a.time < b.time || (a.time == b.time && a.leaf < b.leaf); } // earlier time, then lower customer
+        static constexpr PackedTime kDrained = ~static_cast<PackedTime>(0); // head time of an empty history, later than any real time
+
+        std::vector<HistorySpan> m_runs; // remaining rows per customer
+        std::vector<Node> m_tree; // loser per internal node, the overall winner in slot zero
+        std::size_t m_leaves = 1; // leaf count, a power of two
+    }; // end of TimelineMerge class
+
+}
@@ -1,44 +1,236 @@
 #include "Transaction.h" // include header for transaction structures and class
+#include "Format.h" // include row formatter
 #include <iostream> // include input and output stream library
+#include <algorithm> // include min and max
 
 namespace atmapp { // begin atmapp namespace
 
-    static const char* typeName(TxType t) { // helper function to return transaction type as string
-        switch (t) { // determine which transaction type
-        case TxType::Deposit: return "Deposit"; // label for deposit
-        case TxType::Withdraw: return "Withdraw"; // label for withdrawal
-        case TxType::Transfer: return "Transfer"; // label for transfer
-        } // end switch
-        return "?"; // fallback if type unknown
-    } // end typeName
-
-    void TransactionLog::logDeposit(const std::string& card, double amount, double balanceAfter, const std::string& ts) { // record deposit transaction
-        entries.push_back(Transaction{ TxType::Deposit, card, "", amount, balanceAfter, ts }); // add new deposit entry to list
+    static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) { // days since 1970-01-01 in the proleptic Gregorian calendar
+        y -= m <= 2; // years start in March
+        int64_t era = (y >= 0 ? y : y - 399) / 400; // 400 year era
+        unsigned yoe = static_cast<unsigned>(y - era * 400); // year of era
+        unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1; // day of year
+        unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy; // day of era
+        return era * 146097 + static_cast<int64_t>(doe) - 719468; // shift the epoch
+    } // end daysFromCivil
+
+    static void civilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d) { // inverse of daysFromCivil
+        z += 719468; // shift the epoch
+        int64_t era = (z >= 0 ? z : z - 146096) / 146097; // 400 year era
+        unsigned doe = static_cast<unsigned>(z - era * 146097); // day of era
+        unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // year of era
+        unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100); // day of year
+        unsigned mp = (5 * doy + 2) / 153; // month from March
+        d = doy - (153 * mp + 2) / 5 + 1; // day of month
+        m = mp < 10 ? mp + 3 : mp - 9; // calendar month
+        y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2); // calendar year
+    } // end civilFromDays
+
+    static void formatStamp(int64_t t, std::pmr::string& out) { // seconds to YYYY-MM-DD HH:MM:SS
+        int64_t days = (t >= 0 ? t : t - 86399) / 86400, secs = t - days * 86400; // split day and time of day
+        int64_t y; unsigned m, d; // calendar fields
+        civilFromDays(days, y, m, d); // day to date
+        if (y < 0 || y > 9999) { out.clear(); return; } // parseStamp never accepts these
+        unsigned hh = static_cast<unsigned>(secs / 3600), mm = static_cast<unsigned>(secs / 60 % 60), ss = static_cast<unsigned>(secs % 60); // time of day
+        unsigned yy = static_cast<unsigned>(y); // four digit year
+        char buf[19] = { static_cast<char>('0' + yy / 1000), static_cast<char>('0' + yy / 100 % 10), static_cast<char>('0' + yy / 10 % 10), static_cast<char>('0' + yy % 10), '-', // year
+            static_cast<char>('0' + m / 10), static_cast<char>('0' + m % 10), '-', static_cast<char>('0' + d / 10), static_cast<char>('0' + d % 10), ' ', // month and day
+            static_cast<char>('0' + hh / 10), static_cast<char>('0' + hh % 10), ':', static_cast<char>('0' + mm / 10), static_cast<char>('0' + mm % 10), ':', // hour and minute
+            static_cast<char>('0' + ss / 10), static_cast<char>('0' + ss % 10) }; // second
+        out.assign(buf, sizeof(buf)); // reuse the string, no printf on the decode path
+    } // end formatStamp
+
+    static bool parseStamp(std::string_view text, int64_t& t) { // YYYY-MM-DD HH:MM:SS to seconds, false for anything that would not format back the same
+        if (text.size() != 19 || text[4] != '-' || text[7] != '-' || text[10] != ' ' || text[13] != ':' || text[16] != ':') return false; // shape
+        int v[6]; // year, month, day, hour, minute, second
+        static const int kStart[6] = { 0, 5, 8, 11, 14, 17 }, kLen[6] = { 4, 2, 2, 2, 2, 2 }; // field positions
+        for (int f = 0; f < 6; ++f) { // each field
+            v[f] = 0; // accumulate digits
+            for (int i = 0; i < kLen[f]; ++i) { char c = text[kStart[f] + i]; if (c < '0' || c > '9') return false; v[f] = v[f] * 10 + (c - '0'); } // digits only
+        } // end for
+        if (v[1] < 1 || v[1] > 12 || v[2] < 1 || v[2] > 31 || v[3] > 23 || v[4] > 59 || v[5] > 59) return false; // out of range fields
+        int64_t days = daysFromCivil(v[0], static_cast<unsigned>(v[1]), static_cast<unsigned>(v[2])); // day number
+        int64_t y; unsigned m, d; // the date that day number really is
+        civilFromDays(days, y, m, d); // convert back
+        if (y != v[0] || m != static_cast<unsigned>(v[1]) || d != static_cast<unsigned>(v[2])) return false; // a day past the end of its month
+        t = days * 86400 + v[3] * 3600 + v[4] * 60 + v[5]; // seconds
+        return true; // formats back to the same text
+    } // end parseStamp
+
+    static void putVarint(std::vector<uint8_t>& out, uint64_t v) { // seven bits per byte, high bit continues
+        while (v >= 0x80) { out.push_back(static_cast<uint8_t>(v | 0x80)); v >>= 7; } // low groups
+        out.push_back(static_cast<uint8_t>(v)); // last group
+    } // end putVarint
+
+    static uint64_t getVarint(const uint8_t*& p) { // read one varint and advance
+        uint64_t v = 0; // value
+        for (unsigned shift = 0;; shift += 7) { uint8_t b = *p++; v |= static_cast<uint64_t>(b & 0x7F) << shift; if (!(b & 0x80)) return v; } // groups
+    } // end getVarint
+
+    static uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); } // small magnitudes to small codes
+    static int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); } // inverse
+
+    TransactionLog::TransactionLog(std::size_t hotRows, std::pmr::memory_resource* mem) // ring must hold a full segment
+        : m_hot(mem), m_hotRows(std::max(hotRows, kTxSegmentRows)), m_cold(mem), m_texts(mem), m_textIds(mem) { // every container on the caller's resource
+        m_texts.emplace_back(); // id zero
+        m_textIds.emplace(m_texts.back(), 0); // the empty string
+    } // end constructor
+
+    uint32_t TransactionLog::textId(std::string_view text) { // dictionary lookup
+        auto it = m_textIds.find(text); // known text, no key copy
+        if (it != m_textIds.end()) return it->second; // id
+        uint32_t id = static_cast<uint32_t>(m_texts.size()); // next id
+        m_texts.emplace_back(text); // new entry, a deque never moves the ones before it
+        AddString(m_textUsage, m_texts.back()); // its text, never changed afterwards
+        m_textIds.emplace(m_texts.back(), id); // key views the stored text
+        return id; // id
+    } // end textId
+
+    Transaction& TransactionLog::nextSlot(TxType type) { // claim the next ring slot
+        if (m_count == m_hotRows) sealOldest(); // make room by compressing the oldest rows
+        std::size_t pos = (m_head + m_count) % m_hotRows; // slot after the newest entry
+        if (pos == m_hot.size()) m_hot.emplace_back(); // the ring is still growing to its capacity
+        ++m_count; // one more entry
+        Transaction& tx = m_hot[pos]; // reused slot, strings keep their capacity
+        tx.type = type; // kind
+        return tx; // caller fills the rest
+    } // end nextSlot
+
+    void TransactionLog::logDeposit(CardId card, double amount, double balanceAfter, std::string_view ts) { // record deposit transaction
+        Transaction& tx = nextSlot(TxType::Deposit); // ring slot
+        tx.fromCard = card; tx.toCard = CardId(); tx.amount = amount; tx.balanceAfter = balanceAfter; tx.timestamp.assign(ts); // fill in place
     } // end logDeposit
 
-    void TransactionLog::logWithdraw(const std::string& card, double amount, double balanceAfter, const std::string& ts) { // record withdrawal transaction
-        entries.push_back(Transaction{ TxType::Withdraw, card, "", amount, balanceAfter, ts }); // add new withdrawal entry
+    void TransactionLog::logWithdraw(CardId card, double amount, double balanceAfter, std::string_view ts) { // record withdrawal transaction
+        Transaction& tx = nextSlot(TxType::Withdraw); // ring slot
+        tx.fromCard = card; tx.toCard = CardId(); tx.amount = amount; tx.balanceAfter = balanceAfter; tx.timestamp.assign(ts); // fill in place
     } // end logWithdraw
 
-    void TransactionLog::logTransfer(const std::string& fromCard, const std::string& toCard, double amount, double fromBalanceAfter, const std::string& ts) { // record transfer transaction
-        entries.push_back(Transaction{ TxType::Transfer, fromCard, toCard, amount, fromBalanceAfter, ts }); // add new transfer entry
+    void TransactionLog::logTransfer(CardId fromCard, CardId toCard, double amount, double fromBalanceAfter, std::string_view ts) { // record transfer transaction
+        Transaction& tx = nextSlot(TxType::Transfer); // ring slot
+        tx.fromCard = fromCard; tx.toCard = toCard; tx.amount = amount; tx.balanceAfter = fromBalanceAfter; tx.timestamp.assign(ts); // fill in place
     } // end logTransfer
 
+    void TransactionLog::append(const Transaction& tx) { // record a prebuilt entry
+        Transaction& slot = nextSlot(tx.type); // ring slot
+        slot.fromCard = tx.fromCard; slot.toCard = tx.toCard; slot.amount = tx.amount; slot.balanceAfter = tx.balanceAfter; slot.timestamp.assign(tx.timestamp); // fill in place
+    } // end append
+
+    void TransactionLog::sealOldest() { // move the oldest ring rows into a cold segment
+        std::size_t k = std::min(kTxSegmentRows, m_count); // rows to seal
+        std::vector<int64_t> times(k); // parsed timestamps
+        bool text = false; // whether any stamp needs the text fallback
+        for (std::size_t i = 0; i < k && !text; ++i) text = !parseStamp(m_hot[(m_head + i) % m_hotRows].timestamp, times[i]); // parse every stamp
+        TxSegment seg(m_cold.get_allocator()); // new segment, columns on the log's resource
+        seg.rows = static_cast<uint32_t>(k); // row count
+        seg.textStamps = text; // time column mode
+        seg.firstTime = text ? 0 : times[0]; // delta base
+        seg.lastTime = text ? 0 : times[k - 1]; // newest time
+        std::vector<uint8_t> cols[6]; // columns built separately, then joined
+        int64_t prev = seg.firstTime; // previous time
+        for (std::size_t i = 0; i < k; ++i) { // each row, oldest first
+            const Transaction& tx = m_hot[(m_head + i) % m_hotRows]; // ring entry
+            cols[0].push_back(static_cast<uint8_t>(tx.type)); // type
+            putVarint(cols[1], tx.fromCard.bits()); // from card, four digit cards fit in three bytes
+            putVarint(cols[2], tx.toCard.bits()); // to card, zero for none
+            putVarint(cols[3], zigzag(ToCents(tx.amount))); // amount, kept to the cent as it is printed
+            putVarint(cols[4], zigzag(ToCents(tx.balanceAfter))); // balance after
+            if (text) putVarint(cols[5], textId(tx.timestamp)); // odd stamp text
+            else { putVarint(cols[5], zigzag(times[i] - prev)); prev = times[i]; } // seconds since the previous row
+        } // end for
+        std::size_t total = 0; // joined size
+        for (const auto& c : cols) total += c.size(); // sum
+        seg.bytes.reserve(total); // exact size
+        for (int c = 0; c < 6; ++c) { seg.columns[c] = static_cast<uint32_t>(seg.bytes.size()); seg.bytes.insert(seg.bytes.end(), cols[c].begin(), cols[c].end()); } // join
+        m_coldUsage.encodedBytes += seg.bytes.capacity(); // columns, never changed afterwards
+        m_coldUsage.allocations += seg.bytes.capacity() ? 1 : 0; // one block per segment
+        m_cold.push_back(std::move(seg)); // publish
+        m_coldRows += k; // count rows
+        m_head = (m_head + k) % m_hotRows; // drop them from the ring
+        m_count -= k; // ring space freed
+    } // end sealOldest
+
+    void TransactionLog::decodeSegment(const TxSegment& seg, std::vector<Transaction>& out) const { // expand one segment
+        if (out.size() < seg.rows) out.resize(seg.rows); // scratch rows, strings reused across segments
+        const uint8_t* p[6]; // column cursors
+        for (int c = 0; c < 6; ++c) p[c] = seg.bytes.data() + seg.columns[c]; // column starts
+        int64_t t = seg.firstTime; // running time
+        for (uint32_t i = 0; i < seg.rows; ++i) { // each row
+            Transaction& tx = out[i]; // scratch entry
+            tx.type = static_cast<TxType>(*p[0]++); // type
+            tx.fromCard = CardId::FromBits(getVarint(p[1])); // from card
+            tx.toCard = CardId::FromBits(getVarint(p[2])); // to card, zero is empty
+            tx.amount = static_cast<double>(unzigzag(getVarint(p[3]))) / 100.0; // amount
+            tx.balanceAfter = static_cast<double>(unzigzag(getVarint(p[4]))) / 100.0; // balance after
+            if (seg.textStamps) tx.timestamp.assign(m_texts[getVarint(p[5])]); // stored text
+            else { t += unzigzag(getVarint(p[5])); formatStamp(t, tx.timestamp); } // rebuilt text
+        } // end for
+    } // end decodeSegment
+
+    void TransactionLog::visit(bool (*fn)(const Transaction&, void*), void* ctx) const { // oldest first across both tiers
+        std::vector<Transaction> scratch; // decoded cold rows
+        for (const TxSegment& seg : m_cold) { // cold tier
+            decodeSegment(seg, scratch); // expand
+            for (uint32_t i = 0; i < seg.rows; ++i) if (!fn(scratch[i], ctx)) return; // caller is done
+        } // end for
+        for (std::size_t i = 0; i < m_count; ++i) if (!fn(m_hot[(m_head + i) % m_hotRows], ctx)) return; // hot tier
+    } // end visit
+
+    std::size_t TransactionLog::memoryBytes() const { // heap footprint of both tiers
+        return static_cast<std::size_t>(memoryUsage().bytes()); // sum of the parts
+    } // end memoryBytes
+
+    MemoryUsage TransactionLog::memoryUsage() const { // footprint of both tiers
+        MemoryUsage u = m_coldUsage; // segment columns
+        u += m_textUsage; // dictionary text
+        u.items = size(); // entries in both tiers
+        AddVector(u, m_hot); // ring slots
+        AddVector(u, m_cold); // segment headers
+        u.entryBytes += m_texts.size() * sizeof(std::pmr::string); // dictionary slots
+        for (const auto& tx : m_hot) AddString(u, tx.timestamp); // ring strings, bounded by the ring size
+        u.encodedBytes += m_textIds.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*)); // lookup table, approximate
+        return u; // footprint
+    } // end memoryUsage
+
+    struct TxLayout { // fixed text around the variable fields of one row kind
+        std::string_view lead; // label before the amount
+        std::string_view from; // text before the originating card
+        std::string_view to; // text before the destination card, empty when there is none
+    }; // end of TxLayout struct
+
+    static const TxLayout kTxLayouts[] = { // indexed by TxType
+        { "Deposit $", " on ", "" }, // deposit row
+        { "Withdraw $", " on ", "" }, // withdrawal row
+        { "Transfer $", " from ", " to " }, // transfer row
+    };
+
+    static void printRow(RowBuffer& rows, const Transaction& tx) { // one history row
+        const TxLayout& f = kTxLayouts[static_cast<int>(tx.type)]; // fixed text for this kind
+        rows.text(" [").text(tx.timestamp).text("] ").text(f.lead).money(tx.amount).text(f.from).card(tx.fromCard); // timestamp, amount and card
+        if (!f.to.empty()) rows.text(f.to).card(tx.toCard); // destination card for transfers
+        rows.text("  Balance after. $").money(tx.balanceAfter).ch('\n'); // print balance after transaction
+        rows.endRow(); // write once the buffer is large
+    } // end printRow
+
     void TransactionLog::print(std::ostream& out) const { // print all recorded transactions
-        if (entries.empty()) { // check if there are any records
+        if (empty()) { // check if there are any records
             out << "No transactions recorded.\n"; // print message if none
             return; // exit function
         } // end if
-        out << "\n=== Transaction History ===\n"; // print header
-        for (const auto& tx : entries) { // loop through transaction entries
-            out << " [" << tx.timestamp << "] "; // print timestamp
-            switch (tx.type) { // handle based on transaction type
-            case TxType::Deposit:  out << "Deposit $" << tx.amount << " on " << tx.fromCard; break; // print deposit details
-            case TxType::Withdraw: out << "Withdraw $" << tx.amount << " on " << tx.fromCard; break; // print withdrawal details
-            case TxType::Transfer: out << "Transfer $" << tx.amount << " from " << tx.fromCard << " to " << tx.toCard; break; // print transfer details
-            } // end switch
-            out << "  Balance after. $" << tx.balanceAfter << "\n"; // print balance after transaction
-        } // end for
+        RowBuffer rows(out); // rows are built in one buffer and written in large blocks
+        rows.text("\n=== Transaction History ===\n"); // print header
+        forEach([&](const Transaction& tx) { printRow(rows, tx); return true; }); // cold segments, then the ring
     } // end print
 
+    void TransactionLog::printRecent(std::ostream& out, std::size_t n) const { // newest entries straight from the ring
+        if (empty()) { // check if there are any records
+            out << "No transactions recorded.\n"; // print message if none
+            return; // exit function
+        } // end if
+        RowBuffer rows(out); // rows are built in one buffer and written in large blocks
+        rows.text("\n=== Recent Transactions ===\n"); // print header
+        n = std::min(n, m_count); // the ring holds the newest m_count entries
+        for (std::size_t i = m_count - n; i < m_count; ++i) printRow(rows, m_hot[(m_head + i) % m_hotRows]); // oldest of the n first
+    } // end printRecent
+
 }
\ No newline at end of file
@@ -1,31 +1,108 @@
 #pragma once // prevent multiple inclusion of this header file
 #include <string> // include string type
 #include <vector> // include vector container
+#include <string_view> // include text views for the dictionary
+#include <deque> // include stable dictionary storage
+#include <unordered_map> // include card text to id map
+#include <memory_resource> // include pmr containers and resources
+#include <algorithm> // include copy for segment columns
+#include <cstdint> // include fixed width integer types
+#include <cstddef> // include size_t
+#include <type_traits> // include remove_reference for the entry visitor
 #include <iosfwd> // forward declare iostream types for faster compilation
+#include "CardId.h" // include compact card identifiers
+#include "MemoryUsage.h" // include footprint reports
 
 namespace atmapp { // begin atmapp namespace
 
     enum class TxType { Deposit, Withdraw, Transfer }; // define transaction types for clarity
 
     struct Transaction { // define structure to store transaction data
-        TxType type; // type of transaction (deposit, withdraw, transfer)
-        std::string fromCard; // originating card number
-        std::string toCard; // destination card for transfers
-        double amount; // transaction amount
-        double balanceAfter; // account balance after transaction
-        std::string timestamp; // time of transaction
+        using allocator_type = std::pmr::polymorphic_allocator<char>; // strings come from the resource of the container holding the entry
+        TxType type = TxType::Deposit; // type of transaction (deposit, withdraw, transfer)
+        CardId fromCard; // originating card
+        CardId toCard; // destination card for transfers, empty otherwise
+        double amount = 0.0; // transaction amount
+        double balanceAfter = 0.0; // account balance after transaction
+        std::pmr::string timestamp; // time of transaction
+
+        Transaction() = default; // empty deposit on the default resource
+        explicit Transaction(const allocator_type& alloc) : timestamp(alloc) {} // empty deposit on a given resource
+        Transaction(TxType t, CardId from, CardId to, double a, double balance, std::string_view ts, const allocator_type& alloc = {}) // filled entry
+            : type(t), fromCard(from), toCard(to), amount(a), balanceAfter(balance), timestamp(ts, alloc) {} // copy the stamp into the resource
+        Transaction(const Transaction&) = default; // copy on the default resource
+        Transaction(Transaction&&) = default; // move, keeping the source's resource
+        Transaction(const Transaction& o, const allocator_type& alloc) : type(o.type), fromCard(o.fromCard), toCard(o.toCard), amount(o.amount), balanceAfter(o.balanceAfter), timestamp(o.timestamp, alloc) {} // copy into a container's resource
+        Transaction(Transaction&& o, const allocator_type& alloc) : type(o.type), fromCard(o.fromCard), toCard(o.toCard), amount(o.amount), balanceAfter(o.balanceAfter), timestamp(std::move(o.timestamp), alloc) {} // move, copying only across resources
+        Transaction& operator=(const Transaction&) = default; // assign, keeping this entry's resource
+        Transaction& operator=(Transaction&&) = default; // assign, keeping this entry's resource
     }; // end struct Transaction
 
+    const std::size_t kTxHotRows = 4096; // recent transactions kept as full structs in the ring
+    const std::size_t kTxSegmentRows = 1024; // oldest ring rows sealed into one cold segment at a time
+
+    // Cold segment layout, one byte column after another, offsets in columns[]:
+    //   type                                one byte per row
+    //   from, to                            varint CardId bits, zero for no card
+    //   amount, balance                     zigzag varint cents
+    //   time                                zigzag varint seconds since the previous row, the first row is firstTime
+    // Timestamps that are not YYYY-MM-DD HH:MM:SS make the whole segment store them as varint text ids instead.
+
+    struct TxSegment { // immutable compressed run of older transactions
+        using allocator_type = std::pmr::polymorphic_allocator<uint8_t>; // columns come from the log's resource
+        uint32_t rows = 0; // transactions in the segment
+        bool textStamps = false; // time column holds text ids instead of second deltas
+        int64_t firstTime = 0; // seconds of the first row, zero for text stamps
+        int64_t lastTime = 0; // seconds of the last row, zero for text stamps
+        uint32_t columns[6] = {}; // byte offset of each column
+        std::pmr::vector<uint8_t> bytes; // the columns
+
+        TxSegment() = default; // empty segment on the default resource
+        explicit TxSegment(const allocator_type& alloc) : bytes(alloc) {} // empty segment on a given resource
+        TxSegment(const TxSegment&) = default; // copy on the default resource
+        TxSegment(TxSegment&&) = default; // move, keeping the source's resource
+        TxSegment(const TxSegment& o, const allocator_type& alloc) : rows(o.rows), textStamps(o.textStamps), firstTime(o.firstTime), lastTime(o.lastTime), bytes(o.bytes, alloc) { std::copy(o.columns, o.columns + 6, columns); } // copy into the log's resource
+        TxSegment(TxSegment&& o, const allocator_type& alloc) : rows(o.rows), textStamps(o.textStamps), firstTime(o.firstTime), lastTime(o.lastTime), bytes(std::move(o.bytes), alloc) { std::copy(o.columns, o.columns + 6, columns); } // move, copying only across resources
+        TxSegment& operator=(const TxSegment&) = default; // assign, keeping this segment's resource
+        TxSegment& operator=(TxSegment&&) = default; // assign, keeping this segment's resource
+    }; // end of TxSegment struct
+
     class TransactionLog { // define class to manage a list of transactions
     public: // public functions accessible to other files
-        void logDeposit(const std::string& card, double amount, double balanceAfter, const std::string& ts); // record a deposit
-        void logWithdraw(const std::string& card, double amount, double balanceAfter, const std::string& ts); // record a withdrawal
-        void logTransfer(const std::string& fromCard, const std::string& toCard, double amount, double fromBalanceAfter, const std::string& ts); // record a transfer
+        explicit TransactionLog(std::size_t hotRows = kTxHotRows, std::pmr::memory_resource* mem = std::pmr::get_default_resource()); // ring size, at least kTxSegmentRows, and the resource for the ring, segments and dictionary
+        void logDeposit(CardId card, double amount, double balanceAfter, std::string_view ts); // record a deposit
+        void logWithdraw(CardId card, double amount, double balanceAfter, std::string_view ts); // record a withdrawal
+        void logTransfer(CardId fromCard, CardId toCard, double amount, double fromBalanceAfter, std::string_view ts); // record a transfer
+        void append(const Transaction& tx); // record an entry built elsewhere, such as a merged shard entry
         void print(std::ostream& out) const; // print transaction history
-        bool empty() const { return entries.empty(); } // check if log is empty
+        void printRecent(std::ostream& out, std::size_t n) const; // print the newest n entries from the ring, n is capped at the ring size
+        template <typename Fn> void forEach(Fn&& fn) const { // visit every entry oldest first until fn returns false, cold entries are decoded into scratch
+            visit([](const Transaction& tx, void* ctx) { return static_cast<bool>((*static_cast<std::remove_reference_t<Fn>*>(ctx))(tx)); }, const_cast<void*>(static_cast<const void*>(&fn))); // type erased call
+        } // end forEach
+        std::size_t size() const { return m_coldRows + m_count; } // entries in both tiers
+        bool empty() const { return size() == 0; } // check if log is empty
+        std::size_t hotSize() const { return m_count; } // entries still in the ring
+        std::size_t segments() const { return m_cold.size(); } // sealed cold segments
+        std::size_t memoryBytes() const; // bytes held by the ring, the segments and the stamp dictionary, on whichever resource they use
+        MemoryUsage memoryUsage() const; // the same bytes split by part, walks only the ring, segment and dictionary totals are kept as they grow
+
+    private: // internal helpers and data
+        Transaction& nextSlot(TxType type); // ring slot for a new entry, sealing the oldest rows when the ring is full
+        void sealOldest(); // compress the oldest kTxSegmentRows ring entries into a segment
+        void decodeSegment(const TxSegment& seg, std::vector<Transaction>& out) const; // expand a segment, reusing the strings in out
+        void visit(bool (*fn)(const Transaction&, void*), void* ctx) const; // shared walk for forEach
+        uint32_t textId(std::string_view text); // dictionary id for an odd timestamp
 
-    private: // internal data
-        std::vector<Transaction> entries; // list of all recorded transactions
+        std::pmr::vector<Transaction> m_hot; // ring slots, grown up to m_hotRows then reused in place
+        std::size_t m_hotRows; // ring capacity
+        std::size_t m_head = 0; // slot of the oldest ring entry
+        std::size_t m_count = 0; // entries in the ring
+        std::pmr::vector<TxSegment> m_cold; // sealed segments, oldest first
+        std::size_t m_coldRows = 0; // entries in the segments
+        MemoryUsage m_coldUsage; // segment columns sealed so far
+        std::pmr::deque<std::pmr::string> m_texts; // dictionary, id zero is the empty string, entries never move
+        std::pmr::unordered_map<std::string_view, uint32_t> m_textIds; // text to id, keys view the dictionary entries
+        MemoryUsage m_textUsage; // dictionary text beyond the inline buffers
     }; // end class TransactionLog
 
-}
\ No newline at end of file
+}
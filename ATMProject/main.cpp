@@ -1,21 +1,34 @@
 #include "ATM.h" // include ATM declarations
 #include "Account.h" // include Account class
+#include "Bank.h" // include customer records
 #include "Transaction.h" // include transaction log types
+#include "ShardedLog.h" // include per thread transaction logging for server mode
 #include "Finance.h" // include finance log types
 #include "Credit.h" // include credit profile
 #include "DataGen.h" // include random data generator
+#include "Metrics.h" // include latency instrumentation
+#include "MemoryUsage.h" // include memory accounting
+#include "Batch.h" // include batch command protocol
+#include "Server.h" // include socket server for simulated terminals
+#include "Statement.h" // include monthly statement job
+#include "CsvImport.h" // include statement CSV importer
+#include "CreditProjection.h" // include credit score projection
 
 #include <iostream> // include stream io
+#include <fstream> // include file input for batch mode
+#include <chrono> // include clocks for batch timing
 #include <vector> // include vector container
+#include <memory> // include make_unique for the import batch
 #include <limits> // include numeric limits
+#include <string> // include string for flag matching
+#include <cstdlib> // include atoi for numeric flags
+#include <atomic> // include the reporter stop flag
+#include <condition_variable> // include the reporter sleep
+#include <mutex> // include the reporter sleep lock
+#include <thread> // include the periodic memory reporter
 
 using namespace atmapp; // use the atmapp namespace for brevity
 
-struct Customer { // define a simple customer record
-    Account checking; // checking account object
-    Account savings; // savings account object
-}; // end of Customer
-
 static int readIntBounded(std::istream& in, std::ostream& out, int lo, int hi) { // read a bounded integer
     int v{}; // hold the input value
     while (true) { // loop until a valid value is entered
@@ -26,34 +39,144 @@ static int readIntBounded(std::istream& in, std::ostream& out, int lo, int hi) {
     } // end while
 } // end readIntBounded
 
-int main() { // program entry point
-    std::vector<Customer> customers; // list of customers
-    customers.push_back(Customer{ Account("Josh",  "Card. **** **** **** 4242", 1234, 1250.00), // add Josh checking
-                                  Account("Josh",  "Savings. **** **** **** 8844", 1234, 3000.00) }); // add Josh savings
-    customers.push_back(Customer{ Account("Ava",   "Card. **** **** **** 1111", 1111, 800.00), // add Ava checking
-                                  Account("Ava",   "Savings. **** **** **** 9111", 1111, 1200.00) }); // add Ava savings
-    customers.push_back(Customer{ Account("Liam",  "Card. **** **** **** 2222", 2222, 920.00), // add Liam checking
-                                  Account("Liam",  "Savings. **** **** **** 9222", 2222, 400.00) }); // add Liam savings
-    customers.push_back(Customer{ Account("Mia",   "Card. **** **** **** 3333", 3333, 450.50), // add Mia checking
-                                  Account("Mia",   "Savings. **** **** **** 9333", 3333, 610.00) }); // add Mia savings
-    customers.push_back(Customer{ Account("Noah",  "Card. **** **** **** 4444", 4444, 77.77), // add Noah checking
-                                  Account("Noah",  "Savings. **** **** **** 9444", 4444, 88.88) }); // add Noah savings
-    customers.push_back(Customer{ Account("Emma",  "Card. **** **** **** 5555", 5555, 5100.12), // add Emma checking
-                                  Account("Emma",  "Savings. **** **** **** 9555", 5555, 2500.00) }); // add Emma savings
-    customers.push_back(Customer{ Account("Lucas", "Card. **** **** **** 6666", 6666, 25.00), // add Lucas checking
-                                  Account("Lucas", "Savings. **** **** **** 9666", 6666, 75.00) }); // add Lucas savings
-    customers.push_back(Customer{ Account("Sophia","Card. **** **** **** 7777", 7777, 190.00), // add Sophia checking
-                                  Account("Sophia","Savings. **** **** **** 9777", 7777, 310.00) }); // add Sophia savings
-    customers.push_back(Customer{ Account("Elena", "Card. **** **** **** 8888", 8888, 999.99), // add Elena checking
-                                  Account("Elena", "Savings. **** **** **** 9888", 8888, 150.00) }); // add Elena savings
+static int runBatchMode(const std::string& path, std::vector<Customer> customers, TransactionLog& log, FinanceLog& fin, bool memoryText, bool memoryJson) { // execute protocol commands from a file or stdin
+    Bank bank(std::move(customers)); // account store for the batch
+    std::ifstream file; // input file when a path is given
+    std::istream* in = &std::cin; // stdin when the path is a dash
+    if (path != "-") { // read from a file
+        file.open(path, std::ios::binary); // open the command file
+        if (!file) { std::cerr << "Error opening " << path << " for reading.\n"; return 1; } // missing file
+        in = &file; // use the file
+    } // end if
+    std::ios::sync_with_stdio(false); // large reads and writes, no need to interleave with stdio
+    auto start = std::chrono::steady_clock::now(); // start timing
+    uint64_t n = RunBatch(*in, std::cout, bank, &log, &fin); // run every command
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); // elapsed seconds
+    std::cerr << " Batch. " << n << " commands in " << secs << " s\n"; // summary on stderr keeps stdout machine readable
+    if (memoryText) PrintMemory(std::cerr, SnapshotMemory(bank.memoryUsage(), &log, &fin)); // footprint after the batch
+    if (memoryJson) PrintMemoryJson(std::cerr, SnapshotMemory(bank.memoryUsage(), &log, &fin)); // footprint as JSON
+    return 0; // signal success
+} // end runBatchMode
+
+static int runServeMode(const std::string& path, int threads, std::vector<Customer> customers, FinanceLog& fin, int memoryInterval) { // serve terminals until Ctrl C
+    Bank bank(std::move(customers)); // account store shared by every connection
+    ServerOptions opts; // server settings
+    opts.socketPath = path; // where terminals connect
+    ShardedTxLog log; // every event loop appends to its own shard
+    log.start(); // background merge into one ordered history
+    opts.log = &log; // log money commands
+    if (threads > 0) opts.threads = threads; // event loop count
+    ServerStats stats{ 0, 0 }; // totals
+    std::cerr << " Serving on " << path << " with " << opts.threads << " threads. Ctrl C stops.\n"; // status on stderr
+    std::mutex reportLock; // guards reportStop
+    std::condition_variable reportWake; // ends the reporter's sleep when the server stops
+    bool reportStop = false; // reporter should exit
+    std::thread reporter; // periodic memory report
+    if (memoryInterval > 0) reporter = std::thread([&] { // one JSON line per interval on stderr
+        std::unique_lock<std::mutex> lock(reportLock); // sleep lock
+        while (!reportWake.wait_for(lock, std::chrono::seconds(memoryInterval), [&] { return reportStop; })) PrintMemoryJson(std::cerr, SnapshotMemory(bank.memoryUsage(), log, &fin)); // report until stopped
+    }); // end reporter
+    bool served = RunServer(opts, bank, &fin, stats, std::cerr); // blocks until Ctrl C
+    if (reporter.joinable()) { { std::lock_guard<std::mutex> guard(reportLock); reportStop = true; } reportWake.notify_one(); reporter.join(); } // stop reporting
+    if (!served) return 1; // setup failed
+    log.stop(); // merge what is left
+    std::cerr << " Served " << stats.connections << " connections, " << stats.commands << " commands, " << log.merged() << " transactions logged\n"; // summary
+    return 0; // signal success
+} // end runServeMode
+
+static int runStatementMode(const std::string& dir, int threads, std::vector<Customer> customers, const TransactionLog& log, const FinanceLog& fin) { // write one statement file per customer
+    Bank bank(std::move(customers)); // account store to report on
+    StatementOptions opts; // job settings
+    opts.dir = dir; // output directory
+    opts.threads = threads; // workers, zero for every hardware thread
+    StatementStats stats = WriteStatements(opts, bank, &log, &fin); // run the job
+    std::cerr << " Statements. " << stats.customers << " written to " << dir << " in " << stats.seconds << " s"; // summary
+    if (stats.failed) std::cerr << ", " << stats.failed << " failed"; // write errors
+    std::cerr << "\n"; // end line
+    return stats.failed ? 1 : 0; // fail when any file was not written
+} // end runStatementMode
+
+static int runProjectionMode(int paths, int threads, const std::vector<Customer>& customers, const FinanceLog& fin) { // print a credit outlook per customer
+    ProjectionOptions opts; // projection settings
+    opts.paths = paths; // simulated futures per customer
+    opts.threads = threads; // workers, zero for every hardware thread
+    for (const Customer& c : customers) { // each customer
+        CreditProjection p = ProjectCredit(opts, c.checking.getBalance(), c.savings.getBalance(), fin); // simulate
+        std::cout << "\n " << c.checking.owner() << "  [" << c.checking.card() << "]"; // whose outlook
+        PrintProjection(std::cout, p); // table
+        std::cerr << " Projection. " << p.paths << " paths in " << p.seconds * 1000.0 << " ms\n"; // timing on stderr
+    } // end for
+    return 0; // signal success
+} // end runProjectionMode
+
+int main(int argc, char** argv) { // program entry point
+    bool metricsText = false; // print a metrics table when the session ends
+    bool metricsJson = false; // print metrics as JSON when the session ends
+    std::string batchPath; // command file for batch mode, empty for the interactive menu
+    std::string servePath; // Unix socket for server mode, empty for the interactive menu
+    int serveThreads = 0; // server event loops, zero for the default
+    std::string statementDir; // output directory for statements, empty for the interactive menu
+    std::string importPath; // statement CSV replacing the generated history, empty to keep it
+    std::string historyPath; // columnar history file, opened in place when present and written otherwise
+    bool compact = false; // keep the history bit packed in memory
+    int projectionPaths = 0; // simulated futures per customer for the credit outlook, zero for the interactive menu
+    bool memoryText = false; // print a memory table when the session or batch ends
+    bool memoryJson = false; // print the memory table as JSON
+    int memoryInterval = 0; // seconds between memory reports in server mode, zero for none
+    for (int i = 1; i < argc; ++i) { // scan flags
+        std::string arg = argv[i]; // current flag
+        if (arg == "--metrics") metricsText = true; // text table
+        else if (arg == "--metrics-json") metricsJson = true; // JSON object
+        else if (arg == "--memory") memoryText = true; // memory table
+        else if (arg == "--memory-json") memoryJson = true; // memory JSON object
+        else if (arg == "--memory-interval" && i + 1 < argc) memoryInterval = std::atoi(argv[++i]); // periodic memory JSON while serving
+        else if (arg == "--batch" && i + 1 < argc) batchPath = argv[++i]; // protocol commands from a file or - for stdin
+        else if (arg == "--serve" && i + 1 < argc) servePath = argv[++i]; // listen for terminals on a Unix socket
+        else if (arg == "--threads" && i + 1 < argc) serveThreads = std::atoi(argv[++i]); // server event loops, statement or projection workers
+        else if (arg == "--statements" && i + 1 < argc) statementDir = argv[++i]; // write monthly statements and exit
+        else if (arg == "--import" && i + 1 < argc) importPath = argv[++i]; // load real card history
+        else if (arg == "--history" && i + 1 < argc) historyPath = argv[++i]; // mapped history file
+        else if (arg == "--compact") compact = true; // compressed in memory history
+        else if (arg == "--projection" && i + 1 < argc) projectionPaths = std::atoi(argv[++i]); // credit outlook per customer and exit
+    } // end for
+    InstallMetricsSignal(); // SIGUSR1 dumps metrics on the next menu pass
+    InstallMemoryCounter(); // count pmr allocations before any log is built
+    std::vector<Customer> customers = DemoCustomers(); // list of customers
 
     TransactionLog log; // create a transaction log
     FinanceLog fin; // create a finance log
     CreditProfile credit; // create a credit profile
     DataGen gen; // create a data generator
 
-    auto seedEvents = gen.generateQuarterHistory(18, 2); // build sample events for three months
-    fin.set(std::move(seedEvents)); // load events into the finance log
+    fin.set(gen.generateQuarterBatch(18, 2)); // build sample events for three months in one arena and load them
+    if (!importPath.empty()) { // real statement history instead
+        auto imported = std::make_unique<FinBatch>(1 << 20); // parsed events, one arena for the whole statement
+        CsvImportStats stats{}; // import totals
+        std::string error; // failure reason
+        if (!ImportStatementCsv(importPath, imported->events(), stats, error)) { std::cerr << "Error importing " << importPath << ". " << error << "\n"; return 1; } // unusable file
+        std::cerr << " Imported " << stats.rows << " events from " << importPath << ", " << stats.skipped << " lines skipped\n"; // summary
+        fin.set(std::move(imported)); // replace the generated history
+    } // end if
+    if (!historyPath.empty()) { // columnar history file
+        std::string error; // failure reason
+        std::ifstream probe(historyPath, std::ios::binary); // whether a file is already there
+        if (probe && importPath.empty()) { // reuse it without parsing anything
+            if (!fin.open(historyPath, error)) { std::cerr << "Error opening " << historyPath << ". " << error << "\n"; return 1; } // unusable file
+            std::cerr << " Mapped " << fin.size() << " events from " << historyPath << "\n"; // summary
+        } else if (!fin.save(historyPath, error)) { // first run or a fresh import, keep it for next time
+            std::cerr << "Error saving " << historyPath << ". " << error << "\n"; return 1; // cannot write
+        } // end if
+    } // end if
+    if (compact) { // trade the FinEvent list for the packed form
+        std::size_t before = fin.memoryBytes(); // list footprint
+        fin.compress(); // re encode
+        std::cerr << " Packed " << fin.size() << " events, " << before / 1024 << " KiB to " << fin.memoryBytes() / 1024 << " KiB\n"; // summary
+    } // end if
+
+    if (projectionPaths > 0) return runProjectionMode(projectionPaths, serveThreads, customers, fin); // credit outlook for every customer
+    if (!statementDir.empty()) return runStatementMode(statementDir, serveThreads, std::move(customers), log, fin); // statement files for every customer
+    if (!servePath.empty()) return runServeMode(servePath, serveThreads, std::move(customers), fin, memoryInterval); // many terminals over sockets
+    if (!batchPath.empty()) return runBatchMode(batchPath, std::move(customers), log, fin, memoryText, memoryJson); // machine clients skip the menu
 
     ShowBanner(std::cout); // show the banner
     std::cout << "\nSelect a customer to insert their card.\n"; // prompt to choose a customer
@@ -68,5 +191,9 @@ int main() { // program entry point
     } // end if
 
     RunSession(std::cin, std::cout, customers[idx].checking, customers[idx].savings, &log, &fin, &credit); // start the interactive session
+    if (metricsText) PrintMetrics(std::cout, SnapshotMetrics()); // session end metrics table
+    if (metricsJson) PrintMetricsJson(std::cout, SnapshotMetrics()); // session end metrics JSON
+    if (memoryText) PrintMemory(std::cout, SnapshotMemory(CustomerMemory(customers), &log, &fin)); // session end memory table
+    if (memoryJson) PrintMemoryJson(std::cout, SnapshotMemory(CustomerMemory(customers), &log, &fin)); // session end memory JSON
     return 0; // signal success
 }
\ No newline at end of file
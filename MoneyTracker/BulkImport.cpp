@@ -0,0 +1,155 @@
+// This file implements the bulk import declared in BulkImport.h.
+
+#include "BulkImport.h"  // Includes the declaration of the bulk import.
+#include <charconv>      // Includes from_chars and to_chars for fast number conversion.
+#include <cstring>       // Includes memchr and memmove for working on the raw buffer.
+#include <istream>       // Includes the input stream class.
+#include <ostream>       // Includes the output stream class.
+#include <vector>        // Includes the vector container for the read buffer.
+
+using namespace std;     // Allows the use of standard library names without the std prefix.
+
+static const size_t kImportBlock = 1 << 20;   // Bytes read from the input and handed to the log at a time.
+static const long long kReportedLines = 10;   // Skipped lines shown before the rest are only counted.
+
+// This function appends text padded with spaces to a width, like setw does.
+static void AppendPadded(string& out, const char* text, size_t length, size_t width, bool alignLeft) {
+    size_t pad = length < width ? width - length : 0;   // Counts the spaces needed to reach the width.
+    if (!alignLeft) out.append(pad, ' ');    // Puts the spaces first for right alignment.
+    out.append(text, length);                // Adds the text itself.
+    if (alignLeft) out.append(pad, ' ');     // Puts the spaces after for left alignment.
+}
+
+// This function appends a number the way a stream prints it by default, six significant digits.
+static void AppendNumber(string& out, double value, size_t width) {
+    char digits[64];                         // Holds the converted number.
+    to_chars_result result = to_chars(digits, digits + sizeof(digits), value, chars_format::general, 6);   // Converts like the %g format.
+    AppendPadded(out, digits, static_cast<size_t>(result.ptr - digits), width, false);   // Right aligns the number.
+}
+
+void AppendRow(string& out, const char* type, const char* description, size_t descriptionLength, double amount, double balance) {
+    AppendPadded(out, type, strlen(type), 12, true);              // Adds the type column.
+    AppendPadded(out, description, descriptionLength, 20, true);  // Adds the description column.
+    AppendNumber(out, amount, 12);           // Adds the amount column.
+    AppendNumber(out, balance, 14);          // Adds the new balance column.
+    out += '\n';                             // Ends the row.
+}
+
+// This function moves the start and end of a piece of text past surrounding spaces.
+static void Trim(const char*& begin, const char*& end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;      // Skips leading spaces.
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;   // Skips trailing spaces and carriage returns.
+}
+
+// This function compares a piece of text with a lowercase word, ignoring letter case.
+static bool SameWord(const char* begin, const char* end, const char* word) {
+    size_t length = strlen(word);            // Measures the word.
+    if (static_cast<size_t>(end - begin) != length) return false;   // Different lengths never match.
+    for (size_t i = 0; i < length; ++i) {    // Compares letter by letter.
+        if ((begin[i] | 0x20) != word[i]) return false;   // Folds uppercase letters to lowercase.
+    }
+    return true;                             // Every letter matched.
+}
+
+ImportResult ImportRows(istream& in, LogWriter& log, double startingBalance, ostream& errors) {
+    ImportResult result;                     // Holds the counts and the running balance.
+    result.balance = startingBalance;        // Starts from the given balance.
+
+    vector<char> buffer(kImportBlock);       // Holds raw input, a block at a time.
+    size_t filled = 0;                       // Counts the bytes in the buffer.
+    bool ended = false;                      // Becomes true once the input has no more data.
+    long long lineNumber = 0;                // Counts input lines for error messages.
+    string out;                              // Collects formatted rows before they go to the log.
+    out.reserve(kImportBlock + 4096);        // Reserves room for a full block of rows.
+
+    // This lambda reads one line and either adds its row or reports why it was skipped.
+    auto handleLine = [&](const char* begin, const char* end) {
+        ++lineNumber;                        // Moves to the next line number.
+        const char* lineBegin = begin;       // Remembers the whole line for error messages.
+        Trim(begin, end);                    // Removes surrounding spaces.
+        if (begin == end) return;            // Ignores blank lines.
+
+        char separator = memchr(begin, '\t', end - begin) ? '\t' : ',';   // Uses tabs when the line has any, commas otherwise.
+        const char* typeEnd = static_cast<const char*>(memchr(begin, separator, end - begin));   // Finds the end of the type.
+        const char* amountBegin = end;       // Searches backwards for the start of the amount.
+        while (amountBegin > begin && amountBegin[-1] != separator) --amountBegin;   // Stops just after the last separator.
+
+        bool valid = typeEnd != nullptr && amountBegin - 1 > typeEnd;   // Needs two separators, one on each side of the description.
+        const char* typeBegin = begin;       // Marks the type field.
+        const char* descriptionBegin = valid ? typeEnd + 1 : end;   // Marks the description field.
+        const char* descriptionEnd = valid ? amountBegin - 1 : end;   // Ends the description at the last separator.
+        if (valid) {                         // Cleans up the fields of a well formed line.
+            Trim(typeBegin, typeEnd);        // Removes spaces around the type.
+            Trim(descriptionBegin, descriptionEnd);   // Removes spaces around the description.
+            if (descriptionEnd - descriptionBegin >= 2 && *descriptionBegin == '"' && descriptionEnd[-1] == '"') {   // Removes quotes around the description.
+                ++descriptionBegin;          // Skips the opening quote.
+                --descriptionEnd;            // Drops the closing quote.
+            }
+        }
+
+        bool income = valid && SameWord(typeBegin, typeEnd, "income");     // Checks for an income row.
+        bool expense = valid && SameWord(typeBegin, typeEnd, "expense");   // Checks for an expense row.
+        if (!income && !expense && valid && lineNumber == 1 && SameWord(typeBegin, typeEnd, "type")) return;   // Skips a column header line.
+
+        double amount = 0.0;                 // Holds the parsed amount.
+        bool parsed = false;                 // Becomes true when the whole amount field is a number.
+        if (income || expense) {             // Reads the amount only for a known type.
+            const char* amountEnd = end;     // Marks the end of the amount field.
+            Trim(amountBegin, amountEnd);    // Removes spaces around the amount.
+            if (amountBegin < amountEnd && *amountBegin == '$') ++amountBegin;   // Allows a dollar sign.
+            if (amountBegin < amountEnd && *amountBegin == '+') ++amountBegin;   // Allows an explicit plus sign.
+            from_chars_result number = from_chars(amountBegin, amountEnd, amount);   // Parses the amount without locale or allocation.
+            parsed = amountBegin < amountEnd && number.ec == errc() && number.ptr == amountEnd;   // Rejects trailing text.
+        }
+
+        if (!parsed) {                       // Reports a line that is not a row.
+            if (++result.skipped <= kReportedLines) {   // Shows only the first few.
+                errors << "Skipped line " << lineNumber << ": " << string(lineBegin, end) << '\n';   // Names the line.
+            }
+            return;                          // Leaves the balance unchanged.
+        }
+
+        result.balance += income ? amount : -amount;   // Adds income or subtracts an expense.
+        const char* type = income ? "Income" : "Expense";   // Writes the type the way the menu does.
+        if (descriptionBegin == descriptionEnd) AppendRow(out, type, type, strlen(type), amount, result.balance);   // Uses the type as a default description.
+        else AppendRow(out, type, descriptionBegin, static_cast<size_t>(descriptionEnd - descriptionBegin), amount, result.balance);   // Formats the row.
+        ++result.rows;                       // Counts the row.
+
+        if (out.size() >= kImportBlock) {    // Hands a full block to the log writer.
+            log.Write(out);                  // Queues the block as one large write.
+            out.clear();                     // Reuses the same memory for the next block.
+        }
+    };
+
+    while (true) {                           // Reads the input a block at a time.
+        if (!ended) {                        // Reads more input while there is some.
+            in.read(buffer.data() + filled, static_cast<streamsize>(buffer.size() - filled));   // Fills the free part of the buffer.
+            filled += static_cast<size_t>(in.gcount());   // Counts the bytes read.
+            if (!in) ended = true;           // Notes the end of the input.
+        }
+
+        const char* data = buffer.data();    // Points at the start of the buffer.
+        size_t start = 0;                    // Marks the start of the current line.
+        while (start < filled) {             // Handles each complete line in the buffer.
+            const char* newline = static_cast<const char*>(memchr(data + start, '\n', filled - start));   // Finds the end of the line.
+            if (!newline) break;             // Keeps a partial line for the next block.
+            handleLine(data + start, newline);   // Handles the line.
+            start = static_cast<size_t>(newline - data) + 1;   // Moves past the newline.
+        }
+
+        if (ended) {                         // Handles what remains at the end of the input.
+            if (start < filled) handleLine(data + start, data + filled);   // Handles a last line without a newline.
+            break;                           // Stops reading.
+        }
+
+        memmove(buffer.data(), data + start, filled - start);   // Moves the partial line to the front.
+        filled -= start;                     // Counts the bytes kept.
+        if (filled == buffer.size()) buffer.resize(buffer.size() * 2);   // Grows the buffer for a line longer than a block.
+    }
+
+    if (!out.empty()) log.Write(out);        // Queues the last rows.
+    if (result.skipped > kReportedLines) {   // Mentions the skipped lines that were not shown.
+        errors << "Skipped " << result.skipped - kReportedLines << " more lines.\n";   // Gives the remaining count.
+    }
+    return result;                           // Returns the counts and the final balance.
+}
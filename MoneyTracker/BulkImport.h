@@ -0,0 +1,28 @@
+// This header declares the bulk import of income and expense rows from a CSV or TSV file.
+
+#pragma once             // Ensures this header file is only included once during compilation.
+
+#include <iosfwd>        // Includes forward declarations of the stream classes.
+#include <string>        // Includes the string library for handling text.
+#include "LogWriter.h"   // Includes the background writer that receives the formatted rows.
+
+// Each input line holds a type, a description and an amount, separated by commas or tabs.
+// The type is Income or Expense in any letter case, an empty description takes the type as its name,
+// and the description may itself contain the separator because the amount is always the last field.
+// A first line whose type reads Type is taken as a column header and skipped.
+// The input is read in large blocks and split in place, amounts are parsed with from_chars,
+// and the rows are formatted into a large buffer that goes to the log writer in one piece at a time.
+// Rows look exactly like the rows the interactive menu writes.
+
+struct ImportResult {
+    long long rows = 0;      // Counts the rows added to the log.
+    long long skipped = 0;   // Counts the lines that could not be read as a row.
+    double balance = 0.0;    // Holds the balance after the last row.
+};
+
+// Reads every row from the input, updates the balance and queues the formatted rows for the log.
+// Lines that cannot be read are reported on the errors stream, up to a limit, and skipped.
+ImportResult ImportRows(std::istream& in, LogWriter& log, double startingBalance, std::ostream& errors);
+
+// Appends one row in the log layout to the text, the same layout the interactive menu uses.
+void AppendRow(std::string& out, const char* type, const char* description, size_t descriptionLength, double amount, double balance);
@@ -0,0 +1,81 @@
+// This file implements the backwards reader declared in LedgerTail.h.
+
+#include "LedgerTail.h"  // Includes the declaration of the ledger tail reader.
+#include <charconv>      // Includes from_chars for reading the balance.
+#include <cstring>       // Includes strncmp for matching line prefixes.
+#include <fstream>       // Includes the file stream library for reading the log.
+#include <vector>        // Includes the vector container for the read block.
+
+using namespace std;     // Allows the use of standard library names without the std prefix.
+
+static const long long kTailBlock = 4096;    // Bytes read from the end first, doubled while no balance is found.
+
+// This function reads a number that fills a piece of text, ignoring spaces around it.
+static bool ReadNumber(const char* begin, const char* end, double& value) {
+    while (begin < end && *begin == ' ') ++begin;   // Skips leading spaces.
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\r')) --end;   // Skips trailing spaces and carriage returns.
+    from_chars_result result = from_chars(begin, end, value);   // Parses the number.
+    return begin < end && result.ec == errc() && result.ptr == end;   // Accepts only a complete number.
+}
+
+// This function checks whether a line starts with the given text.
+static bool StartsWith(const char* begin, const char* end, const char* prefix) {
+    size_t length = strlen(prefix);          // Measures the prefix.
+    return static_cast<size_t>(end - begin) >= length && strncmp(begin, prefix, length) == 0;   // Compares the start of the line.
+}
+
+// This function reads the balance a single log line records, if it records one.
+static bool LineBalance(const char* begin, const char* end, LedgerTail& tail) {
+    const char* closing = "Closing balance: $";   // Ends every finished session.
+    const char* starting = "Starting balance: $"; // Begins every session, the balance when no rows followed.
+    if (StartsWith(begin, end, closing)) {   // Reads an exact closing balance.
+        tail.rounded = false;                // The line holds six decimals.
+        return ReadNumber(begin + strlen(closing), end, tail.balance);   // Parses the amount.
+    }
+    if (StartsWith(begin, end, starting)) {  // Reads the balance a session started from.
+        tail.rounded = false;                // The line holds six decimals.
+        return ReadNumber(begin + strlen(starting), end, tail.balance);  // Parses the amount.
+    }
+    if (StartsWith(begin, end, "Income ") || StartsWith(begin, end, "Expense ")) {   // Reads the last column of a row.
+        while (end > begin && (end[-1] == ' ' || end[-1] == '\r')) --end;   // Skips trailing spaces.
+        const char* last = end;              // Searches backwards for the New balance column.
+        while (last > begin && last[-1] != ' ') --last;   // Stops at the space before it.
+        tail.rounded = true;                 // The column shows six significant digits.
+        return ReadNumber(last, end, tail.balance);   // Parses the amount.
+    }
+    return false;                            // Headers, dividers and blank lines hold no balance.
+}
+
+LedgerTail ReadLedgerTail(const string& path) {
+    LedgerTail tail;                         // Holds what was found.
+    ifstream file(path, ios::binary);        // Opens the log without newline translation.
+    if (!file) return tail;                  // Reports a missing log.
+    tail.exists = true;                      // Notes that the log exists.
+    file.seekg(0, ios::end);                 // Moves to the end of the file.
+    tail.size = static_cast<long long>(file.tellg());   // Measures the file.
+
+    vector<char> block;                      // Holds the bytes read from the end.
+    for (long long length = kTailBlock; ; length *= 2) {   // Reads a larger piece only when a smaller one had no balance.
+        long long start = length < tail.size ? tail.size - length : 0;   // Finds where the piece starts.
+        block.resize(static_cast<size_t>(tail.size - start));   // Makes room for the piece.
+        file.clear();                        // Clears the end of file state before seeking.
+        file.seekg(start);                   // Moves to the start of the piece.
+        if (!file.read(block.data(), static_cast<streamsize>(block.size()))) return tail;   // Stops on a read error.
+
+        const char* data = block.data();     // Points at the piece.
+        const char* end = data + block.size();   // Marks the end of the last line.
+        const char* firstLine = start == 0 ? data : static_cast<const char*>(memchr(data, '\n', block.size()));   // Skips a line cut off at the start of the piece.
+        if (firstLine && start != 0) ++firstLine;    // Moves past the newline.
+        while (firstLine && end > firstLine) {   // Walks the lines from the last to the first.
+            const char* lineBegin = end;     // Searches backwards for the start of the line.
+            while (lineBegin > firstLine && lineBegin[-1] != '\n') --lineBegin;   // Stops after the previous newline.
+            if (LineBalance(lineBegin, end, tail)) {   // Stops at the last line with a balance.
+                tail.found = true;           // Notes the recovered balance.
+                return tail;                 // Returns the balance.
+            }
+            end = lineBegin > data ? lineBegin - 1 : lineBegin;   // Moves to the end of the previous line.
+            if (end == lineBegin) break;     // Stops at the start of the piece.
+        }
+        if (start == 0) return tail;         // The whole file holds no balance.
+    }
+}
@@ -0,0 +1,22 @@
+// This header declares the reader that recovers the last balance from the end of money_log.txt.
+
+#pragma once             // Ensures this header file is only included once during compilation.
+
+#include <string>        // Includes the string library for handling text.
+
+// Every session ends its log with a closing balance line that holds the balance to six decimals.
+// Resuming reads the file backwards from the end, a small block at a time, and stops at the last line
+// that tells the balance, so startup costs the same no matter how long the ledger has grown.
+// A session that never reached its closing line still leaves rows behind; the New balance column of the
+// last row is used then, which shows only six significant digits, so the result is marked as rounded.
+
+struct LedgerTail {
+    bool exists = false;     // True when the file could be opened.
+    long long size = 0;      // Holds the file size in bytes, where the next session starts.
+    bool found = false;      // True when a balance line was found.
+    bool rounded = false;    // True when the balance came from a row rather than a balance line.
+    double balance = 0.0;    // Holds the recovered balance.
+};
+
+// Reads the end of the log and returns the last balance it records.
+LedgerTail ReadLedgerTail(const std::string& path);
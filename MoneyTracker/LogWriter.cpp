@@ -0,0 +1,111 @@
+// This file implements the background log writer declared in LogWriter.h.
+
+#include "LogWriter.h"   // Includes the declaration of the log writer.
+#include <algorithm>     // Includes min for sizing each copy.
+#include <cstring>       // Includes memcpy for copying text into the ring.
+
+using namespace std;     // Allows the use of standard library names without the std prefix.
+
+LogWriter::LogWriter(size_t capacity) {
+    size_t size = 4096;                       // Starts from a small page sized ring.
+    while (size < capacity) size <<= 1;       // Rounds up to a power of two so positions wrap with a mask.
+    ring.reset(new char[size]);               // Allocates the ring storage.
+    mask = size - 1;                          // Remembers the mask for wrapping positions.
+}
+
+LogWriter::~LogWriter() {
+    Close();                                  // Saves anything still queued before the object goes away.
+}
+
+bool LogWriter::Open(const string& path, bool append) {
+    if (writer.joinable()) return false;      // Refuses to open a second file while one is in use.
+    file.open(path, append ? ios::out | ios::app : ios::out | ios::trunc);   // Opens the file, keeping or clearing old text.
+    if (!file) return false;                  // Reports a file that could not be opened.
+    failed = false;                           // Starts the new file without errors.
+    stopping = false;                         // Lets the new writer thread run.
+    writer = thread(&LogWriter::Run, this);   // Starts the background writer thread.
+    return true;                              // Reports success.
+}
+
+void LogWriter::Write(const char* text, size_t length) {
+    if (!writer.joinable()) return;           // Ignores text when no file is open.
+    const size_t size = mask + 1;             // Total bytes the ring can hold.
+    while (length > 0) {                      // Copies the text, in pieces when it wraps or fills the ring.
+        size_t h = head.load(memory_order_relaxed);   // Reads our own position.
+        size_t room = size - (h - tail.load(memory_order_acquire));   // Counts the free bytes.
+        if (room == 0) {                      // Waits only when the disk has fallen a whole ring behind.
+            producerWaiting = true;           // Asks the writer to signal when it frees space.
+            unique_lock<mutex> lock(signalLock);   // Takes the lock the signal needs.
+            wakeProducer.wait(lock, [&] { return Queued() < size; });   // Sleeps until some text has been written out.
+            producerWaiting = false;          // Stops asking for signals.
+            continue;                         // Measures the free space again.
+        }
+        size_t n = min(length, min(room, size - (h & mask)));   // Copies up to the free space or the end of the ring.
+        memcpy(ring.get() + (h & mask), text, n);   // Copies the text into the ring.
+        head.store(h + n);                    // Publishes the new text to the writer thread.
+        text += n;                            // Moves past the copied text.
+        length -= n;                          // Counts what is left to copy.
+        if (writerSleeping) {                 // Wakes the writer only when it is actually asleep.
+            lock_guard<mutex> lock(signalLock);   // Takes the lock so the signal cannot be missed.
+            wakeWriter.notify_one();          // Wakes the writer thread.
+        }
+    }
+}
+
+bool LogWriter::Flush() {
+    if (!writer.joinable()) return Good();    // Nothing is queued when no file is open.
+    size_t target = head.load(memory_order_relaxed);   // Everything queued up to now must be saved.
+    if (saved.load() >= target) return Good(); // Returns at once when the writer is already caught up.
+    producerWaiting = true;                   // Asks the writer to signal when it saves.
+    {
+        unique_lock<mutex> lock(signalLock);  // Takes the lock the signal needs.
+        wakeWriter.notify_one();              // Makes sure the writer is awake to finish the job.
+        wakeProducer.wait(lock, [&] { return saved.load() >= target; });   // Sleeps until the text reaches the operating system.
+    }
+    producerWaiting = false;                  // Stops asking for signals.
+    return Good();                            // Reports whether every write succeeded.
+}
+
+bool LogWriter::Close() {
+    if (!writer.joinable()) return Good();    // Nothing to do when no file is open.
+    {
+        lock_guard<mutex> lock(signalLock);   // Takes the lock so the stop signal cannot be missed.
+        stopping = true;                      // Tells the writer to finish once the ring is empty.
+        wakeWriter.notify_one();              // Wakes the writer if it is asleep.
+    }
+    writer.join();                            // Waits for the writer to save everything and exit.
+    file.close();                             // Closes the log file.
+    if (file.fail()) failed = true;           // Records a failure to close the file.
+    return Good();                            // Reports whether every write succeeded.
+}
+
+void LogWriter::Run() {
+    const size_t size = mask + 1;             // Total bytes the ring can hold.
+    while (true) {                            // Runs until Close asks the thread to stop.
+        size_t t = tail.load(memory_order_relaxed);   // Reads our own position.
+        size_t h = head.load(memory_order_acquire);   // Reads how much text has been queued.
+        if (h == t) {                         // The ring is empty.
+            if (saved.load(memory_order_relaxed) != t) {   // Some written text has not been flushed yet.
+                if (!file.flush()) failed = true;   // Hands the buffered text to the operating system.
+                saved.store(t);               // Publishes the durability point.
+                if (producerWaiting) {        // Signals a Flush call that is waiting.
+                    lock_guard<mutex> lock(signalLock);   // Takes the lock so the signal cannot be missed.
+                    wakeProducer.notify_one();    // Wakes the entry loop.
+                }
+            }
+            writerSleeping = true;            // Tells Write that a signal is needed.
+            unique_lock<mutex> lock(signalLock);   // Takes the lock the signal needs.
+            wakeWriter.wait(lock, [&] { return head.load() != t || stopping; });   // Sleeps until text arrives or Close is called.
+            writerSleeping = false;           // Stops asking for signals.
+            if (stopping && head.load() == t) return;   // Exits once everything is saved.
+            continue;                         // Goes back to writing.
+        }
+        size_t n = min(h - t, size - (t & mask));   // Writes up to the queued text or the end of the ring.
+        if (!failed && !file.write(ring.get() + (t & mask), static_cast<streamsize>(n))) failed = true;   // Writes one large piece, dropping text after an error so the entry loop never hangs.
+        tail.store(t + n);                    // Gives the space back to the entry loop.
+        if (producerWaiting) {                // Signals a Write call waiting for space.
+            lock_guard<mutex> lock(signalLock);   // Takes the lock so the signal cannot be missed.
+            wakeProducer.notify_one();        // Wakes the entry loop.
+        }
+    }
+}
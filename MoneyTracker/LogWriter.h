@@ -0,0 +1,49 @@
+// This header declares a log writer that saves text to a file on a background thread.
+
+#pragma once             // Ensures this header file is only included once during compilation.
+
+#include <atomic>        // Includes atomic positions shared by the two threads.
+#include <condition_variable> // Includes the signal used when one side has to wait.
+#include <cstddef>       // Includes the size_t type.
+#include <fstream>       // Includes the file stream library for the log file.
+#include <memory>        // Includes unique_ptr for the ring storage.
+#include <mutex>         // Includes the mutex paired with the signal.
+#include <string>        // Includes the string library for handling text.
+#include <thread>        // Includes the background writer thread.
+
+// The entry loop copies each row into a ring buffer and returns at once. A single background thread
+// takes the bytes out and writes them to the file in large pieces, so typing or importing never waits on the disk.
+// Only one thread may call Write; the ring needs no lock because each position has a single owner.
+// Flush is the durability point: it returns once everything written so far has reached the operating system.
+// The writer also flushes the file whenever the ring runs empty, so an idle session is always saved.
+class LogWriter {
+public:
+    explicit LogWriter(size_t capacity = 1 << 20);   // Creates a writer with a ring of at least the given bytes.
+    ~LogWriter();                                     // Closes the writer, saving everything still queued.
+
+    bool Open(const std::string& path, bool append = false);   // Opens the file and starts the writer thread.
+    void Write(const char* text, size_t length);      // Queues text, waiting only when the ring is full.
+    void Write(const std::string& text) { Write(text.data(), text.size()); }   // Queues a whole string.
+    bool Flush();                                     // Waits until all queued text is in the file, false after a write error.
+    bool Close();                                     // Flushes, stops the thread and closes the file.
+    bool Good() const { return !failed.load(); }      // Reports whether every write so far has succeeded.
+
+private:
+    void Run();                                       // The loop run by the writer thread.
+    size_t Queued() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }   // Bytes waiting in the ring.
+
+    std::unique_ptr<char[]> ring;                     // Holds the queued text.
+    size_t mask = 0;                                  // Ring size minus one, the size is a power of two.
+    std::atomic<size_t> head{ 0 };                    // Total bytes queued, only the entry loop moves it.
+    std::atomic<size_t> tail{ 0 };                    // Total bytes taken out, only the writer thread moves it.
+    std::atomic<size_t> saved{ 0 };                   // Total bytes handed to the operating system.
+    std::atomic<bool> writerSleeping{ false };        // True while the writer waits for text.
+    std::atomic<bool> producerWaiting{ false };       // True while Write or Flush waits on the writer.
+    std::atomic<bool> stopping{ false };              // Tells the writer thread to finish.
+    std::atomic<bool> failed{ false };                // Set when the file refuses a write.
+    std::mutex signalLock;                            // Guards the sleeps below, never the ring itself.
+    std::condition_variable wakeWriter;               // Wakes the writer when text arrives.
+    std::condition_variable wakeProducer;             // Wakes the entry loop when space frees up or text is saved.
+    std::ofstream file;                               // The log file, used only by the writer thread while it runs.
+    std::thread writer;                               // The background writer thread.
+};
@@ -5,35 +5,147 @@
 #include <string>        // Includes the string library for handling text.
 #include <iomanip>       // Includes the iomanip library for formatting numerical output.
 #include <sstream>       // Includes the string stream library for formatting text into strings.
+#include <limits>        // Includes numeric_limits for clearing leftover input.
+#include <cstdlib>       // Includes atof for reading the starting balance option.
+#include <chrono>        // Includes the clock used to time a bulk import.
+#include "LogWriter.h"   // Includes the background writer that saves rows without waiting on the disk.
+#include "BulkImport.h"  // Includes the bulk import of CSV and TSV rows.
+#include "LedgerTail.h"  // Includes the reader that recovers the last balance from the log.
 
 using namespace std;     // Allows the use of standard library names without the std prefix.
 
 // This function writes the same text to the screen and to the file.
-void WriteToScreenAndFile(const string& text, ofstream& fileOut) {
+// The file copy is queued for the background writer, so neither output waits on the disk.
+void WriteToScreenAndFile(const string& text, LogWriter& fileOut) {
     cout << text;        // Writes the text to the screen.
-    fileOut << text;     // Writes the same text to the file.
+    fileOut.Write(text); // Queues the same text for the file.
 }
 
-int main() {             // The main function begins the program.
+// This function builds the column headers and divider shown above the rows.
+string ColumnHeaders() {
+    ostringstream columnStream;                 // Creates a stream to format the column headers.
+    columnStream << left << setw(12) << "Type"  // Formats the column headers.
+        << left << setw(20) << "Description"
+        << right << setw(12) << "Amount"
+        << right << setw(14) << "New balance" << '\n';
+    columnStream << string(58, '=') << '\n';    // Adds a divider line.
+    return columnStream.str();                  // Returns the finished headers.
+}
+
+// This function builds the line that ends every session, so a later run can resume from it.
+string ClosingLine(double balance) {
+    return "\nClosing balance: $" + to_string(balance) + "\n";   // Formats the balance like the starting line.
+}
+
+// This function finds the balance a resumed session starts from and tells the user where it came from.
+// It returns false when the log has no balance to resume from.
+bool ResumeBalance(const LedgerTail& tail, double& balance) {
+    if (!tail.found) {                          // Checks whether the log recorded a balance.
+        cout << "No saved balance found in money_log.txt.\n";   // Explains why the balance is not resumed.
+        return false;                           // Leaves the balance to the caller.
+    }
+    balance = tail.balance;                     // Continues from the saved balance.
+    cout << fixed << setprecision(2);           // Formats money values on the screen to two decimals.
+    cout << "Resuming with balance: $" << balance;   // Shows the recovered balance.
+    if (tail.rounded) cout << " (read from the last row, the previous session did not finish)";   // Warns that the row column is rounded.
+    cout << '\n';                               // Ends the line.
+    return true;                                // Reports success.
+}
+
+// This function appends a whole file of rows to the log without asking any questions.
+// Only the session header and a summary appear on the screen; the rows go straight to the file.
+int RunImport(const string& path, double balance, bool resume) {
+    ifstream inputFile;                         // Declares the input file, unused when reading standard input.
+    if (path != "-") {                          // Opens a named file.
+        inputFile.open(path, ios::binary);      // Opens the file without newline translation.
+        if (!inputFile) {                       // Checks if the file failed to open.
+            cout << "Error opening " << path << " for reading.\n";   // Displays an error message.
+            return 1;                           // Ends the program with an error code.
+        }
+    }
+    else {                                      // Reads standard input.
+        ios::sync_with_stdio(false);            // Lets cin read in large blocks.
+    }
+    istream& input = path == "-" ? cin : inputFile;   // Picks the input stream.
+
+    if (resume) ResumeBalance(ReadLedgerTail("money_log.txt"), balance);   // Starts from the end of the log when asked.
+
+    LogWriter moneyFile;                        // Creates the writer that saves the log in the background.
+    if (!moneyFile.Open("money_log.txt", true)) {   // Opens money_log.txt for appending and checks for failure.
+        cout << "Error opening money_log.txt for writing.\n";   // Displays an error message.
+        return 1;                               // Ends the program with an error code.
+    }
+
+    string name = path == "-" ? string("standard input") : path;   // Names the source in the log.
+    string header = "\nImport session for " + name + "\n";   // Builds a session header.
+    WriteToScreenAndFile(header, moneyFile);    // Writes the header to both outputs.
+    string startLine = "Starting balance: $" + to_string(balance) + "\n\n";   // Formats balance line.
+    WriteToScreenAndFile(startLine, moneyFile); // Outputs the line.
+    moneyFile.Write(ColumnHeaders());           // Writes the column headers to the file only.
+
+    auto start = chrono::steady_clock::now();   // Starts timing the import.
+    ImportResult result = ImportRows(input, moneyFile, balance, cout);   // Reads, formats and queues every row.
+    moneyFile.Write(ClosingLine(result.balance));   // Ends the session with its balance.
+    bool saved = moneyFile.Close();             // Saves every queued row and closes the file.
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();   // Measures the whole import.
+
+    if (!saved) {                               // Checks for write errors.
+        cout << "Error writing money_log.txt.\n";   // Displays an error message.
+        return 1;                               // Ends the program with an error code.
+    }
+
+    cout << fixed << setprecision(2);           // Formats money values on the screen to two decimals.
+    cout << "Imported " << result.rows << " rows, skipped " << result.skipped << " lines.\n";   // Reports the counts.
+    cout << "Final balance: $" << result.balance << '\n';   // Reports the balance after the last row.
+    cout << "Time: " << seconds << " seconds";  // Reports how long the import took.
+    if (seconds > 0) cout << ", " << setprecision(0) << result.rows / seconds << " rows per second";   // Reports the rate.
+    cout << '\n';                               // Ends the line.
+    return 0;                                   // Ends the program successfully.
+}
 
-    ofstream moneyFile("money_log.txt");   // Opens a file named money_log.txt for writing.
+int main(int argc, char* argv[]) {   // The main function begins the program.
+
+    string importPath;                     // Holds the file to import, empty for the interactive menu.
+    double importBalance = 0.0;            // Holds the starting balance for an import.
+    bool resume = false;                   // Continues the existing log instead of starting a new one.
+    for (int i = 1; i < argc; ++i) {       // Reads the command line options.
+        string option = argv[i];           // Takes the next option.
+        if (option == "--import" && i + 1 < argc) importPath = argv[++i];   // Imports a CSV or TSV file, or - for standard input.
+        else if (option == "--balance" && i + 1 < argc) importBalance = atof(argv[++i]);   // Sets the balance the import starts from.
+        else if (option == "--resume") resume = true;   // Appends to money_log.txt and starts from its last balance.
+        else {                             // Handles an unknown option.
+            cout << "Usage: MoneyTracker [--resume] [--import file.csv|file.tsv|- [--balance amount]]\n";   // Explains the options.
+            return 1;                      // Ends the program with an error code.
+        }
+    }
+
+    if (!importPath.empty()) {             // Runs a bulk import instead of the menu.
+        return RunImport(importPath, importBalance, resume);   // Imports the rows and ends the program.
+    }
 
-    if (!moneyFile) {                      // Checks if the file failed to open.
-        cout << "Error opening money_log.txt for writing." << endl;   // Displays an error message.
+    LedgerTail tail;                       // Describes the end of an existing log.
+    if (resume) tail = ReadLedgerTail("money_log.txt");   // Reads only the last lines of the log, however long it is.
+    long long sessionStart = resume ? tail.size : 0;      // Marks where this session's text begins in the file.
+
+    LogWriter moneyFile;                   // Creates the writer that saves the log in the background.
+
+    if (!moneyFile.Open("money_log.txt", resume)) {   // Opens money_log.txt, keeping its text when resuming, and checks for failure.
+        cout << "Error opening money_log.txt for writing.\n";   // Displays an error message.
         return 1;                          // Ends the program with an error code.
     }
 
     cout << fixed << setprecision(2);      // Formats money values on the screen to two decimals.
-    moneyFile << fixed << setprecision(2); // Formats money values in the file similarly.
 
-    cout << "Money Tracker" << endl;       // Displays the program title.
-    cout << "Track your income and expenses." << endl;                // Brief program description.
-    cout << "Everything is saved to money_log.txt as you enter it." << endl; // File explanation.
-    cout << "At the end, your file will be read back to you." << endl;        // Final output note.
-    cout << endl;                          // Prints a blank line for readability.
+    cout << "Money Tracker" << '\n';       // Displays the program title.
+    cout << "Track your income and expenses." << '\n';                // Brief program description.
+    cout << "Everything is saved to money_log.txt as you enter it." << '\n'; // File explanation.
+    cout << "At the end, your file will be read back to you." << '\n';        // Final output note.
+    cout << '\n';                          // Prints a blank line for readability.
 
-    moneyFile << "Money Tracker" << endl;  // Writes the title to the file.
-    moneyFile << "Session log" << endl << endl;  // Writes a header into the file.
+    if (sessionStart == 0) {               // Writes the title only at the top of a new file.
+        moneyFile.Write("Money Tracker\n");    // Writes the title to the file.
+        moneyFile.Write("Session log\n\n");   // Writes a header into the file.
+    }
 
     cout << "Enter your name: ";           // Prompts the user to enter their name.
     string userName;                       // Declares a string variable for the user's name.
@@ -43,11 +155,14 @@ int main() {             // The main function begins the program.
         userName = "Guest";                // Assigns a default name.
     }
 
-    cout << "Enter your starting balance: ";  // Prompts for the starting balance.
     double balance = 0.0;                  // Initializes the balance variable.
-    cin >> balance;                        // Reads the user's starting balance.
 
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');   // Clears leftover input characters.
+    if (!resume || !ResumeBalance(tail, balance)) {   // Asks for a balance unless the log provides one.
+        cout << "Enter your starting balance: ";  // Prompts for the starting balance.
+        cin >> balance;                    // Reads the user's starting balance.
+
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');   // Clears leftover input characters.
+    }
 
     string header = "\nMoney session for " + userName + "\n";   // Builds a session header.
     WriteToScreenAndFile(header, moneyFile);                    // Writes the header to both outputs.
@@ -55,28 +170,18 @@ int main() {             // The main function begins the program.
     string startLine = "Starting balance: $" + to_string(balance) + "\n\n";  // Formats balance line.
     WriteToScreenAndFile(startLine, moneyFile);                              // Outputs the line.
 
-    cout << left << setw(12) << "Type"          // Displays column headers on the screen.
-        << left << setw(20) << "Description"
-        << right << setw(12) << "Amount"
-        << right << setw(14) << "New balance" << endl;
-    cout << string(58, '=') << endl;            // Prints a divider line.
-
-    moneyFile << left << setw(12) << "Type"     // Writes the same column headers to the file.
-        << left << setw(20) << "Description"
-        << right << setw(12) << "Amount"
-        << right << setw(14) << "New balance" << endl;
-    moneyFile << string(58, '=') << endl;       // Writes the divider to the file.
+    WriteToScreenAndFile(ColumnHeaders(), moneyFile);   // Writes the headers to both outputs.
 
     bool running = true;                        // Controls the program loop.
 
     while (running) {                           // Begins a loop that continues until the user exits.
 
-        cout << endl;                           // Prints a blank line before the menu.
-        cout << "Menu:" << endl;                // Displays the menu title.
-        cout << "1. Add income" << endl;        // Menu option for adding income.
-        cout << "2. Add expense" << endl;       // Menu option for adding an expense.
-        cout << "3. Finish and show file contents" << endl;   // Menu option to end the session.
-        cout << endl;                           // Adds a blank line before input.
+        cout << '\n';                           // Prints a blank line before the menu.
+        cout << "Menu:" << '\n';                // Displays the menu title.
+        cout << "1. Add income" << '\n';        // Menu option for adding income.
+        cout << "2. Add expense" << '\n';       // Menu option for adding an expense.
+        cout << "3. Finish and show file contents" << '\n';   // Menu option to end the session.
+        cout << '\n';                           // Adds a blank line before input.
 
         cout << "Enter your choice (1 to 3): "; // Prompts the user to select a menu option.
         int choice;                             // Declares a variable to store the choice.
@@ -104,7 +209,7 @@ int main() {             // The main function begins the program.
             rowStream << left << setw(12) << "Income"    // Formats the income row.
                 << left << setw(20) << description
                 << right << setw(12) << amount
-                << right << setw(14) << balance << endl;
+                << right << setw(14) << balance << '\n';
 
             WriteToScreenAndFile(rowStream.str(), moneyFile);   // Writes the row to both outputs.
         }
@@ -128,42 +233,49 @@ int main() {             // The main function begins the program.
             rowStream << left << setw(12) << "Expense"  // Formats the expense row.
                 << left << setw(20) << description
                 << right << setw(12) << amount
-                << right << setw(14) << balance << endl;
+                << right << setw(14) << balance << '\n';
 
             WriteToScreenAndFile(rowStream.str(), moneyFile);   // Outputs the row.
         }
         else if (choice == 3) {               // Checks if the user chose to exit.
 
-            cout << endl;                     // Prints a blank line for spacing.
-            cout << "Reading saved file..." << endl << endl;  // Informs the user.
+            cout << '\n';                     // Prints a blank line for spacing.
+            cout << "Reading saved file..." << "\n\n";  // Informs the user.
             running = false;                  // Ends the loop.
         }
         else {                                // Handles invalid menu choices.
 
-            cout << "Invalid choice. Try again." << endl;   // Displays an error message.
+            cout << "Invalid choice. Try again." << '\n';   // Displays an error message.
         }
     }
 
-    moneyFile.close();                        // Closes the output file.
+    moneyFile.Write(ClosingLine(balance));    // Ends the session with its balance.
+
+    if (!moneyFile.Close()) {                 // Saves every queued row, closes the file and checks for write errors.
+        cout << "Error writing money_log.txt.\n";   // Displays an error message.
+        return 1;                             // Ends the program with an error code.
+    }
 
     ifstream moneyRead("money_log.txt");      // Opens the file for reading.
 
     if (!moneyRead) {                         // Checks if the file failed to open.
-        cout << "Error opening money_log.txt for reading." << endl;  // Displays an error.
+        cout << "Error opening money_log.txt for reading." << '\n';  // Displays an error.
         return 1;                             // Returns an error code.
     }
 
-    cout << "========== Saved Money Log ==========" << endl << endl;   // Displays header.
+    moneyRead.seekg(sessionStart);            // Skips earlier sessions, so a long ledger is not read back in full.
+
+    cout << "========== Saved Money Log ==========" << "\n\n";   // Displays header.
 
     string line;                              // Declares a variable to hold each file line.
     while (getline(moneyRead, line)) {        // Reads the file line by line.
-        cout << line << endl;                 // Prints each line to the screen.
+        cout << line << '\n';                 // Prints each line to the screen.
     }
 
     moneyRead.close();                        // Closes the input file.
 
-    cout << endl;                             // Prints a blank line for spacing.
-    cout << "Thank you, " << userName << "." << endl;  // Displays a farewell message.
+    cout << '\n';                             // Prints a blank line for spacing.
+    cout << "Thank you, " << userName << "." << '\n';  // Displays a farewell message.
 
     return 0;                                 // Ends the program successfully.
 }
\ No newline at end of file